@@ -2,6 +2,7 @@ package app
 
 import (
 	"context"
+	"time"
 
 	"go.uber.org/zap"
 
@@ -11,6 +12,8 @@ import (
 	infra "github.com/y3owk1n/neru/internal/core/infra/accessibility"
 )
 
+const bytesPerMegabyte = 1024 * 1024
+
 // SetConfigField applies a single runtime config field change with full
 // app-level reconfiguration (component updates, hotkey re-registration, etc.).
 // This mirrors the reload path but operates on the in-memory config rather
@@ -178,11 +181,13 @@ func (a *App) updateConfigSnapshot(loadResult *config.LoadResult) {
 
 func (a *App) reconfigureRuntimeFromConfig(cfg *config.Config) {
 	a.configureEventTapHotkeys(cfg, a.logger)
+	a.invalidateOverlayLabelCache()
 	a.updateComponentConfigs(cfg)
 	a.updateServiceConfigs(cfg)
 	a.updateControllerConfigs(cfg)
 	a.syncScreenShareConfig(cfg)
 	a.syncScrollInvertConfig(cfg)
+	a.syncOverlayStandbyConfig(cfg)
 }
 
 func (a *App) updateComponentConfigs(cfg *config.Config) {
@@ -266,6 +271,19 @@ func (a *App) syncScrollInvertConfig(cfg *config.Config) {
 	}
 }
 
+func (a *App) syncOverlayStandbyConfig(cfg *config.Config) {
+	configurer, ok := a.overlayManager.(OverlayStandbyConfigurer)
+	if !ok {
+		return
+	}
+
+	configurer.ConfigureOverlayStandby(
+		cfg.General.OverlayStandby,
+		time.Duration(cfg.General.OverlayStandbyIdleTimeoutMS)*time.Millisecond,
+		uint64(cfg.General.OverlayStandbyMaxMB)*bytesPerMegabyte,
+	)
+}
+
 // syncInitialConfigToAppState syncs configuration values to AppState during startup.
 // This ensures AppState reflects the config file values before any runtime toggles.
 func syncInitialConfigToAppState(app *App) {
@@ -278,4 +296,6 @@ func syncInitialConfigToAppState(app *App) {
 	if app.appState.IsScrollInverted() != cfg.Scroll.InvertScroll {
 		app.appState.SetScrollInverted(cfg.Scroll.InvertScroll)
 	}
+
+	app.syncOverlayStandbyConfig(cfg)
 }
@@ -2,6 +2,7 @@ package app
 
 import (
 	"context"
+	"time"
 
 	"github.com/y3owk1n/neru/internal/core/infra/appwatcher"
 	"github.com/y3owk1n/neru/internal/core/infra/hotkeys"
@@ -28,6 +29,18 @@ type HotkeyReleaseService interface {
 	) (hotkeys.HotkeyID, error)
 }
 
+// LabelCacheInvalidator is implemented by overlay managers that cache
+// rasterized labels and must drop them when fonts or theme colors change.
+type LabelCacheInvalidator interface {
+	InvalidateLabelCache()
+}
+
+// OverlayStandbyConfigurer is implemented by overlay managers that can keep
+// their native surfaces warm between activations.
+type OverlayStandbyConfigurer interface {
+	ConfigureOverlayStandby(enabled bool, idleTimeout time.Duration, maxBytes uint64)
+}
+
 // OverlayManager defines the interface for overlay window management.
 type OverlayManager = overlay.ManagerInterface
 
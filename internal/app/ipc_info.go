@@ -3,6 +3,7 @@ package app
 import (
 	"context"
 	"fmt"
+	"maps"
 	"os"
 	"path/filepath"
 	"strings"
@@ -166,6 +167,18 @@ func (h *IPCControllerInfo) handleStatus(_ context.Context, _ ipc.Command) ipc.R
 		"profile":                profileMap(platform.CurrentProfile()),
 	}
 
+	queues := make(map[string]ports.EventQueueStats)
+
+	for _, source := range []any{h.eventTap, h.systemPort} {
+		if provider, ok := source.(ports.EventQueueStatsProvider); ok {
+			maps.Copy(queues, provider.EventQueueStats())
+		}
+	}
+
+	if len(queues) > 0 {
+		status["event_queues"] = queues
+	}
+
 	return ipc.Response{
 		Success: true,
 		Message: "status retrieved successfully",
@@ -34,6 +34,10 @@ func (a *App) handleThemeChange(isDark bool) {
 	a.configMu.RUnlock()
 	a.logger.Info("System theme changed",
 		zap.Bool("is_dark", isDark))
+
+	// Cached label rasters carry the old theme's colors.
+	a.invalidateOverlayLabelCache()
+
 	// Invalidate the overlay's native C string caches so the subsequent draw
 	// rebuilds them with the new theme-resolved colors.
 	if a.hintsComponent != nil && a.hintsComponent.Overlay != nil {
@@ -76,3 +80,11 @@ func (a *App) handleThemeChange(isDark bool) {
 		}
 	}
 }
+
+// invalidateOverlayLabelCache drops pre-rasterized overlay labels on backends
+// that cache them, so the next draw re-renders with the current fonts.
+func (a *App) invalidateOverlayLabelCache() {
+	if invalidator, ok := a.overlayManager.(LabelCacheInvalidator); ok {
+		invalidator.InvalidateLabelCache()
+	}
+}
@@ -124,6 +124,7 @@ func (f *OutputFormatter) PrintStatus(cmd *cobra.Command, data any) error {
 		}
 
 		printProfile(cmd, statusData["profile"])
+		printEventQueues(cmd, statusData["event_queues"])
 	} else {
 		// Fallback to JSON output
 		jsonData, jsonDataErr := json.MarshalIndent(data, "  ", "  ")
@@ -323,6 +324,62 @@ func printProfile(cmd *cobra.Command, rawProfile any) {
 	}
 }
 
+// printEventQueues prints the per-stage input queue counters, in stage order.
+func printEventQueues(cmd *cobra.Command, rawQueues any) {
+	queues, ok := rawQueues.(map[string]any)
+	if !ok || len(queues) == 0 {
+		return
+	}
+
+	cmd.Println("  Event queues:")
+
+	for _, stage := range sortedKeys(queues) {
+		queue, ok := queues[stage].(map[string]any)
+		if !ok {
+			continue
+		}
+
+		cmd.Printf(
+			"    %-10s produced=%v consumed=%v dropped=%v high_water=%v/%v",
+			stage,
+			queue["produced"],
+			queue["consumed"],
+			queue["dropped"],
+			queue["highWater"],
+			queue["capacity"],
+		)
+
+		if batches, ok := queue["batches"]; ok {
+			cmd.Printf(
+				" batches=%v coalesced=%v frames=%v",
+				batches,
+				counterValue(queue["coalesced"]),
+				counterValue(queue["frames"]),
+			)
+		}
+
+		if latencyMax, ok := queue["latencyMaxUs"]; ok {
+			cmd.Printf(
+				" latency_avg=%vus latency_max=%vus",
+				counterValue(queue["latencyAvgUs"]),
+				latencyMax,
+			)
+		}
+
+		cmd.Println()
+	}
+}
+
+// counterValue returns v, or 0 for a counter omitted from the JSON because it
+// was zero.
+func counterValue(v any) any {
+	if v == nil {
+		return 0
+	}
+
+	return v
+}
+
 func profileBackendLine(name string, profile map[string]any) string {
 	backend := stringValue(profile[name+"_backend"])
 
@@ -95,3 +95,59 @@ func TestPrintProfile(t *testing.T) {
 		}
 	}
 }
+
+func TestPrintEventQueues(t *testing.T) {
+	t.Parallel()
+
+	var output bytes.Buffer
+
+	cmd := &cobra.Command{}
+	cmd.SetOut(&output)
+
+	printEventQueues(cmd, map[string]any{
+		"evdev": map[string]any{
+			"capacity":  float64(1024),
+			"produced":  float64(12),
+			"consumed":  float64(12),
+			"dropped":   float64(0),
+			"highWater": float64(3),
+		},
+		"inject": map[string]any{
+			"capacity":  float64(512),
+			"produced":  float64(40),
+			"consumed":  float64(40),
+			"dropped":   float64(0),
+			"highWater": float64(9),
+			"batches":   float64(5),
+			"frames":    float64(22),
+		},
+		"libei": map[string]any{
+			"capacity":     float64(512),
+			"produced":     float64(8),
+			"consumed":     float64(8),
+			"dropped":      float64(0),
+			"highWater":    float64(2),
+			"batches":      float64(4),
+			"coalesced":    float64(1),
+			"frames":       float64(6),
+			"latencyAvgUs": float64(85),
+			"latencyMaxUs": float64(240),
+		},
+	})
+
+	got := output.String()
+
+	expectedLines := []string{
+		"    evdev      produced=12 consumed=12 dropped=0 high_water=3/1024\n",
+		"    inject     produced=40 consumed=40 dropped=0 high_water=9/512" +
+			" batches=5 coalesced=0 frames=22\n",
+		"    libei      produced=8 consumed=8 dropped=0 high_water=2/512" +
+			" batches=4 coalesced=1 frames=6 latency_avg=85us latency_max=240us\n",
+	}
+
+	for _, expectedLine := range expectedLines {
+		if !strings.Contains(got, expectedLine) {
+			t.Fatalf("printEventQueues output missing %q in:\n%s", expectedLine, got)
+		}
+	}
+}
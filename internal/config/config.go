@@ -489,6 +489,9 @@ type GeneralConfig struct {
 	KBLayoutToUse                     string   `json:"kbLayoutToUse"                     toml:"kb_layout_to_use"`
 	ExecShell                         string   `json:"execShell"                         toml:"exec_shell"`
 	ExecShellArgs                     []string `json:"execShellArgs"                     toml:"exec_shell_args"`
+	OverlayStandby                    bool     `json:"overlayStandby"                    toml:"overlay_standby"`
+	OverlayStandbyIdleTimeoutMS       int      `json:"overlayStandbyIdleTimeoutMs"       toml:"overlay_standby_idle_timeout_ms"`
+	OverlayStandbyMaxMB               int      `json:"overlayStandbyMaxMb"               toml:"overlay_standby_max_mb"`
 }
 
 // ModeIndicatorUI defines the visual/appearance settings for the mode indicator.
@@ -1188,6 +1191,20 @@ func (c *Config) ValidateGeneral() error {
 		)
 	}
 
+	if c.General.OverlayStandbyIdleTimeoutMS < 0 {
+		return derrors.New(
+			derrors.CodeInvalidConfig,
+			"general.overlay_standby_idle_timeout_ms must be non-negative",
+		)
+	}
+
+	if c.General.OverlayStandbyMaxMB < 0 {
+		return derrors.New(
+			derrors.CodeInvalidConfig,
+			"general.overlay_standby_max_mb must be non-negative",
+		)
+	}
+
 	return nil
 }
 
@@ -106,6 +106,12 @@ const (
 	// commands from the following string argument (e.g. "-c" or "-lc").
 	DefaultExecShellFlag = "-lc"
 
+	// DefaultOverlayStandbyIdleTimeoutMS is how long a hidden overlay keeps its
+	// surfaces and buffers warm before releasing them (Linux Wayland).
+	DefaultOverlayStandbyIdleTimeoutMS = 30000
+	// DefaultOverlayStandbyMaxMB caps the buffer memory kept warm while hidden.
+	DefaultOverlayStandbyMaxMB = 256
+
 	// DefaultSmoothCursorSteps is the default smooth cursor steps.
 	DefaultSmoothCursorSteps = 10
 
@@ -340,6 +346,9 @@ func newDefaultConfig() *Config {
 			KBLayoutToUse:                     "",
 			ExecShell:                         DefaultExecShell,
 			ExecShellArgs:                     []string{DefaultExecShellFlag},
+			OverlayStandby:                    true,
+			OverlayStandbyIdleTimeoutMS:       DefaultOverlayStandbyIdleTimeoutMS,
+			OverlayStandbyMaxMB:               DefaultOverlayStandbyMaxMB,
 		},
 		Theme: defaultThemeConfig(),
 		Hotkeys: HotkeysConfig{
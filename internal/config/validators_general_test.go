@@ -140,6 +140,53 @@ func TestConfig_ValidateGeneral(t *testing.T) {
 			}(),
 			wantErr: true,
 		},
+		{
+			name: "overlay standby limits - valid",
+			config: func() config.Config {
+				shell, args := validExecShell()
+
+				return config.Config{
+					General: config.GeneralConfig{
+						ExecShell:                   shell,
+						ExecShellArgs:               args,
+						OverlayStandby:              true,
+						OverlayStandbyIdleTimeoutMS: 0,
+						OverlayStandbyMaxMB:         0,
+					},
+				}
+			}(),
+			wantErr: false,
+		},
+		{
+			name: "overlay_standby_idle_timeout_ms negative - invalid",
+			config: func() config.Config {
+				shell, args := validExecShell()
+
+				return config.Config{
+					General: config.GeneralConfig{
+						ExecShell:                   shell,
+						ExecShellArgs:               args,
+						OverlayStandbyIdleTimeoutMS: -1,
+					},
+				}
+			}(),
+			wantErr: true,
+		},
+		{
+			name: "overlay_standby_max_mb negative - invalid",
+			config: func() config.Config {
+				shell, args := validExecShell()
+
+				return config.Config{
+					General: config.GeneralConfig{
+						ExecShell:           shell,
+						ExecShellArgs:       args,
+						OverlayStandbyMaxMB: -1,
+					},
+				}
+			}(),
+			wantErr: true,
+		},
 	}
 
 	for _, testCase := range tests {
@@ -13,6 +13,7 @@ import (
 	"github.com/y3owk1n/neru/internal/core/domain/action"
 	"github.com/y3owk1n/neru/internal/core/infra/eventtap"
 	"github.com/y3owk1n/neru/internal/core/infra/platform"
+	"github.com/y3owk1n/neru/internal/core/infra/platform/linux"
 )
 
 // Element represents a UI element for Linux (e.g., AT-SPI).
@@ -28,6 +29,15 @@ var (
 	linuxMouseDownMu  sync.RWMutex
 )
 
+// waylandScrollPxPerNotch is how many of the scroll service's pixels one wheel
+// notch stands for on Wayland, where scroll amounts are sent in value120 units
+// (120 per notch).
+const waylandScrollPxPerNotch = 30
+
+func scrollValue120(delta int) int {
+	return delta * 120 / waylandScrollPxPerNotch
+}
+
 func abs(v int) int {
 	if v < 0 {
 		return -v
@@ -432,70 +442,23 @@ func ScrollAtCursor(deltaX, deltaY int) error {
 	}
 
 	if currentLinuxBackend() == linuxBackendWayland {
-		// Scale factor: each uinput scroll event approximates ~1 line.
-		const scrollScale = 30
-
-		// maxBatchEvents caps the number of uinput events sent per
-		// write/flush to avoid overflowing the kernel evdev buffer (~8192
-		// bytes) or the Wayland socket buffer.  Each batch is kept small so
-		// the compositor and client can process events incrementally.
-		const maxBatchEvents = 50
-
-		sendScaledScroll := func(axis int, delta int) int {
-			if delta == 0 {
-				return 0
-			}
-
-			totalNotches := abs(delta) / scrollScale
-			if totalNotches == 0 {
-				totalNotches = 1
-			}
-
-			remainingNotches := totalNotches
-			batch := make([]int, 0, maxBatchEvents)
-
-			value := 1
-			if delta < 0 {
-				value = -1
-			}
-
-			for remainingNotches > 0 {
-				batch = append(batch, value)
-				remainingNotches--
-
-				if len(batch) >= maxBatchEvents || remainingNotches == 0 {
-					err := eventtap.ScrollDeviceScrollBatch(axis, batch)
-					if err != nil {
-						// uinput unavailable — add back unsent notches so the
-						// remaining delta is retried via wlroots virtual pointer
-						// fallback without double-counting already-sent notches.
-						remainingNotches += len(batch)
-
-						break
-					}
-
-					batch = batch[:0]
-				}
-			}
-
-			notchesSent := totalNotches - remainingNotches
-
-			pixelsSent := notchesSent * scrollScale
-			if delta > 0 {
-				return max(delta-pixelsSent, 0)
-			}
-
-			return min(delta+pixelsSent, 0)
-		}
-
-		remainY := sendScaledScroll(0, deltaY)
-		remainX := sendScaledScroll(1, deltaX)
-
-		if remainY == 0 && remainX == 0 {
+		// Both Wayland paths take value120 amounts and pace them over output
+		// frames in C, so fractions of a notch are kept and a long scroll is
+		// one call instead of a loop of notch batches.
+		durationMs := linux.SmoothScrollDurationMs(deltaX, deltaY)
+
+		err := eventtap.ScrollDeviceScrollBy(
+			scrollValue120(deltaX),
+			scrollValue120(deltaY),
+			durationMs,
+			linux.WaylandRefreshMhz(),
+		)
+		if err == nil {
 			return nil
 		}
 
-		return wlrootsScrollAtCursor(remainX, remainY)
+		// uinput unavailable — scroll through the compositor's virtual pointer.
+		return wlrootsScrollAtCursor(deltaX, deltaY)
 	}
 
 	return nil
@@ -248,16 +248,9 @@ func wlrootsMouseDownModifiers() (action.Modifiers, bool) {
 	return globalWlrootsPointerState.mouseDownModifiers, globalWlrootsPointerState.mouseDown
 }
 
-// wlrootsScrollScale mirrors the uinput scroll scaling constant so
-// that both backends produce comparable scroll behavior from the same
-// pixel-level delta values supplied by the scroll service
-// (e.g. ScrollStep=50, ScrollStepHalf=500, ScrollStepFull=1000000).
-const (
-	wlrootsScrollScale     = 30
-	wlrootsScrollMaxEvents = 50
-	wlrootsScrollStep      = 30 // pixels per notch (matches uinput scrollScale)
-)
-
+// wlrootsScrollAtCursor scrolls through the compositor's virtual pointer or
+// libei. Wayland axes are positive down/right while the scroll service's
+// deltaY is positive up, so the vertical sign is flipped.
 func wlrootsScrollAtCursor(deltaX, deltaY int) error {
 	if os.Getenv("WAYLAND_DISPLAY") == "" {
 		return derrors.New(
@@ -266,70 +259,9 @@ func wlrootsScrollAtCursor(deltaX, deltaY int) error {
 		)
 	}
 
-	if deltaY != 0 {
-		err := wlrootsScrollAxis(0, deltaY)
-		if err != nil {
-			return err
-		}
-	}
-
-	if deltaX != 0 {
-		err := wlrootsScrollAxis(1, deltaX)
-		if err != nil {
-			return err
-		}
-	}
-
-	return nil
-}
-
-// wlrootsScrollAxis sends Wayland axis events for one axis.
-// Each event carries 1 notch (axis_discrete=±1, axis_value120=±120) to
-// match what a physical mouse wheel produces — no toolkit clipping.
-// Events are sent in batches of wlrootsScrollMaxEvents to avoid flooding
-// the compositor socket.
-//
-// Wayland axis convention: positive = scroll down (axis 0) / right (axis 1).
-// Application  convention: positive delta = scroll up (axis 0) / right (axis 1).
-// Vertical axis sign is negated to convert between the two.
-func wlrootsScrollAxis(axis int, delta int) error {
-	totalNotches := abs(delta) / wlrootsScrollScale
-	if totalNotches == 0 {
-		totalNotches = 1
-	}
-
-	negate := axis == 0
-
-	step := wlrootsScrollStep
-	if negate {
-		step = -step
-	}
-
-	disc := 1
-	if delta < 0 {
-		step = -step
-		disc = -disc
-	}
-
-	deltas := make([]int, 0, wlrootsScrollMaxEvents)
-	discretes := make([]int, 0, wlrootsScrollMaxEvents)
-	remaining := totalNotches
-
-	for remaining > 0 {
-		deltas = append(deltas, step)
-		discretes = append(discretes, disc)
-		remaining--
-
-		if len(deltas) >= wlrootsScrollMaxEvents || remaining == 0 {
-			err := linux.WlrootsScrollBatch(axis, deltas, discretes)
-			if err != nil {
-				return err
-			}
-
-			deltas = deltas[:0]
-			discretes = discretes[:0]
-		}
-	}
-
-	return nil
+	return linux.WaylandScrollBy(
+		scrollValue120(deltaX),
+		-scrollValue120(deltaY),
+		linux.SmoothScrollDurationMs(deltaX, deltaY),
+	)
 }
@@ -78,13 +78,12 @@ func linuxApplicationBundleIdentifier(pid int) string {
 }
 
 func x11MoveMouseToPoint(point image.Point) error {
-	display, err := x11ActionDisplay()
+	err := x11ActionAvailable()
 	if err != nil {
 		return err
 	}
-	defer C.neru_ax_close_display(display) //nolint:nlreturn
 
-	if C.neru_ax_move_pointer(display, C.int(point.X), C.int(point.Y)) == 0 { //nolint:nlreturn
+	if C.neru_ax_move_pointer(C.int(point.X), C.int(point.Y)) == 0 { //nolint:nlreturn
 		return derrors.Newf(
 			derrors.CodeActionFailed,
 			"failed to move X11 pointer to (%d, %d)",
@@ -97,14 +96,12 @@ func x11MoveMouseToPoint(point image.Point) error {
 }
 
 func x11CurrentCursorPosition() image.Point {
-	display, err := x11ActionDisplay()
-	if err != nil {
+	if x11ActionAvailable() != nil {
 		return image.Point{}
 	}
-	defer C.neru_ax_close_display(display) //nolint:nlreturn
 
 	var x, y C.int
-	if C.neru_ax_query_pointer(display, &x, &y) == 0 { //nolint:nlreturn
+	if C.neru_x11_inject_query_pointer(&x, &y) == 0 { //nolint:nlreturn
 		return image.Point{}
 	}
 
@@ -136,13 +133,12 @@ func x11LeftMouseUpAtPoint(point image.Point, modifiers action.Modifiers) error
 }
 
 func x11LeftMouseUp() error {
-	display, err := x11ActionDisplay()
+	err := x11ActionAvailable()
 	if err != nil {
 		return err
 	}
-	defer C.neru_ax_close_display(display) //nolint:nlreturn
 
-	if C.neru_ax_button(display, 1, 0) == 0 { //nolint:nlreturn
+	if C.neru_ax_button(mouseButtonLeft, 0) == 0 { //nolint:nlreturn
 		return derrors.New(
 			derrors.CodeActionFailed,
 			"failed to release left mouse button on X11",
@@ -153,11 +149,10 @@ func x11LeftMouseUp() error {
 }
 
 func x11ScrollAtCursor(deltaX, deltaY int) error {
-	display, err := x11ActionDisplay()
+	err := x11ActionAvailable()
 	if err != nil {
 		return err
 	}
-	defer C.neru_ax_close_display(display) //nolint:nlreturn
 
 	// X11 scrolling is simulated via discrete button clicks (4, 5, 6, 7).
 	// Incoming deltas are pixel-level values from the scroll service config
@@ -169,6 +164,8 @@ func x11ScrollAtCursor(deltaX, deltaY int) error {
 		maxClicks = 50
 	)
 
+	var batch x11InjectBatch
+
 	if deltaY != 0 {
 		yClicks := abs(deltaY) / scale
 		if yClicks == 0 {
@@ -179,18 +176,15 @@ func x11ScrollAtCursor(deltaX, deltaY int) error {
 			yClicks = maxClicks
 		}
 
-		for range yClicks {
-			const mouseButtonVerticalScroll = 4
-			button := C.uint(mouseButtonVerticalScroll)
+		const mouseButtonVerticalScroll = 4
+		button := C.uint(mouseButtonVerticalScroll)
 
-			if deltaY < 0 {
-				button = 5
-			}
+		if deltaY < 0 {
+			button = 5
+		}
 
-			if C.neru_ax_button(display, button, 1) == 0 || //nolint:nlreturn
-				C.neru_ax_button(display, button, 0) == 0 { //nolint:nlreturn
-				return derrors.New(derrors.CodeActionFailed, "failed vertical scroll event on X11")
-			}
+		for range yClicks {
+			batch.click(button)
 		}
 	}
 
@@ -204,24 +198,22 @@ func x11ScrollAtCursor(deltaX, deltaY int) error {
 			xClicks = maxClicks
 		}
 
+		const mouseButtonHorizontalScrollRight = 7
+		button := C.uint(mouseButtonHorizontalScrollRight)
+
+		if deltaX < 0 {
+			button = 6
+		}
+
 		for range xClicks {
-			const mouseButtonHorizontalScrollRight = 7
-			button := C.uint(mouseButtonHorizontalScrollRight)
-
-			if deltaX < 0 {
-				button = 6
-			}
-
-			if C.neru_ax_button(display, button, 1) == 0 || //nolint:nlreturn
-				C.neru_ax_button(display, button, 0) == 0 { //nolint:nlreturn
-				return derrors.New(
-					derrors.CodeActionFailed,
-					"failed horizontal scroll event on X11",
-				)
-			}
+			batch.click(button)
 		}
 	}
 
+	if !batch.send() {
+		return derrors.New(derrors.CodeActionFailed, "failed scroll event on X11")
+	}
+
 	return nil
 }
 
@@ -231,38 +223,34 @@ func x11ClickButtonAtPoint(
 	modifiers action.Modifiers,
 	button C.uint,
 ) error {
-	display, err := x11ActionDisplay()
+	err := x11ActionAvailable()
 	if err != nil {
 		return err
 	}
 
-	defer C.neru_ax_close_display(display) //nolint:nlreturn
-
 	original := x11CurrentCursorPosition()
-	x11PressModifiers(display, modifiers)
-	defer x11ReleaseModifiers(display, modifiers)
 
-	if C.neru_ax_move_pointer(display, C.int(point.X), C.int(point.Y)) == 0 { //nolint:nlreturn
+	var batch x11InjectBatch
+
+	batch.pressModifiers(modifiers)
+	batch.motion(point)
+	batch.click(button)
+
+	if restoreCursor {
+		batch.motion(original)
+	}
+
+	batch.releaseModifiers(modifiers)
+
+	if !batch.send() {
 		return derrors.Newf(
 			derrors.CodeActionFailed,
-			"failed to move X11 pointer to (%d, %d)",
+			"failed to dispatch X11 button click at (%d, %d)",
 			point.X,
 			point.Y,
 		)
 	}
 
-	if C.neru_ax_button(display, button, 1) == 0 || //nolint:nlreturn
-		C.neru_ax_button(display, button, 0) == 0 { //nolint:nlreturn
-		return derrors.New(
-			derrors.CodeActionFailed,
-			"failed to dispatch X11 button click",
-		)
-	}
-
-	if restoreCursor {
-		_ = C.neru_ax_move_pointer(display, C.int(original.X), C.int(original.Y)) //nolint:nlreturn
-	}
-
 	return nil
 }
 
@@ -273,107 +261,141 @@ func x11MouseButtonAtPoint(
 	isDown bool,
 	restoreCursor bool,
 ) error {
-	display, err := x11ActionDisplay()
+	err := x11ActionAvailable()
 	if err != nil {
 		return err
 	}
-	defer C.neru_ax_close_display(display) //nolint:nlreturn
 
 	original := x11CurrentCursorPosition()
-	x11PressModifiers(display, modifiers)
 
-	// Only release modifiers within this function for mouse-up events.
-	// For mouse-down (isDown=true), modifiers must stay held until the
-	// corresponding mouse-up call; releasing them here would break
-	// modifier+drag operations (e.g. Shift+drag).
-	if !isDown {
-		defer x11ReleaseModifiers(display, modifiers)
-	}
+	var batch x11InjectBatch
 
-	if C.neru_ax_move_pointer(display, C.int(point.X), C.int(point.Y)) == 0 { //nolint:nlreturn
-		// If we failed to move and modifiers are held for a mouse-down,
-		// release them now to avoid stuck modifier keys.
-		if isDown {
-			x11ReleaseModifiers(display, modifiers)
-		}
+	batch.pressModifiers(modifiers)
+	batch.motion(point)
+	batch.button(button, isDown)
 
-		return derrors.Newf(
-			derrors.CodeActionFailed,
-			"failed to move X11 pointer to (%d, %d)",
-			point.X,
-			point.Y,
-		)
+	if restoreCursor {
+		batch.motion(original)
 	}
 
-	pressed := 0
-	if isDown {
-		pressed = 1
+	// Only release modifiers here for mouse-up events. For mouse-down,
+	// modifiers must stay held until the corresponding mouse-up call;
+	// releasing them here would break modifier+drag operations (e.g.
+	// Shift+drag).
+	if !isDown {
+		batch.releaseModifiers(modifiers)
 	}
 
-	if C.neru_ax_button(display, button, C.int(pressed)) == 0 { //nolint:nlreturn
+	if !batch.send() {
 		// Release modifiers on failure to avoid stuck keys.
 		if isDown {
-			x11ReleaseModifiers(display, modifiers)
+			var release x11InjectBatch
+
+			release.releaseModifiers(modifiers)
+			release.send()
 		}
 
-		return derrors.New(
+		return derrors.Newf(
 			derrors.CodeActionFailed,
-			"failed to dispatch X11 mouse button event",
+			"failed to dispatch X11 mouse button event at (%d, %d)",
+			point.X,
+			point.Y,
 		)
 	}
 
-	if restoreCursor {
-		_ = C.neru_ax_move_pointer(display, C.int(original.X), C.int(original.Y)) //nolint:nlreturn
-	}
-
 	return nil
 }
 
-func x11ActionDisplay() (*C.Display, error) {
+func x11ActionAvailable() error {
 	if os.Getenv("DISPLAY") == "" {
-		return nil, derrors.New(
+		return derrors.New(
 			derrors.CodeNotSupported,
 			"DISPLAY is not set; X11 action backend is unavailable",
 		)
 	}
 
-	display := C.neru_ax_open_display()
-	if display == nil {
-		return nil, derrors.New(
-			derrors.CodeActionFailed,
-			"failed to open X11 display for mouse injection",
-		)
-	}
+	return nil
+}
+
+// x11InjectBatch collects synthetic events so a whole gesture (modifiers,
+// motion, button press and release, cursor restore) reaches the server in
+// one flush of the shared XTest connection.
+type x11InjectBatch struct {
+	events []C.NeruX11InjectEvent
+}
 
-	return display, nil
+func (b *x11InjectBatch) motion(point image.Point) {
+	b.events = append(b.events, C.NeruX11InjectEvent{
+		_type: C.NERU_X11_INJECT_MOTION,
+		x:     C.int(point.X),
+		y:     C.int(point.Y),
+	})
 }
 
-func x11PressModifiers(display *C.Display, modifiers action.Modifiers) {
+func (b *x11InjectBatch) button(button C.uint, pressed bool) {
+	b.events = append(b.events, C.NeruX11InjectEvent{
+		_type:   C.NERU_X11_INJECT_BUTTON,
+		pressed: x11Bool(pressed),
+		detail:  C.ulong(button),
+	})
+}
+
+func (b *x11InjectBatch) click(button C.uint) {
+	b.button(button, true)
+	b.button(button, false)
+}
+
+func (b *x11InjectBatch) key(keysym C.KeySym, pressed bool) {
+	b.events = append(b.events, C.NeruX11InjectEvent{
+		_type:   C.NERU_X11_INJECT_KEY,
+		pressed: x11Bool(pressed),
+		detail:  C.ulong(keysym),
+	})
+}
+
+func (b *x11InjectBatch) pressModifiers(modifiers action.Modifiers) {
 	if modifiers.Has(action.ModShift) {
-		C.neru_ax_press_modifier(display, C.XK_Shift_L)
+		b.key(C.XK_Shift_L, true)
 	}
 	if modifiers.Has(action.ModCtrl) {
-		C.neru_ax_press_modifier(display, C.XK_Control_L)
+		b.key(C.XK_Control_L, true)
 	}
 	if modifiers.Has(action.ModAlt) {
-		C.neru_ax_press_modifier(display, C.XK_Alt_L)
+		b.key(C.XK_Alt_L, true)
 	}
 	if modifiers.Has(action.ModCmd) {
-		C.neru_ax_press_modifier(display, C.XK_Super_L)
+		b.key(C.XK_Super_L, true)
 	}
 }
 
-func x11ReleaseModifiers(display *C.Display, modifiers action.Modifiers) {
+func (b *x11InjectBatch) releaseModifiers(modifiers action.Modifiers) {
 	if modifiers.Has(action.ModCmd) {
-		C.neru_ax_release_modifier(display, C.XK_Super_L)
+		b.key(C.XK_Super_L, false)
 	}
 	if modifiers.Has(action.ModAlt) {
-		C.neru_ax_release_modifier(display, C.XK_Alt_L)
+		b.key(C.XK_Alt_L, false)
 	}
 	if modifiers.Has(action.ModCtrl) {
-		C.neru_ax_release_modifier(display, C.XK_Control_L)
+		b.key(C.XK_Control_L, false)
 	}
 	if modifiers.Has(action.ModShift) {
-		C.neru_ax_release_modifier(display, C.XK_Shift_L)
+		b.key(C.XK_Shift_L, false)
 	}
 }
+
+// send injects the batch and reports whether every event was accepted.
+func (b *x11InjectBatch) send() bool {
+	if len(b.events) == 0 {
+		return true
+	}
+
+	return C.neru_x11_inject(&b.events[0], C.int(len(b.events))) == 1
+}
+
+func x11Bool(value bool) C.int {
+	if value {
+		return 1
+	}
+
+	return 0
+}
@@ -0,0 +1,13 @@
+//go:build linux
+
+package eventtap
+
+import "github.com/y3owk1n/neru/internal/core/ports"
+
+// EventQueueStats reports the counters of the event tap's internal queues.
+func (a *Adapter) EventQueueStats() map[string]ports.EventQueueStats {
+	return a.tap.EventQueueStats()
+}
+
+// Ensure Adapter reports its queue counters on Linux.
+var _ ports.EventQueueStatsProvider = (*Adapter)(nil)
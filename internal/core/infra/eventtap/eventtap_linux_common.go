@@ -11,6 +11,7 @@ import (
 
 	"go.uber.org/zap"
 
+	"github.com/y3owk1n/neru/internal/core/ports"
 	"github.com/y3owk1n/neru/internal/ui/overlay"
 )
 
@@ -29,7 +30,7 @@ type pendingSyntheticModifierEvent struct {
 
 const syntheticModifierSuppressionWindow = 250 * time.Millisecond
 
-const dispatchChBufferSize = 256
+const dispatchQueueSize = 256
 
 // linuxModifierState tracks the reference count of each modifier key group.
 // Counts may go transiently negative when a grab captures the keyboard after
@@ -86,20 +87,21 @@ type EventTap struct {
 	stopCh chan struct{}
 	doneCh chan struct{}
 
-	// dispatchCh decouples the event-tap goroutine from the callback
+	// dispatchQueue decouples the event-tap goroutine from the callback
 	// goroutine, preventing a deadlock when a key dispatch triggers a mode
 	// exit that waits for the event-tap goroutine to stop.
-	// The event-tap goroutine enqueues keys here; the dispatch goroutine
-	// reads from this channel and invokes the callback. This matches the
+	// The event-tap goroutine is its only producer and the dispatch
+	// goroutine its only consumer, invoking the callback. This matches the
 	// macOS eventtap design.
-	dispatchCh chan string
-	dispatchWg sync.WaitGroup
-	destroyed  bool
-
-	// dispatchEpoch is incremented on every Disable(). dispatchLoop
-	// snapshots the epoch before processing a key and verifies it
-	// hasn't changed before invoking the callback. This prevents
-	// stale buffered events from leaking across enable/disable cycles.
+	dispatchQueue *spscRing[dispatchItem]
+	dispatchWg    sync.WaitGroup
+	destroyed     bool
+
+	// dispatchEpoch is incremented on every Disable(). Keys are queued with
+	// the epoch they were produced in, and dispatchLoop skips any whose
+	// epoch is no longer current. This prevents stale buffered events from
+	// leaking across enable/disable cycles without Disable having to drain
+	// the queue itself.
 	dispatchEpoch atomic.Uint64
 
 	// evdevWaylandCapture holds a *waylandEvdevCapture created once and
@@ -116,7 +118,7 @@ func NewEventTap(callback Callback, logger *zap.Logger) *EventTap {
 		logger:   logger,
 		callback: callback,
 	}
-	tap.dispatchCh = make(chan string, dispatchChBufferSize)
+	tap.dispatchQueue = newSPSCRing[dispatchItem](dispatchQueueSize)
 	tap.dispatchWg.Add(1)
 
 	go tap.dispatchLoop()
@@ -173,24 +175,11 @@ func (et *EventTap) Disable() {
 
 	<-doneCh
 
-	// Bump the dispatch epoch so any in-flight event that dispatchLoop
-	// picked up before we drained will be discarded rather than delivered
-	// to the callback.
+	// Bump the dispatch epoch. The event-tap goroutine has exited, so
+	// whatever remains queued was enqueued before the stop signal landed;
+	// dispatchLoop discards it rather than letting the next mode's handler
+	// misinterpret it after the event tap is re-enabled.
 	et.dispatchEpoch.Add(1)
-
-	// Drain any stale events from the dispatch channel. After the evdev
-	// goroutine has exited, no new events are being enqueued, so whatever
-	// remains in the buffer was enqueued before the stop signal landed.
-	// These stale events must be discarded to prevent them from being
-	// misinterpreted by the next mode's handler after the event tap is
-	// re-enabled.
-	for {
-		select {
-		case <-et.dispatchCh:
-		default:
-			return
-		}
-	}
 }
 
 // Destroy stops and cleans up the EventTap.
@@ -215,13 +204,24 @@ func (et *EventTap) Destroy() {
 	et.closeEvdevCapture()
 
 	// Stop the dispatch goroutine and wait for it to finish.
-	// The dispatchCh is created once in NewEventTap and lives for the
-	// entire lifetime of the EventTap, so we close the channel to signal
-	// the dispatch goroutine to exit.
-	close(et.dispatchCh)
+	// The dispatchQueue is created once in NewEventTap and lives for the
+	// entire lifetime of the EventTap, so we close it to signal the
+	// dispatch goroutine to exit.
+	et.dispatchQueue.close()
 	et.dispatchWg.Wait()
 }
 
+// EventQueueStats reports the counters of each queue between the keyboard
+// and the key callback, keyed by stage.
+func (et *EventTap) EventQueueStats() map[string]ports.EventQueueStats {
+	stats := map[string]ports.EventQueueStats{
+		"dispatch": et.dispatchQueue.stats(),
+	}
+	et.addEvdevQueueStats(stats)
+
+	return stats
+}
+
 // SetHandler sets the callback for key events.
 func (et *EventTap) SetHandler(handler func(key string)) {
 	et.mu.Lock()
@@ -348,31 +348,51 @@ func (et *EventTap) dispatchKey(key string) {
 		return
 	}
 
-	select {
-	case et.dispatchCh <- key:
-	default:
-		if et.logger != nil {
-			et.logger.Warn("Dispatch channel full, dropping key", zap.String("key", key))
-		}
+	if !et.dispatchQueue.push(dispatchItem{key: key, epoch: et.dispatchEpoch.Load()}) &&
+		et.logger != nil {
+		et.logger.Warn("Dispatch queue full, dropping key",
+			zap.String("key", key),
+			zap.Uint64("dropped", et.dispatchQueue.dropped.Load()),
+		)
 	}
 }
 
-// dispatchLoop reads key events from the dispatch channel and invokes the
-// registered callback. It runs in a dedicated goroutine that lives for the
-// entire lifetime of the EventTap.
+// dispatchItem is a queued key tagged with the dispatchEpoch it was
+// produced in.
+type dispatchItem struct {
+	key   string
+	epoch uint64
+}
+
+// dispatchLoop drains the dispatch queue and invokes the registered
+// callback. It runs in a dedicated goroutine that lives for the entire
+// lifetime of the EventTap.
 func (et *EventTap) dispatchLoop() {
 	defer et.dispatchWg.Done()
 
-	for key := range et.dispatchCh {
-		epoch := et.dispatchEpoch.Load()
+	for {
+		closed := et.dispatchQueue.isClosed()
+
+		for {
+			item, ok := et.dispatchQueue.pop()
+			if !ok {
+				break
+			}
+
+			et.mu.RLock()
+			cb := et.callback
+			et.mu.RUnlock()
 
-		et.mu.RLock()
-		cb := et.callback
-		et.mu.RUnlock()
+			if cb != nil && et.dispatchEpoch.Load() == item.epoch {
+				cb(item.key)
+			}
+		}
 
-		if cb != nil && et.dispatchEpoch.Load() == epoch {
-			cb(key)
+		if closed {
+			return
 		}
+
+		<-et.dispatchQueue.ready()
 	}
 }
 
@@ -2,7 +2,11 @@
 
 package eventtap
 
-import "errors"
+import (
+	"errors"
+
+	"github.com/y3owk1n/neru/internal/core/ports"
+)
 
 func (et *EventTap) runWayland() {
 	close(et.doneCh)
@@ -24,8 +28,8 @@ func ScrollDeviceScroll(_, _ int) error {
 	return errors.New("uinput scroll unavailable (no CGO)")
 }
 
-func ScrollDeviceScrollBatch(_ int, _ []int) error {
-	return errors.New("uinput scroll batch unavailable (no CGO)")
+func ScrollDeviceScrollBy(_, _, _, _ int) error {
+	return errors.New("uinput smooth scroll unavailable (no CGO)")
 }
 
 func IsUinputScrollAvailable() bool {
@@ -33,3 +37,5 @@ func IsUinputScrollAvailable() bool {
 }
 
 func (et *EventTap) closeEvdevCapture() {}
+
+func (et *EventTap) addEvdevQueueStats(_ map[string]ports.EventQueueStats) {}
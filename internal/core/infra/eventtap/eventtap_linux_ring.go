@@ -0,0 +1,146 @@
+//go:build linux
+
+package eventtap
+
+import (
+	"sync/atomic"
+
+	"github.com/y3owk1n/neru/internal/core/ports"
+)
+
+// spscCacheLine separates the producer- and consumer-owned ring indices so
+// the two goroutines do not invalidate each other's cache line on every item.
+type spscCacheLine [64]byte
+
+// spscRing is a bounded lock-free queue between exactly one producer and one
+// consumer goroutine. push never blocks: when the ring is full the new item
+// is dropped and counted. The consumer parks on ready(), a one-slot channel
+// the producer signals after publishing (the runtime parks it on a futex),
+// and drains everything queued per wakeup.
+//
+// Producers and consumers may change across Enable/Disable cycles as long as
+// each hand-over is ordered, e.g. by waiting for the previous goroutine to
+// exit.
+type spscRing[T any] struct {
+	// Producer side. tail is the next slot push writes.
+	tail      atomic.Uint64
+	dropped   atomic.Uint64
+	highWater atomic.Uint64
+	_         spscCacheLine
+
+	// Consumer side. head is the next slot pop reads.
+	head atomic.Uint64
+	_    spscCacheLine
+
+	slots  []T
+	mask   uint64
+	wake   chan struct{}
+	closed atomic.Bool
+}
+
+// newSPSCRing returns a ring holding at least capacity items, rounded up to
+// a power of two.
+func newSPSCRing[T any](capacity int) *spscRing[T] {
+	size := 1
+	for size < capacity {
+		size <<= 1
+	}
+
+	return &spscRing[T]{
+		slots: make([]T, size),
+		mask:  uint64(size - 1),
+		wake:  make(chan struct{}, 1),
+	}
+}
+
+// push enqueues item, or drops it and returns false when the ring is full.
+// Only the producer may call it.
+func (r *spscRing[T]) push(item T) bool {
+	tail := r.tail.Load()
+
+	depth := tail - r.head.Load()
+	if depth == uint64(len(r.slots)) {
+		r.dropped.Add(1)
+
+		return false
+	}
+
+	r.slots[tail&r.mask] = item
+	r.tail.Store(tail + 1)
+
+	if depth+1 > r.highWater.Load() {
+		r.highWater.Store(depth + 1)
+	}
+
+	r.signal()
+
+	return true
+}
+
+// pop dequeues the oldest item. Only the consumer may call it.
+func (r *spscRing[T]) pop() (T, bool) {
+	var zero T
+
+	head := r.head.Load()
+	if head == r.tail.Load() {
+		return zero, false
+	}
+
+	slot := &r.slots[head&r.mask]
+	item := *slot
+	*slot = zero
+	r.head.Store(head + 1)
+
+	return item, true
+}
+
+// discard drops everything queued. Only the consumer may call it.
+func (r *spscRing[T]) discard() {
+	for {
+		if _, ok := r.pop(); !ok {
+			return
+		}
+	}
+}
+
+// ready is signalled after items are pushed or the ring is closed. A wakeup
+// may find the ring already drained by an earlier pass; consumers must pop
+// until empty after every receive.
+func (r *spscRing[T]) ready() <-chan struct{} {
+	return r.wake
+}
+
+// close marks the ring finished and wakes the consumer. The producer must
+// have stopped pushing.
+func (r *spscRing[T]) close() {
+	r.closed.Store(true)
+	r.signal()
+}
+
+// isClosed reports whether close was called. A consumer that sees true and
+// then drains the ring has received every item.
+func (r *spscRing[T]) isClosed() bool {
+	return r.closed.Load()
+}
+
+func (r *spscRing[T]) signal() {
+	select {
+	case r.wake <- struct{}{}:
+	default:
+	}
+}
+
+// stats returns the ring's counters. Produced counts every push, including
+// dropped ones. head is loaded first so Consumed never exceeds Produced.
+func (r *spscRing[T]) stats() ports.EventQueueStats {
+	consumed := r.head.Load()
+	dropped := r.dropped.Load()
+
+	return ports.EventQueueStats{
+		Capacity:  len(r.slots),
+		Produced:  r.tail.Load() + dropped,
+		Consumed:  consumed,
+		Dropped:   dropped,
+		HighWater: r.highWater.Load(),
+	}
+}
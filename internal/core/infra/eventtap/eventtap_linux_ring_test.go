@@ -0,0 +1,166 @@
+//go:build linux && cgo
+
+//nolint:testpackage // These tests validate the unexported SPSC ring directly.
+package eventtap
+
+import (
+	"testing"
+	"time"
+
+	"github.com/y3owk1n/neru/internal/core/ports"
+)
+
+func TestSPSCRingFIFOAndWraparound(t *testing.T) {
+	t.Parallel()
+
+	ring := newSPSCRing[int](3)
+	if got := len(ring.slots); got != 4 {
+		t.Fatalf("capacity = %d, want 3 rounded up to 4", got)
+	}
+
+	next := 0
+	for round := range 5 {
+		for i := range 3 {
+			if !ring.push(round*3 + i) {
+				t.Fatalf("push %d failed on a ring with room", round*3+i)
+			}
+		}
+
+		for range 3 {
+			item, ok := ring.pop()
+			if !ok || item != next {
+				t.Fatalf("pop = %d, %v; want %d", item, ok, next)
+			}
+
+			next++
+		}
+	}
+
+	if _, ok := ring.pop(); ok {
+		t.Fatal("pop on an empty ring returned an item")
+	}
+}
+
+func TestSPSCRingDropsWhenFullAndCounts(t *testing.T) {
+	t.Parallel()
+
+	ring := newSPSCRing[int](4)
+	for i := range 6 {
+		ring.push(i)
+	}
+
+	ring.pop()
+
+	stats := ring.stats()
+	if stats.Produced != 6 || stats.Consumed != 1 || stats.Dropped != 2 ||
+		stats.HighWater != 4 || stats.Capacity != 4 {
+		t.Fatalf("stats = %+v", stats)
+	}
+
+	// The oldest items survive; the overflow is what gets dropped.
+	for want := 1; want < 4; want++ {
+		if item, _ := ring.pop(); item != want {
+			t.Fatalf("pop = %d, want %d", item, want)
+		}
+	}
+}
+
+func TestSPSCRingCloseWakesConsumer(t *testing.T) {
+	t.Parallel()
+
+	ring := newSPSCRing[int](4)
+	ring.push(1)
+	ring.close()
+
+	<-ring.ready()
+
+	if !ring.isClosed() {
+		t.Fatal("isClosed = false after close")
+	}
+
+	if item, ok := ring.pop(); !ok || item != 1 {
+		t.Fatal("items pushed before close must still be delivered")
+	}
+}
+
+// BenchmarkSPSCRingReplay replays key events at 10k/s, in 1ms bursts like a
+// held key repeating on several keyboards, through the evdev and dispatch
+// stages and reports how deep each ring got and whether anything dropped.
+func BenchmarkSPSCRingReplay(b *testing.B) {
+	const (
+		eventsPerSecond = 10_000
+		burstInterval   = time.Millisecond
+		burstSize       = eventsPerSecond / int(time.Second/burstInterval)
+	)
+
+	evdev := newSPSCRing[waylandEvdevEvent](waylandEvdevEventBufferSize)
+	dispatch := newSPSCRing[dispatchItem](dispatchQueueSize)
+	done := make(chan struct{})
+
+	go func() {
+		for {
+			closed := evdev.isClosed()
+
+			for {
+				if _, ok := evdev.pop(); !ok {
+					break
+				}
+
+				dispatch.push(dispatchItem{key: "j"})
+			}
+
+			if closed {
+				dispatch.close()
+
+				return
+			}
+
+			<-evdev.ready()
+		}
+	}()
+
+	go func() {
+		defer close(done)
+
+		for {
+			closed := dispatch.isClosed()
+			dispatch.discard()
+
+			if closed {
+				return
+			}
+
+			<-dispatch.ready()
+		}
+	}()
+
+	ticker := time.NewTicker(burstInterval)
+	defer ticker.Stop()
+
+	b.ResetTimer()
+
+	for sent := 0; sent < b.N; {
+		for i := 0; i < burstSize && sent < b.N; i++ {
+			evdev.push(waylandEvdevEvent{
+				eventType: evdevEventKey,
+				code:      evdevKeyA,
+				value:     evdevValueRepeat,
+			})
+			sent++
+		}
+
+		<-ticker.C
+	}
+
+	evdev.close()
+	<-done
+	b.StopTimer()
+
+	for stage, stats := range map[string]ports.EventQueueStats{
+		"evdev":    evdev.stats(),
+		"dispatch": dispatch.stats(),
+	} {
+		b.ReportMetric(float64(stats.HighWater), stage+"-high-water")
+		b.ReportMetric(float64(stats.Dropped), stage+"-dropped")
+	}
+}
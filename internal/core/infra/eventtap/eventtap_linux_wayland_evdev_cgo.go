@@ -3,36 +3,42 @@
 package eventtap
 
 /*
+#include <stdlib.h>
 #include "../platform/linux/evdev.h"
+#include "../platform/linux/evdev_poll.h"
 */
 import "C"
 
 import (
 	"errors"
 	"fmt"
+	"io/fs"
 	"os"
 	"path/filepath"
 	"slices"
 	"strings"
 	"sync"
-	"syscall"
+	"sync/atomic"
 	"time"
 	"unsafe"
 
 	"go.uber.org/zap"
 
 	linux "github.com/y3owk1n/neru/internal/core/infra/platform/linux"
+	"github.com/y3owk1n/neru/internal/core/ports"
 	"github.com/y3owk1n/neru/internal/ui/overlay"
 )
 
 const (
 	waylandEvdevEventBufferSize           = 128
+	waylandEvdevReadBatchSize             = 4 * C.NERU_EVDEV_POLL_BATCH
 	waylandEvdevModifierReleasePollPeriod = 5 * time.Millisecond
 	waylandEvdevPreGrabHoldPollPeriod     = 50 * time.Millisecond
 	waylandEvdevPreGrabTimeout            = 5 * time.Second
-	waylandEvdevHotplugBufSize            = 4096
-	waylandEvdevHotplugSettleDelay        = 100 * time.Millisecond
-	waylandEvdevHotplugPollInterval       = 500 * time.Millisecond
+	waylandEvdevHotplugDir                = "/dev/input"
+	waylandEvdevHotplugRetryInitial       = 10 * time.Millisecond
+	waylandEvdevHotplugRetryMax           = time.Second
+	waylandEvdevHotplugRetryLimit         = 10
 )
 
 var (
@@ -44,7 +50,6 @@ var (
 
 const (
 	waylandEvdevDeviceNameSize = 256
-	evdevMaxPressedKeys        = 256
 )
 
 const waylandEvdevBusVirtual = 0x06
@@ -93,20 +98,46 @@ type waylandEvdevKeyState struct {
 }
 
 type waylandEvdevCapture struct {
-	files  []*os.File
-	events chan waylandEvdevEvent
+	files []*os.File
+	// events carries key events from readLoop to the one goroutine
+	// consuming this capture at a time.
+	events *spscRing[waylandEvdevEvent]
 	logger *zap.Logger
 
+	// listening is set while a consumer drains events. While it is clear
+	// (Neru idle between modes) readLoop only tracks key state, so typing
+	// into other applications neither fills nor overflows the ring.
+	listening atomic.Bool
+
+	// poller multiplexes every captured device onto the single readLoop
+	// goroutine tracked by done.
+	poller *C.NeruEvdevPoller
+
+	// keys is kept current by readLoop once readersStarted is set; before
+	// that, key state queries fall back to an EVIOCGKEY snapshot.
+	keys           evdevKeyBitmap
+	readersStarted atomic.Bool
+
 	closeOnce        sync.Once
 	done             sync.WaitGroup
 	grabbed          bool
 	startReadersOnce sync.Once
 
-	deviceMu      sync.Mutex
-	inotifyFd     int
-	hotplugStopCh chan struct{}
-	hotplugOnce   sync.Once
-	hotplugWg     sync.WaitGroup
+	deviceMu sync.Mutex
+
+	// hotplugRetries holds hotplugged nodes that could not be opened yet.
+	// Only readLoop touches it.
+	hotplugRetries map[string]*evdevHotplugRetry
+}
+
+// evdevHotplugRetry tracks a device node udev has not granted us access to
+// yet. Retries back off exponentially on the poller's timerfd; an IN_ATTRIB
+// event from the permission change retries immediately.
+type evdevHotplugRetry struct {
+	plugged  time.Time
+	due      time.Time
+	delay    time.Duration
+	attempts int
 }
 
 func newWaylandEvdevCapture(logger *zap.Logger) (*waylandEvdevCapture, error) {
@@ -116,10 +147,10 @@ func newWaylandEvdevCapture(logger *zap.Logger) (*waylandEvdevCapture, error) {
 	}
 
 	capture := &waylandEvdevCapture{
-		files:     make([]*os.File, 0, len(paths)),
-		events:    make(chan waylandEvdevEvent, waylandEvdevEventBufferSize),
-		logger:    logger,
-		inotifyFd: -1,
+		files:          make([]*os.File, 0, len(paths)),
+		events:         newSPSCRing[waylandEvdevEvent](waylandEvdevEventBufferSize),
+		logger:         logger,
+		hotplugRetries: make(map[string]*evdevHotplugRetry),
 	}
 
 	for _, path := range paths {
@@ -164,6 +195,15 @@ func newWaylandEvdevCapture(logger *zap.Logger) (*waylandEvdevCapture, error) {
 		)
 	}
 
+	capture.poller = C.neru_evdev_poller_new()
+	if capture.poller == nil {
+		for _, file := range capture.files {
+			_ = file.Close()
+		}
+
+		return nil, fmt.Errorf("%w: failed to create evdev epoll set", errWaylandEvdevUnavailable)
+	}
+
 	logger.Debug(
 		"Evdev capture created",
 		zap.Int("keyboard_devices", len(capture.files)),
@@ -179,9 +219,11 @@ func (capture *waylandEvdevCapture) Close() {
 	}
 
 	capture.closeOnce.Do(func() {
-		// Stop the hotplug watcher first: closing the inotify fd unblocks
-		// the hotplugLoop goroutine, causing it to exit.
-		capture.stopHotplugWatcher()
+		// Wake the reader and wait for it before closing any device, so no
+		// fd is closed (and possibly reused) while it is still in the epoll
+		// set, and no event is pushed after we close the ring below.
+		C.neru_evdev_poller_stop(capture.poller)
+		capture.done.Wait()
 
 		capture.deviceMu.Lock()
 		capture.ungrabAllLocked()
@@ -193,13 +235,10 @@ func (capture *waylandEvdevCapture) Close() {
 		capture.files = nil
 		capture.deviceMu.Unlock()
 
-		// Wait for all reader goroutines to finish. Closing the files above
-		// makes neru_evdev_read_event return immediately, causing each reader
-		// to exit. We must wait here so that no reader can send on the events
-		// channel after we close it below.
-		capture.done.Wait()
+		C.neru_evdev_poller_free(capture.poller)
+		capture.poller = nil
 
-		close(capture.events)
+		capture.events.close()
 
 		if capture.logger != nil {
 			capture.logger.Debug("Evdev capture closed")
@@ -207,68 +246,196 @@ func (capture *waylandEvdevCapture) Close() {
 	})
 }
 
-// startReaders launches reader goroutines for each captured keyboard device
-// and starts the inotify hotplug watcher for detecting device hotplug.
-// These goroutines run for the entire lifetime of the capture, outliving
-// individual Enable/Disable cycles. Events are sent to capture.events with
-// a non-blocking send so that a full buffer (e.g. while Neru is disabled)
-// simply drops stale events instead of blocking the reader.
+// startReaders registers each captured keyboard device and the inotify
+// hotplug watch with the epoll set and starts the single reader goroutine.
+// It runs for the entire lifetime of the capture, outliving
+// individual Enable/Disable cycles. Events are pushed to capture.events
+// without blocking, so a consumer that falls behind costs dropped (and
+// counted) events instead of stalling the reader.
 func (capture *waylandEvdevCapture) startReaders() {
 	capture.deviceMu.Lock()
-	for _, file := range capture.files {
-		capture.done.Add(1)
-		go capture.readLoop(file)
+	for _, file := range slices.Clone(capture.files) {
+		if !capture.pollDevice(file) {
+			capture.removeFileLocked(file)
+			_ = file.Close()
+		}
 	}
+
+	// Seed the bitmap before the reader runs; presses queued in the kernel
+	// meanwhile are applied on top and are idempotent.
+	capture.resyncKeysLocked()
+	capture.readersStarted.Store(true)
 	capture.deviceMu.Unlock()
 
-	capture.startHotplugWatcher()
-}
+	capture.watchHotplug()
 
-func (capture *waylandEvdevCapture) startReader(file *os.File) {
 	capture.done.Add(1)
-	go capture.readLoop(file)
+	go capture.readLoop()
+}
+
+// pollDevice adds file to the epoll set the reader goroutine waits on.
+func (capture *waylandEvdevCapture) pollDevice(file *os.File) bool {
+	if C.neru_evdev_poller_add(capture.poller, C.int(file.Fd())) == 0 {
+		return true
+	}
+
+	if capture.logger != nil {
+		capture.logger.Debug("Failed to add evdev device to epoll set",
+			zap.String("device", file.Name()))
+	}
+
+	return false
 }
 
-func (capture *waylandEvdevCapture) readLoop(file *os.File) {
+// unpollDevice takes file out of the epoll set; call it before closing a
+// file that pollDevice added. Files the set never held are ignored.
+func (capture *waylandEvdevCapture) unpollDevice(file *os.File) {
+	C.neru_evdev_poller_remove_fd(capture.poller, C.int(file.Fd())) //nolint:nlreturn
+}
+
+// readLoop serves every device from one goroutine. Each cgo call blocks in
+// epoll and returns whole SYN_REPORT frames, read up to
+// NERU_EVDEV_POLL_BATCH events per syscall, from all devices that were
+// ready.
+func (capture *waylandEvdevCapture) readLoop() {
 	defer capture.done.Done()
 
-	fd := C.int(file.Fd())
+	var (
+		events [waylandEvdevReadBatchSize]C.NeruEvdevEvent
+		result C.NeruEvdevPollResult
+	)
 
 	for {
-		var inputEvent C.struct_input_event
-
-		readResult := C.neru_evdev_read_event(fd, &inputEvent)
-		if readResult <= 0 {
+		count := C.neru_evdev_poller_read(capture.poller, &events[0], C.int(len(events)), &result)
+		if count < 0 {
 			if capture.logger != nil {
-				capture.logger.Debug(
-					"Evdev reader exiting",
-					zap.String("device", file.Name()),
-					zap.Int("read_result", int(readResult)),
-				)
+				capture.logger.Debug("Evdev reader exiting")
 			}
 
-			// Device disconnected — remove it from the tracked files slice
-			// so we don't attempt to grab/query a stale fd on the next cycle.
-			capture.deviceMu.Lock()
-			capture.removeFileLocked(file)
-			capture.deviceMu.Unlock()
-			_ = file.Close()
-
 			return
 		}
 
-		// Non-blocking send: if the events channel is full (Neru is disabled
-		// between modes and stale events have accumulated), silently drop the
-		// event rather than blocking the reader.
-		select {
-		case capture.events <- waylandEvdevEvent{
-			eventType: uint16(inputEvent._type),
-			code:      uint16(inputEvent.code),
-			value:     int32(inputEvent.value),
-		}:
-		default:
+		for _, fd := range result.dead_fds[:result.ndead] {
+			capture.keys.forget(int32(fd))
+			capture.dropDevice(int(fd))
+		}
+
+		capture.handleHotplug(&result)
+
+		for _, event := range events[:count] {
+			eventType, code := uint16(event._type), uint16(event.code)
+			if capture.keys.apply(int32(event.device), eventType, code, int32(event.value)) {
+				capture.resyncKeys()
+			}
+
+			// Only key events are consumed downstream; keeping EV_MSC and
+			// EV_SYN out of the ring leaves its slots for real input.
+			if eventType != evdevEventKey || !capture.listening.Load() {
+				continue
+			}
+
+			capture.events.push(waylandEvdevEvent{
+				eventType: eventType,
+				code:      code,
+				value:     int32(event.value),
+			})
+		}
+	}
+}
+
+// drainEvents pops every queued event into handle. It returns false once
+// the capture is closed and fully drained.
+func (capture *waylandEvdevCapture) drainEvents(handle func(waylandEvdevEvent)) bool {
+	closed := capture.events.isClosed()
+
+	for {
+		event, ok := capture.events.pop()
+		if !ok {
+			return !closed
+		}
+
+		handle(event)
+	}
+}
+
+// dropDevice forgets a disconnected device so we don't attempt to grab or
+// query a stale fd on the next cycle. The poller has already removed it from
+// the epoll set.
+func (capture *waylandEvdevCapture) dropDevice(fd int) {
+	capture.deviceMu.Lock()
+	defer capture.deviceMu.Unlock()
+
+	for _, file := range capture.files {
+		if int(file.Fd()) != fd {
+			continue
+		}
+
+		if capture.logger != nil {
+			capture.logger.Debug("Evdev device disconnected", zap.String("device", file.Name()))
+		}
+
+		capture.removeFileLocked(file)
+		_ = file.Close()
+
+		// Keys held on the device never see their release.
+		capture.resyncKeysLocked()
+
+		return
+	}
+}
+
+// evdevDeviceKeys returns the keys file reports held, via EVIOCGKEY.
+func evdevDeviceKeys(file *os.File) evdevKeyMask {
+	var mask evdevKeyMask
+	C.neru_evdev_get_key_words(C.int(file.Fd()), (*C.uint64_t)(unsafe.Pointer(&mask[0])))
+
+	return mask
+}
+
+// snapshotKeysLocked unions the held keys of every captured device.
+// Must be called with capture.deviceMu held.
+func (capture *waylandEvdevCapture) snapshotKeysLocked() evdevKeyMask {
+	var snapshot evdevKeyMask
+
+	for _, file := range capture.files {
+		mask := evdevDeviceKeys(file)
+		for i := range snapshot {
+			snapshot[i] |= mask[i]
 		}
 	}
+
+	return snapshot
+}
+
+// resyncKeysLocked reseeds the bitmap from the devices after events were
+// lost. Must be called with capture.deviceMu held.
+func (capture *waylandEvdevCapture) resyncKeysLocked() {
+	snapshot := capture.snapshotKeysLocked()
+	capture.keys.store(&snapshot)
+}
+
+func (capture *waylandEvdevCapture) resyncKeys() {
+	capture.deviceMu.Lock()
+	defer capture.deviceMu.Unlock()
+
+	capture.resyncKeysLocked()
+}
+
+// keyState returns the live bitmap once the reader maintains it, or a
+// one-off EVIOCGKEY snapshot before the first grab.
+func (capture *waylandEvdevCapture) keyState() *evdevKeyBitmap {
+	if capture.readersStarted.Load() {
+		return &capture.keys
+	}
+
+	capture.deviceMu.Lock()
+	snapshot := capture.snapshotKeysLocked()
+	capture.deviceMu.Unlock()
+
+	var keys evdevKeyBitmap
+	keys.store(&snapshot)
+
+	return &keys
 }
 
 // removeFileLocked removes file from the tracked files slice.
@@ -311,15 +478,22 @@ func (capture *waylandEvdevCapture) grabAllLocked() error {
 
 	if len(grabbedFiles) == 0 {
 		for _, f := range capture.files {
+			capture.unpollDevice(f)
 			_ = f.Close()
 		}
 
+		capture.files = nil
+
 		virtualFile := capture.findVirtualDevice()
 		if virtualFile != nil {
 			kfd := C.int(virtualFile.Fd())
-			if C.neru_evdev_grab(kfd, 1) != 0 {
+			switch {
+			case C.neru_evdev_grab(kfd, 1) != 0:
+				_ = virtualFile.Close()
+			case capture.readersStarted.Load() && !capture.pollDevice(virtualFile):
+				C.neru_evdev_grab(kfd, 0)
 				_ = virtualFile.Close()
-			} else {
+			default:
 				capture.files = []*os.File{virtualFile}
 				capture.grabbed = true
 
@@ -344,6 +518,7 @@ func (capture *waylandEvdevCapture) grabAllLocked() error {
 	var remainingFiles []*os.File
 	for _, file := range capture.files {
 		if !slices.Contains(grabbedFiles, file) {
+			capture.unpollDevice(file)
 			_ = file.Close()
 		} else {
 			remainingFiles = append(remainingFiles, file)
@@ -413,287 +588,214 @@ func (capture *waylandEvdevCapture) modifierKeysHeld() bool {
 		return false
 	}
 
-	capture.deviceMu.Lock()
-	defer capture.deviceMu.Unlock()
-
-	modifierCodes := []uint16{
-		evdevKeyLeftShift,
-		evdevKeyRightShift,
-		evdevKeyLeftCtrl,
-		evdevKeyRightCtrl,
-		evdevKeyLeftAlt,
-		evdevKeyRightAlt,
-		evdevKeyLeftMeta,
-		evdevKeyRightMeta,
-	}
-
-	for _, file := range capture.files {
-		fd := C.int(file.Fd())
-
-		for _, code := range modifierCodes {
-			if C.neru_evdev_key_down(fd, C.uint(code)) != 0 {
-				return true
-			}
-		}
-	}
-
-	return false
+	return capture.keyState().anyDown(&evdevModifierKeyMask)
 }
 
-// queryAllPressedKeys retrieves all currently pressed keys via EVIOCGKEY from
-// each captured device and records them in the pressed map. This is called
-// after EVIOCGRAB because the kernel replays the current key state through the
-// SYN_DROPPED mechanism. By querying the state here we can distinguish keys
-// that were held before mode activation from keys pressed during the mode.
+// queryAllPressedKeys records every currently pressed key in the pressed map.
+// This is called after EVIOCGRAB because the kernel replays the current key
+// state through the SYN_DROPPED mechanism. By querying the state here we can
+// distinguish keys that were held before mode activation from keys pressed
+// during the mode.
 func queryAllPressedKeys(capture *waylandEvdevCapture, pressed map[uint16]bool) {
 	if capture == nil {
 		return
 	}
 
-	capture.deviceMu.Lock()
-	defer capture.deviceMu.Unlock()
-
-	keycodes := make([]C.uint, evdevMaxPressedKeys)
-
-	for _, file := range capture.files {
-		fd := C.int(file.Fd())
-		n := int(C.neru_evdev_get_pressed_keys(fd, &keycodes[0], C.int(len(keycodes))))
-		if n <= 0 {
-			continue
-		}
-
-		for i := range min(n, len(keycodes)) {
-			code := uint16(keycodes[i])
-			pressed[code] = true
-		}
-	}
+	capture.keyState().addPressed(pressed)
 }
 
-// queryEvdevModifierState queries the current evdev key state and returns
-// a linuxModifierState counting any held modifier keys across all captured
-// devices. Keys that are physically held are also recorded in pressed so that
+// queryEvdevModifierState returns a linuxModifierState counting the held
+// modifier keys. Keys that are held are also recorded in pressed so that
 // the event-loop press handler can avoid double-counting when the
 // corresponding evdev press event is processed from the buffer.
 func queryEvdevModifierState(
 	capture *waylandEvdevCapture,
 	pressed map[uint16]bool,
 ) linuxModifierState {
+	var state linuxModifierState
 	if capture == nil {
-		return linuxModifierState{}
+		return state
 	}
 
-	capture.deviceMu.Lock()
-	defer capture.deviceMu.Unlock()
-
-	var state linuxModifierState
-
-	type modifierKey struct {
-		code     uint16
-		modifier string
-	}
-	modifierKeys := []modifierKey{
-		{evdevKeyLeftShift, evdevModifierShift},
-		{evdevKeyRightShift, evdevModifierShift},
-		{evdevKeyLeftCtrl, evdevModifierCtrl},
-		{evdevKeyRightCtrl, evdevModifierCtrl},
-		{evdevKeyLeftAlt, evdevModifierAlt},
-		{evdevKeyRightAlt, evdevModifierAlt},
-		{evdevKeyLeftMeta, evdevModifierCmd},
-		{evdevKeyRightMeta, evdevModifierCmd},
+	keys := capture.keyState()
+	if !keys.anyDown(&evdevModifierKeyMask) {
+		return state
 	}
 
-	for _, file := range capture.files {
-		fd := C.int(file.Fd())
-
-		for _, mk := range modifierKeys {
-			if C.neru_evdev_key_down(fd, C.uint(mk.code)) != 0 {
-				state.update(mk.modifier, true)
-				pressed[mk.code] = true
-			}
+	for code, modifier := range evdevModifierNames {
+		if keys.isDown(code) {
+			state.update(modifier, true)
+			pressed[code] = true
 		}
 	}
 
 	return state
 }
 
-// startHotplugWatcher starts an inotify watch on /dev/input/ to detect new
-// keyboard devices being plugged in after initial capture creation.
-func (capture *waylandEvdevCapture) startHotplugWatcher() {
-	if capture == nil {
-		return
-	}
+// watchHotplug adds an inotify watch on /dev/input to the reader's epoll set
+// so keyboards plugged in after capture creation are picked up.
+func (capture *waylandEvdevCapture) watchHotplug() {
+	dir := C.CString(waylandEvdevHotplugDir)
+	defer C.free(unsafe.Pointer(dir)) //nolint:nlreturn
 
-	inotifyFd, err := syscall.InotifyInit1(syscall.IN_NONBLOCK)
-	if err != nil {
-		if capture.logger != nil {
-			capture.logger.Debug(
-				"Inotify init failed, keyboard hotplug detection disabled",
-				zap.Error(err),
-			)
-		}
+	if C.neru_evdev_poller_watch(capture.poller, dir) != 0 && capture.logger != nil {
+		capture.logger.Debug("Inotify watch failed, keyboard hotplug detection disabled")
+	}
+}
 
+// handleHotplug reacts to the inotify and retry timer results of one poll.
+// It runs on the reader goroutine, so a new keyboard is opened as soon as
+// its node appears rather than after a fixed settle delay.
+func (capture *waylandEvdevCapture) handleHotplug(result *C.NeruEvdevPollResult) {
+	if result.nhotplug == 0 && result.rescan == 0 && result.timer_expired == 0 {
 		return
 	}
 
-	_, err = syscall.InotifyAddWatch(inotifyFd, "/dev/input", syscall.IN_CREATE)
-	if err != nil {
-		_ = syscall.Close(inotifyFd)
-
-		if capture.logger != nil {
-			capture.logger.Debug(
-				"Inotify add watch failed, keyboard hotplug detection disabled",
-				zap.Error(err),
-			)
-		}
+	now := time.Now()
 
-		return
+	for i := range int(result.nhotplug) {
+		capture.tryHotplug(C.GoString(&result.hotplug[i][0]), now)
 	}
 
-	capture.deviceMu.Lock()
-	if capture.inotifyFd != -1 {
-		// A watcher is already running; clean up the duplicate.
-		capture.deviceMu.Unlock()
-		_ = syscall.Close(inotifyFd)
-
-		return
+	if result.rescan != 0 {
+		paths, _ := filepath.Glob(filepath.Join(waylandEvdevHotplugDir, "event*"))
+		for _, path := range paths {
+			capture.tryHotplug(filepath.Base(path), now)
+		}
 	}
 
-	capture.inotifyFd = inotifyFd
-	capture.hotplugStopCh = make(chan struct{})
-	capture.deviceMu.Unlock()
+	if result.timer_expired != 0 {
+		for name, retry := range capture.hotplugRetries {
+			if !retry.due.After(now) {
+				capture.tryHotplug(name, now)
+			}
+		}
+	}
 
-	capture.hotplugWg.Add(1)
-	go capture.hotplugLoop()
+	capture.armHotplugTimer(now)
 }
 
-// stopHotplugWatcher signals the hotplugLoop goroutine to stop via the stop
-// channel, closes the inotify fd, then waits for the goroutine to finish.
-func (capture *waylandEvdevCapture) stopHotplugWatcher() {
-	capture.deviceMu.Lock()
-	inotifyFd := capture.inotifyFd
-	capture.inotifyFd = -1
-	capture.deviceMu.Unlock()
+// tryHotplug attempts to capture a node and schedules a retry when access
+// is not granted yet.
+func (capture *waylandEvdevCapture) tryHotplug(name string, now time.Time) {
+	retry := capture.hotplugRetries[name]
 
-	capture.hotplugOnce.Do(func() {
-		if capture.hotplugStopCh != nil {
-			close(capture.hotplugStopCh)
-		}
-	})
-
-	if inotifyFd != -1 {
-		_ = syscall.Close(inotifyFd)
+	plugged := now
+	if retry != nil {
+		plugged = retry.plugged
 	}
 
-	capture.hotplugWg.Wait()
-}
-
-// hotplugLoop polls for inotify events with a non-blocking read and
-// rate-limits the poll via a ticker so the goroutine does not busy-wait
-// on EAGAIN.  A dedicated stop channel provides an interruptible shutdown
-// that does not rely on closing the inotify fd to unblock the read.
-func (capture *waylandEvdevCapture) hotplugLoop() {
-	defer capture.hotplugWg.Done()
+	if capture.handleNewDevice(name, plugged) {
+		delete(capture.hotplugRetries, name)
 
-	buf := make([]byte, waylandEvdevHotplugBufSize)
-	ticker := time.NewTicker(waylandEvdevHotplugPollInterval)
-	defer ticker.Stop()
+		return
+	}
 
-	for {
-		nread, err := syscall.Read(capture.inotifyFd, buf)
-		if err != nil {
-			if errors.Is(err, syscall.EAGAIN) || errors.Is(err, syscall.EWOULDBLOCK) {
-				select {
-				case <-capture.hotplugStopCh:
-					return
-				case <-ticker.C:
-				}
+	if retry == nil {
+		retry = &evdevHotplugRetry{plugged: now, delay: waylandEvdevHotplugRetryInitial}
+		capture.hotplugRetries[name] = retry
+	}
 
-				continue
-			}
+	retry.attempts++
+	if retry.attempts > waylandEvdevHotplugRetryLimit {
+		delete(capture.hotplugRetries, name)
 
-			return
+		if capture.logger != nil {
+			capture.logger.Debug("Giving up on inaccessible input device",
+				zap.String("device", name),
+				zap.Int("attempts", retry.attempts-1))
 		}
 
-		capture.handleInotifyEvents(buf[:nread])
+		return
 	}
+
+	retry.due = now.Add(retry.delay)
+	retry.delay = min(2*retry.delay, waylandEvdevHotplugRetryMax)
 }
 
-// handleInotifyEvents parses raw inotify event bytes and reacts to new device
-// creation events.
-func (capture *waylandEvdevCapture) handleInotifyEvents(buf []byte) {
-	offset := 0
-	for offset+syscall.SizeofInotifyEvent <= len(buf) {
-		event := (*syscall.InotifyEvent)(unsafe.Pointer(&buf[offset]))
-		nameLen := int(event.Len)
-		if nameLen > 0 && event.Mask&syscall.IN_CREATE != 0 {
-			nameStart := offset + syscall.SizeofInotifyEvent
-			nameEnd := nameStart + nameLen
-			nameEnd = min(nameEnd, len(buf))
-			name := strings.TrimRight(string(buf[nameStart:nameEnd]), "\x00")
-			if strings.HasPrefix(name, "event") {
-				capture.handleNewDevice(name)
-			}
+// armHotplugTimer points the poller's timerfd at the earliest pending retry.
+func (capture *waylandEvdevCapture) armHotplugTimer(now time.Time) {
+	var next time.Time
+	for _, retry := range capture.hotplugRetries {
+		if next.IsZero() || retry.due.Before(next) {
+			next = retry.due
 		}
-		offset += syscall.SizeofInotifyEvent + nameLen
 	}
+
+	delayMs := 0
+	if !next.IsZero() {
+		delayMs = max(1, int(next.Sub(now).Round(time.Millisecond)/time.Millisecond))
+	}
+
+	C.neru_evdev_poller_arm_timer(capture.poller, C.int(delayMs))
 }
 
-// handleNewDevice opens a newly created /dev/input/event* device and, if it
-// is a keyboard, adds it to the capture and starts a reader goroutine. If
-// the capture is currently in a grabbed state, the new device is also grabbed
-// immediately so Neru stays in full control.
-func (capture *waylandEvdevCapture) handleNewDevice(name string) {
-	// Give udev a moment to fully initialize the device node and populate
-	// the input capabilities before we interrogate it.
-	time.Sleep(waylandEvdevHotplugSettleDelay)
+// handleNewDevice opens a hotplugged /dev/input/event* node and, if it is a
+// keyboard, adds it to the capture and to the reader's epoll set. If the
+// capture is currently in a grabbed state, the new device is also grabbed
+// immediately so Neru stays in full control. It returns false only when the
+// node cannot be opened yet for lack of permission and should be retried.
+func (capture *waylandEvdevCapture) handleNewDevice(name string, plugged time.Time) bool {
+	path := filepath.Join(waylandEvdevHotplugDir, name)
 
-	path := filepath.Join("/dev/input", name)
 	file, err := os.Open(path)
 	if err != nil {
-		return
+		return !errors.Is(err, fs.ErrPermission)
 	}
 
 	fd := C.int(file.Fd())
 	if C.neru_evdev_is_keyboard(fd) == 0 {
 		_ = file.Close()
 
-		return
+		return true
 	}
 
 	capture.deviceMu.Lock()
 
-	// Avoid duplicates: the device might already be tracked if the inotify
-	// event fired for a device that was open at initial scan time (unlikely
-	// but possible on some kernels).
+	// Avoid duplicates: IN_ATTRIB fires for nodes we already hold, and a
+	// rescan revisits every node.
 	for _, f := range capture.files {
 		if f.Name() == path {
 			capture.deviceMu.Unlock()
 			_ = file.Close()
 
-			return
+			return true
 		}
 	}
 
 	// If the capture is currently grabbed, grab the new device under the
 	// same lock so Disable cannot race ahead and ungrab before we finish.
-	if capture.grabbed && C.neru_evdev_grab(C.int(file.Fd()), 1) != 0 {
+	grabbed := capture.grabbed
+	if grabbed && C.neru_evdev_grab(C.int(file.Fd()), 1) != 0 {
 		capture.deviceMu.Unlock()
 		_ = file.Close()
 
-		return
+		return true
 	}
 
+	if !capture.pollDevice(file) {
+		capture.deviceMu.Unlock()
+		_ = file.Close()
+
+		return true
+	}
+
+	mask := evdevDeviceKeys(file)
+	capture.keys.merge(&mask)
+
 	capture.files = append(capture.files, file)
 	capture.deviceMu.Unlock()
 
-	capture.startReader(file)
-
 	if capture.logger != nil {
 		capture.logger.Info(
 			"New keyboard device detected and captured",
 			zap.String("device", path),
+			zap.Bool("grabbed", grabbed),
+			zap.Duration("plug_to_capture", time.Since(plugged)),
 		)
 	}
+
+	return true
 }
 
 // initEvdevCapture initializes the persistent waylandEvdevCapture.
@@ -738,6 +840,9 @@ func (et *EventTap) initEvdevCapture() (*waylandEvdevCapture, error) {
 // descriptors and stopping reader goroutines. It is safe to call multiple
 // times — the underlying Close() uses sync.Once.
 func (et *EventTap) closeEvdevCapture() {
+	et.evdevWaylandCaptureInit.Lock()
+	defer et.evdevWaylandCaptureInit.Unlock()
+
 	if et.evdevWaylandCapture == nil {
 		return
 	}
@@ -751,6 +856,17 @@ func (et *EventTap) closeEvdevCapture() {
 	et.evdevWaylandCapture = nil
 }
 
+// addEvdevQueueStats adds the counters of the evdev reader's ring, once the
+// capture exists.
+func (et *EventTap) addEvdevQueueStats(stats map[string]ports.EventQueueStats) {
+	et.evdevWaylandCaptureInit.Lock()
+	defer et.evdevWaylandCaptureInit.Unlock()
+
+	if capture, ok := et.evdevWaylandCapture.(*waylandEvdevCapture); ok {
+		stats["evdev"] = capture.events.stats()
+	}
+}
+
 func (et *EventTap) runWaylandEvdev() bool {
 	// Get or create the persistent capture (initialized once, reused
 	// across Enable/Disable cycles). This avoids re-scanning
@@ -761,6 +877,9 @@ func (et *EventTap) runWaylandEvdev() bool {
 		return false
 	}
 
+	// Set again once a wait or the grab needs events; cleared on every exit.
+	defer capture.listening.Store(false)
+
 	manager := overlay.Get()
 	keyboardCaptureDisabled := false
 	if manager != nil {
@@ -789,6 +908,9 @@ func (et *EventTap) runWaylandEvdev() bool {
 		held := make(map[uint16]bool)
 		queryAllPressedKeys(capture, held)
 		if len(held) > 0 {
+			// Once the reader runs, its events wake the wait early.
+			capture.listening.Store(true)
+
 			if manager != nil {
 				manager.SetKeyboardCaptureEnabled(true)
 			}
@@ -814,8 +936,8 @@ func (et *EventTap) runWaylandEvdev() bool {
 				case <-deadline:
 					break waitLoop
 				case <-ticker.C:
-				case _, ok := <-capture.events:
-					if !ok {
+				case <-capture.events.ready():
+					if !capture.drainEvents(func(waylandEvdevEvent) {}) {
 						ticker.Stop()
 
 						return true
@@ -860,19 +982,12 @@ func (et *EventTap) runWaylandEvdev() bool {
 		)
 	}
 
-	// Drain any stale events that accumulated in the channel while
-	// Neru was disabled between modes. These are events from other
-	// applications that were pushed into the buffer when we were
-	// ungrabbed. A labeled break is required here — plain break
-	// inside select only exits the select, not the for loop.
-drainStale:
-	for {
-		select {
-		case <-capture.events:
-		default:
-			break drainStale
-		}
-	}
+	capture.listening.Store(true)
+
+	// Drain any stale events queued before the grab took effect (e.g.
+	// while waiting for held keys above). These went to other
+	// applications when we were ungrabbed.
+	capture.events.discard()
 
 	pressed := make(map[uint16]bool)
 	state := waylandEvdevKeyState{
@@ -898,6 +1013,10 @@ drainStale:
 		state.initialKeys[code] = true
 	}
 
+	handleEvent := func(event waylandEvdevEvent) {
+		et.handleWaylandEvdevEvent(&state, event)
+	}
+
 	for {
 		select {
 		case <-et.stopCh:
@@ -930,12 +1049,10 @@ drainStale:
 			capture.ungrabAll()
 
 			return true
-		case event, ok := <-capture.events:
-			if !ok {
+		case <-capture.events.ready():
+			if !capture.drainEvents(handleEvent) {
 				return true
 			}
-
-			et.handleWaylandEvdevEvent(&state, event)
 		}
 	}
 }
@@ -1068,6 +1185,7 @@ func (state *waylandEvdevKeyState) trackKey(code uint16, isDown bool) {
 var (
 	uinputScrollOnce sync.Once
 	uinputScrollFd   int
+	uinputScroller   *C.NeruUinputScroller
 	errUinputScroll  error
 )
 
@@ -1077,6 +1195,9 @@ func initUinputScroll() error {
 		return fmt.Errorf("%w", errUinputScrollUnavailable)
 	}
 	uinputScrollFd = int(fd)
+	// A nil scroller only disables ScrollDeviceScrollBy; the per-event
+	// helpers write to the fd directly.
+	uinputScroller = C.neru_uinput_scroller_new(fd)
 
 	return nil
 }
@@ -1112,28 +1233,27 @@ func ScrollDeviceScroll(axis, value int) error {
 	return nil
 }
 
-// ScrollDeviceScrollBatch sends multiple scroll events in a single write.
-func ScrollDeviceScrollBatch(axis int, values []int) error {
-	if len(values) == 0 {
-		return nil
-	}
-
-	ufd, err := getUinputScrollFd()
+// ScrollDeviceScrollBy scrolls the uinput device by (dx120, dy120) value120
+// units (120 per wheel notch, positive = up/right) spread over durationMs at
+// refreshMhz, carrying fractions of a notch in REL_*_HI_RES. It returns once
+// the scroll is written or started.
+func ScrollDeviceScrollBy(dx120, dy120, durationMs, refreshMhz int) error {
+	_, err := getUinputScrollFd()
 	if err != nil {
 		return err
 	}
 
-	cValues := make([]C.int, len(values))
-	for i, v := range values {
-		cValues[i] = C.int(v)
+	if uinputScroller == nil {
+		return fmt.Errorf("%w", errUinputScrollUnavailable)
 	}
 
-	if C.neru_uinput_scroll_batch(
-		C.int(ufd),
-		C.int(axis),
-		&cValues[0],
-		C.int(len(values)),
-	) == 0 { //nolint:lll
+	if C.neru_uinput_scroll_by(
+		uinputScroller,
+		C.int(dx120),
+		C.int(dy120),
+		C.int(durationMs),
+		C.int(refreshMhz),
+	) == 0 {
 		return fmt.Errorf("%w", errUinputScrollSend)
 	}
 
@@ -0,0 +1,148 @@
+//go:build linux
+
+package eventtap
+
+import (
+	"math/bits"
+	"sync/atomic"
+)
+
+const (
+	evdevEventSyn uint16 = 0x00
+
+	evdevSynReport  uint16 = 0
+	evdevSynDropped uint16 = 3
+
+	// evdevKeyCount is the kernel's KEY_CNT: one bit per keycode.
+	evdevKeyCount = 768
+	evdevKeyWords = evdevKeyCount / 64
+)
+
+// evdevKeyMask is a plain (non-atomic) set of keycodes used to query an
+// evdevKeyBitmap.
+type evdevKeyMask [evdevKeyWords]uint64
+
+func newEvdevKeyMask(codes ...uint16) evdevKeyMask {
+	var mask evdevKeyMask
+	for _, code := range codes {
+		if int(code) < evdevKeyCount {
+			mask[code/64] |= 1 << (code % 64)
+		}
+	}
+
+	return mask
+}
+
+// evdevModifierKeyMask covers every key in evdevModifierNames.
+var evdevModifierKeyMask = func() evdevKeyMask {
+	codes := make([]uint16, 0, len(evdevModifierNames))
+	for code := range evdevModifierNames {
+		codes = append(codes, code)
+	}
+
+	return newEvdevKeyMask(codes...)
+}()
+
+// evdevKeyBitmap tracks which keys are held across all captured devices. The
+// reader goroutine keeps it current from the event stream, so state queries
+// are a handful of word loads instead of an EVIOCGKEY ioctl per device.
+// Words are accessed atomically; apply and forget must only be called by one
+// goroutine.
+type evdevKeyBitmap struct {
+	words [evdevKeyWords]atomic.Uint64
+
+	// dropped holds the devices between a SYN_DROPPED and the SYN_REPORT
+	// that ends their gap; the kernel discarded their events in between, so
+	// their key events are ignored until the bitmap is resynced. Other
+	// devices' frames neither end nor suffer the gap.
+	dropped map[int32]bool
+}
+
+// apply folds one input event from device into the bitmap. It reports true
+// when the caller must resync the bitmap from the devices because events
+// were lost.
+func (b *evdevKeyBitmap) apply(device int32, eventType, code uint16, value int32) bool {
+	switch eventType {
+	case evdevEventSyn:
+		switch code {
+		case evdevSynDropped:
+			if b.dropped == nil {
+				b.dropped = make(map[int32]bool)
+			}
+
+			b.dropped[device] = true
+		case evdevSynReport:
+			if b.dropped[device] {
+				delete(b.dropped, device)
+
+				return true
+			}
+		}
+	case evdevEventKey:
+		if b.dropped[device] || int(code) >= evdevKeyCount {
+			return false
+		}
+
+		word, bit := &b.words[code/64], uint64(1)<<(code%64)
+		if value == evdevValueRelease {
+			word.And(^bit)
+		} else {
+			word.Or(bit)
+		}
+	}
+
+	return false
+}
+
+// forget drops the gap state of a device that went away, so a new device
+// reusing its fd does not inherit it.
+func (b *evdevKeyBitmap) forget(device int32) {
+	delete(b.dropped, device)
+}
+
+// store replaces the whole bitmap, e.g. with a fresh EVIOCGKEY snapshot.
+func (b *evdevKeyBitmap) store(mask *evdevKeyMask) {
+	for i := range b.words {
+		b.words[i].Store(mask[i])
+	}
+}
+
+// merge adds keys, e.g. those already held on a hotplugged device.
+func (b *evdevKeyBitmap) merge(mask *evdevKeyMask) {
+	for i := range b.words {
+		if mask[i] != 0 {
+			b.words[i].Or(mask[i])
+		}
+	}
+}
+
+func (b *evdevKeyBitmap) isDown(code uint16) bool {
+	if int(code) >= evdevKeyCount {
+		return false
+	}
+
+	return b.words[code/64].Load()&(1<<(code%64)) != 0
+}
+
+// anyDown reports whether any key in mask is held.
+func (b *evdevKeyBitmap) anyDown(mask *evdevKeyMask) bool {
+	for i := range b.words {
+		if mask[i] != 0 && b.words[i].Load()&mask[i] != 0 {
+			return true
+		}
+	}
+
+	return false
+}
+
+// addPressed records every held key in pressed.
+func (b *evdevKeyBitmap) addPressed(pressed map[uint16]bool) {
+	for i := range b.words {
+		word := b.words[i].Load()
+		for word != 0 {
+			bit := bits.TrailingZeros64(word)
+			pressed[uint16(i*64+bit)] = true
+			word &= word - 1
+		}
+	}
+}
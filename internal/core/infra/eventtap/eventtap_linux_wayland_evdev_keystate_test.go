@@ -0,0 +1,184 @@
+//go:build linux
+
+//nolint:testpackage // These tests validate the unexported evdev key bitmap directly.
+package eventtap
+
+import "testing"
+
+type evdevTestEvent struct {
+	device    int32
+	eventType uint16
+	code      uint16
+	value     int32
+}
+
+func evdevKeyFrame(code uint16, value int32) []evdevTestEvent {
+	return []evdevTestEvent{
+		{eventType: evdevEventKey, code: code, value: value},
+		{eventType: evdevEventSyn, code: evdevSynReport},
+	}
+}
+
+func applyEvdevEvents(t *testing.T, keys *evdevKeyBitmap, events []evdevTestEvent) bool {
+	t.Helper()
+
+	resync := false
+	for _, event := range events {
+		if keys.apply(event.device, event.eventType, event.code, event.value) {
+			resync = true
+		}
+	}
+
+	return resync
+}
+
+func TestEvdevKeyBitmapTracksPressAndRelease(t *testing.T) {
+	t.Parallel()
+
+	var keys evdevKeyBitmap
+
+	var events []evdevTestEvent
+	events = append(events, evdevKeyFrame(evdevKeyLeftShift, evdevValuePress)...)
+	events = append(events, evdevKeyFrame(evdevKeyA, evdevValuePress)...)
+	events = append(events, evdevKeyFrame(evdevKeyA, evdevValueRepeat)...)
+	events = append(events, evdevKeyFrame(evdevKeyA, evdevValueRelease)...)
+
+	if applyEvdevEvents(t, &keys, events) {
+		t.Fatal("apply requested a resync without SYN_DROPPED")
+	}
+
+	if !keys.isDown(evdevKeyLeftShift) {
+		t.Fatal("left shift should be held")
+	}
+
+	if keys.isDown(evdevKeyA) {
+		t.Fatal("a should be released")
+	}
+
+	if !keys.anyDown(&evdevModifierKeyMask) {
+		t.Fatal("anyDown(modifiers) = false with shift held")
+	}
+
+	applyEvdevEvents(t, &keys, evdevKeyFrame(evdevKeyLeftShift, evdevValueRelease))
+
+	if keys.anyDown(&evdevModifierKeyMask) {
+		t.Fatal("anyDown(modifiers) = true after shift release")
+	}
+}
+
+func TestEvdevKeyBitmapHighKeycodes(t *testing.T) {
+	t.Parallel()
+
+	var keys evdevKeyBitmap
+
+	// KEY_MAX (0x2ff) is the last valid bit; anything above is ignored.
+	applyEvdevEvents(t, &keys, evdevKeyFrame(0x2ff, evdevValuePress))
+	applyEvdevEvents(t, &keys, evdevKeyFrame(evdevKeyCount, evdevValuePress))
+
+	pressed := make(map[uint16]bool)
+	keys.addPressed(pressed)
+
+	if len(pressed) != 1 || !pressed[0x2ff] {
+		t.Fatalf("pressed = %v, want only 0x2ff", pressed)
+	}
+}
+
+func TestEvdevKeyBitmapSynDropped(t *testing.T) {
+	t.Parallel()
+
+	var keys evdevKeyBitmap
+
+	applyEvdevEvents(t, &keys, evdevKeyFrame(evdevKeyLeftCtrl, evdevValuePress))
+
+	// Events between SYN_DROPPED and the next SYN_REPORT are incomplete and
+	// must not be applied; the SYN_REPORT asks for a resync instead.
+	dropped := []evdevTestEvent{
+		{eventType: evdevEventSyn, code: evdevSynDropped},
+		{eventType: evdevEventKey, code: evdevKeyLeftCtrl, value: evdevValueRelease},
+		{eventType: evdevEventKey, code: evdevKeyB, value: evdevValuePress},
+		{eventType: evdevEventSyn, code: evdevSynReport},
+	}
+	if !applyEvdevEvents(t, &keys, dropped) {
+		t.Fatal("SYN_REPORT after SYN_DROPPED did not request a resync")
+	}
+
+	if !keys.isDown(evdevKeyLeftCtrl) || keys.isDown(evdevKeyB) {
+		t.Fatal("events inside the dropped gap were applied")
+	}
+
+	resynced := newEvdevKeyMask(evdevKeyB)
+	keys.store(&resynced)
+
+	if keys.isDown(evdevKeyLeftCtrl) || !keys.isDown(evdevKeyB) {
+		t.Fatal("store did not replace the bitmap")
+	}
+
+	if applyEvdevEvents(t, &keys, evdevKeyFrame(evdevKeyB, evdevValueRelease)) {
+		t.Fatal("resync requested again after the gap closed")
+	}
+
+	if keys.isDown(evdevKeyB) {
+		t.Fatal("b should be released once events apply again")
+	}
+}
+
+func TestEvdevKeyBitmapSynDroppedPerDevice(t *testing.T) {
+	t.Parallel()
+
+	const keyboard, mouse = 3, 4
+
+	var keys evdevKeyBitmap
+
+	// The mouse's SYN_REPORT must not end the keyboard's gap: the
+	// keyboard's stale release still has to be ignored.
+	events := []evdevTestEvent{
+		{device: keyboard, eventType: evdevEventSyn, code: evdevSynDropped},
+		{device: mouse, eventType: evdevEventKey, code: evdevKeyA, value: evdevValuePress},
+		{device: mouse, eventType: evdevEventSyn, code: evdevSynReport},
+		{device: keyboard, eventType: evdevEventKey, code: evdevKeyB, value: evdevValuePress},
+	}
+	if applyEvdevEvents(t, &keys, events) {
+		t.Fatal("another device's SYN_REPORT requested a resync")
+	}
+
+	if !keys.isDown(evdevKeyA) || keys.isDown(evdevKeyB) {
+		t.Fatal("gap should only cover the device that dropped events")
+	}
+
+	report := []evdevTestEvent{{device: keyboard, eventType: evdevEventSyn, code: evdevSynReport}}
+	if !applyEvdevEvents(t, &keys, report) {
+		t.Fatal("the device's own SYN_REPORT did not request a resync")
+	}
+}
+
+func TestEvdevKeyBitmapForget(t *testing.T) {
+	t.Parallel()
+
+	var keys evdevKeyBitmap
+
+	applyEvdevEvents(t, &keys, []evdevTestEvent{{eventType: evdevEventSyn, code: evdevSynDropped}})
+	keys.forget(0)
+
+	if applyEvdevEvents(t, &keys, evdevKeyFrame(evdevKeyA, evdevValuePress)) {
+		t.Fatal("a forgotten device's gap requested a resync")
+	}
+
+	if !keys.isDown(evdevKeyA) {
+		t.Fatal("events of a forgotten device's fd should apply")
+	}
+}
+
+func TestEvdevKeyBitmapMerge(t *testing.T) {
+	t.Parallel()
+
+	var keys evdevKeyBitmap
+
+	applyEvdevEvents(t, &keys, evdevKeyFrame(evdevKeyA, evdevValuePress))
+
+	hotplugged := newEvdevKeyMask(evdevKeyRightMeta)
+	keys.merge(&hotplugged)
+
+	if !keys.isDown(evdevKeyA) || !keys.isDown(evdevKeyRightMeta) {
+		t.Fatal("merge should keep existing keys and add the new device's keys")
+	}
+}
@@ -14,13 +14,15 @@ import (
 	"time"
 	"unsafe"
 
+	"go.uber.org/zap"
+
 	"github.com/y3owk1n/neru/internal/core/infra/platform/linux"
 )
 
 const (
-	x11PollingInterval = 10 * time.Millisecond
-	x11KeyBufferSize   = 64
-	x11BitsPerByte     = 8
+	x11KeyBufferSize = 64
+	x11BitsPerByte   = 8
+	x11WaitForever   = -1
 )
 
 // x11QueryModifierState queries the X11 server for the current keyboard
@@ -100,6 +102,44 @@ func (et *EventTap) runX11() {
 	// been released — arming detection while others are still held.
 	modState := x11QueryModifierState(display)
 
+	// The loop blocks in poll() on the X connection; the eventfd lets Disable
+	// interrupt it without a polling interval.
+	wakeFD := C.neru_x11_waker_open()
+	if wakeFD < 0 {
+		return
+	}
+
+	loopDone := make(chan struct{})
+	wakerDone := make(chan struct{})
+
+	go func() {
+		defer close(wakerDone)
+
+		select {
+		case <-et.stopCh:
+			C.neru_x11_waker_wake(wakeFD)
+		case <-loopDone:
+		}
+	}()
+
+	defer func() {
+		close(loopDone)
+		<-wakerDone
+		C.neru_x11_waker_close(wakeFD) //nolint:nlreturn
+	}()
+
+	// Translate key events through the precomputed keymap table; without
+	// XKB fall back to XLookupString per event.
+	keys := newX11KeyTable(display)
+	if keys != nil {
+		defer keys.close()
+	}
+
+	var (
+		event  C.XEvent
+		buffer [x11KeyBufferSize]C.char
+	)
+
 	for {
 		select {
 		case <-et.stopCh:
@@ -107,64 +147,118 @@ func (et *EventTap) runX11() {
 		default:
 		}
 
-		if C.neru_eventtap_pending(display) == 0 { //nolint:nlreturn
-			time.Sleep(x11PollingInterval)
-
-			continue
+		if C.neru_x11_wait(display, wakeFD, x11WaitForever) < 0 { //nolint:nlreturn
+			return
 		}
 
-		var event C.XEvent
-		eventType := C.neru_eventtap_next(display, &event) //nolint:nlreturn
-		if eventType != C.KeyPress && eventType != C.KeyRelease {
-			continue
-		}
+		woke := time.Now()
+
+		// Drain everything queued by this wakeup before blocking again.
+		for range int(C.neru_eventtap_pending(display)) { //nolint:nlreturn
+			eventType := C.neru_eventtap_next(display, &event) //nolint:nlreturn
+
+			if keys != nil && keys.changed(&event) {
+				keys.rebuild(display)
 
-		xkey := (*C.XKeyEvent)(unsafe.Pointer(&event))
-		buffer := make([]C.char, x11KeyBufferSize)
-		var keysym C.KeySym
-		length := C.XLookupString(
-			xkey,
-			&buffer[0],
-			C.int(len(buffer)),
-			&keysym,
-			nil, //nolint:nlreturn
-		)
-
-		if modifier := x11ModifierName(keysym); modifier != "" {
-			isDown := eventType == C.KeyPress
-			modState.update(modifier, isDown)
-
-			if et.consumeSyntheticModifierEvent(modifier, isDown) {
 				continue
 			}
 
-			if et.stickyToggleEnabled() && et.stickyDetectionArmed() {
-				et.dispatchKey(linuxModifierToggleEvent(modifier, isDown))
+			if eventType != C.KeyPress && eventType != C.KeyRelease {
+				continue
 			}
 
-			// Re-arm when the modifier state reaches a clean slate, so
-			// activation-chord releases are not interpreted as sticky toggles.
-			if !isDown && !et.stickyDetectionArmed() && modState.allZero() {
-				et.stickyArmDetection()
+			xkey := (*C.XKeyEvent)(unsafe.Pointer(&event))
+
+			var name x11KeyName
+			if keys != nil {
+				if found := keys.lookup(uint32(xkey.keycode), uint32(xkey.state)); found != nil {
+					name = *found
+				}
+			} else {
+				name = x11LookupKeyName(xkey, buffer[:])
 			}
 
-			continue
+			et.handleX11Key(name, eventType == C.KeyPress, &modState, woke)
 		}
+	}
+}
 
-		key := x11KeyFromLookup(length, buffer, keysym)
-		if key == "" {
-			continue
+// x11LookupKeyName translates a key event with XLookupString, for servers
+// without XKB.
+func x11LookupKeyName(xkey *C.XKeyEvent, buffer []C.char) x11KeyName {
+	var keysym C.KeySym
+	length := C.XLookupString(
+		xkey,
+		&buffer[0],
+		C.int(len(buffer)),
+		&keysym,
+		nil, //nolint:nlreturn
+	)
+
+	if modifier := x11ModifierName(keysym); modifier != "" {
+		return x11KeyName{modifier: modifier}
+	}
+
+	key := x11KeyFromLookup(length, buffer, keysym)
+	if key == "" {
+		return x11KeyName{}
+	}
+
+	return x11KeyName{key: key, keyUp: linuxKeyUpEvent(key)}
+}
+
+func (et *EventTap) handleX11Key(
+	name x11KeyName,
+	isDown bool,
+	modState *linuxModifierState,
+	woke time.Time,
+) {
+	if modifier := name.modifier; modifier != "" {
+		modState.update(modifier, isDown)
+
+		if et.consumeSyntheticModifierEvent(modifier, isDown) {
+			return
 		}
 
-		if eventType == C.KeyRelease {
-			if keyUp := linuxKeyUpEvent(key); keyUp != "" {
-				et.dispatchKey(keyUp)
-			}
+		if et.stickyToggleEnabled() && et.stickyDetectionArmed() {
+			et.dispatchX11Key(linuxModifierToggleEvent(modifier, isDown), woke)
+		}
 
-			continue
+		// Re-arm when the modifier state reaches a clean slate, so
+		// activation-chord releases are not interpreted as sticky toggles.
+		if !isDown && !et.stickyDetectionArmed() && modState.allZero() {
+			et.stickyArmDetection()
+		}
+
+		return
+	}
+
+	if name.key == "" {
+		return
+	}
+
+	if !isDown {
+		if name.keyUp != "" {
+			et.dispatchX11Key(name.keyUp, woke)
 		}
 
-		et.dispatchKey(key)
+		return
+	}
+
+	et.dispatchX11Key(name.key, woke)
+}
+
+// dispatchX11Key dispatches key and logs how long it took from the loop
+// waking up to the key being queued for the callback.
+func (et *EventTap) dispatchX11Key(key string, woke time.Time) {
+	et.dispatchKey(key)
+
+	if et.logger == nil {
+		return
+	}
+
+	if ce := et.logger.Check(zap.DebugLevel, "X11 key dispatched"); ce != nil {
+		ce.Write(zap.String("key", key), zap.Duration("latency", time.Since(woke)))
 	}
 }
 
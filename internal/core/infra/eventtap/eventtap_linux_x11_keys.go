@@ -0,0 +1,143 @@
+//go:build linux && cgo
+
+package eventtap
+
+/*
+#include <stdlib.h>
+#include "../platform/linux/x11_eventtap.h"
+*/
+import "C"
+
+import "unsafe"
+
+// x11KeyName is the precomputed translation of one (keycode, state) pair.
+type x11KeyName struct {
+	key      string // normalized key for a press, "" when unnamed
+	keyUp    string // matching "__keyup_" event
+	modifier string // canonical modifier name when the keysym is a modifier
+}
+
+// x11KeyTable maps X key events to Neru key names without calling
+// XLookupString or building strings per event. It mirrors the C keymap
+// table entry for entry and is rebuilt when the server announces a keymap
+// change. Only the eventtap goroutine uses it.
+type x11KeyTable struct {
+	keymap *C.NeruX11Keymap
+	names  []x11KeyName
+}
+
+// newX11KeyTable returns nil when the server has no XKB; callers then fall
+// back to XLookupString.
+func newX11KeyTable(display *C.Display) *x11KeyTable {
+	keymap := C.neru_x11_keymap_new(display) //nolint:nlreturn
+	if keymap == nil {
+		return nil
+	}
+
+	table := &x11KeyTable{keymap: keymap}
+	table.load()
+
+	return table
+}
+
+func (t *x11KeyTable) close() {
+	C.neru_x11_keymap_free(t.keymap)
+	t.keymap = nil
+	t.names = nil
+}
+
+// changed reports whether event announces a keyboard mapping change.
+func (t *x11KeyTable) changed(event *C.XEvent) bool {
+	return C.neru_x11_keymap_changed(t.keymap, event) != 0
+}
+
+// rebuild re-reads the XKB map after a MappingNotify or XKB keymap event.
+func (t *x11KeyTable) rebuild(display *C.Display) {
+	if C.neru_x11_keymap_rebuild(t.keymap, display) != 0 { //nolint:nlreturn
+		t.load()
+	}
+}
+
+func (t *x11KeyTable) load() {
+	keys := unsafe.Slice(t.keymap.keys, int(t.keymap.nkeys))
+	names := make([]x11KeyName, len(keys))
+	interned := make(map[string]string)
+
+	intern := func(value string) string {
+		if existing, ok := interned[value]; ok {
+			return existing
+		}
+
+		interned[value] = value
+
+		return value
+	}
+
+	for i := range keys {
+		info := &keys[i]
+		if info.keysym == C.NoSymbol {
+			continue
+		}
+
+		if modifier := x11ModifierName(info.keysym); modifier != "" {
+			names[i].modifier = modifier
+
+			continue
+		}
+
+		key := x11KeyFromLookup(info.text_len, info.text[:], info.keysym)
+		if key == "" {
+			continue
+		}
+
+		names[i].key = intern(key)
+		names[i].keyUp = intern(linuxKeyUpEvent(key))
+	}
+
+	t.names = names
+}
+
+// lookup returns the translation for a key event's keycode and state, or nil
+// when the keycode is outside the table. It does not allocate.
+func (t *x11KeyTable) lookup(keycode, state uint32) *x11KeyName {
+	index := int(C.neru_x11_keymap_index(t.keymap, C.uint(keycode), C.uint(state))) //nolint:nlreturn
+	if index < 0 || index >= len(t.names) {
+		return nil
+	}
+
+	return &t.names[index]
+}
+
+// newX11KeyTableForTesting builds a single-group, Shift-only table over
+// keycodes [minKeycode, maxKeycode] without an X server: keycode k types the
+// letter 'a'+(k-minKeycode)%26, capitalized with Shift.
+func newX11KeyTableForTesting(minKeycode, maxKeycode int) *x11KeyTable {
+	const numStates = 2 // Shift up, Shift down
+
+	keymap := (*C.NeruX11Keymap)(C.calloc(1, C.sizeof_NeruX11Keymap))
+	nkeys := (maxKeycode - minKeycode + 1) * numStates
+	keymap.keys = (*C.NeruX11KeyInfo)(C.calloc(C.size_t(nkeys), C.sizeof_NeruX11KeyInfo))
+	keymap.nkeys = C.size_t(nkeys)
+	keymap.min_keycode = C.int(minKeycode)
+	keymap.max_keycode = C.int(maxKeycode)
+	keymap.num_groups = 1
+	keymap.level_mask = C.ShiftMask
+	keymap.num_states = numStates
+
+	keys := unsafe.Slice(keymap.keys, nkeys)
+	for i := range keys {
+		letter := byte('a' + (i/numStates)%26)
+		if i%numStates == 1 {
+			letter -= 'a' - 'A'
+		}
+
+		keys[i].keysym = C.KeySym(letter)
+		keys[i].text[0] = C.char(letter)
+		keys[i].text_len = 1
+	}
+
+	table := &x11KeyTable{keymap: keymap}
+	table.load()
+
+	return table
+}
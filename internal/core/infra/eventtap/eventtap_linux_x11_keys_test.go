@@ -0,0 +1,67 @@
+//go:build linux && cgo
+
+//nolint:testpackage // These tests validate the unexported X11 key table directly.
+package eventtap
+
+import "testing"
+
+const x11TestShiftMask = 1 << 0 // ShiftMask
+
+func TestX11KeyTableLookup(t *testing.T) {
+	t.Parallel()
+
+	table := newX11KeyTableForTesting(8, 40)
+	t.Cleanup(table.close)
+
+	tests := []struct {
+		name    string
+		keycode uint32
+		state   uint32
+		want    string
+	}{
+		{"first keycode", 8, 0, normalizeLinuxKey("a")},
+		{"shifted", 9, x11TestShiftMask, normalizeLinuxKey("B")},
+		{"unmapped modifiers ignored", 10, 1 << 6, normalizeLinuxKey("c")},
+		{"last keycode", 40, 0, normalizeLinuxKey("g")},
+	}
+
+	for _, tt := range tests {
+		t.Run(tt.name, func(t *testing.T) {
+			t.Parallel()
+
+			name := table.lookup(tt.keycode, tt.state)
+			if name == nil {
+				t.Fatalf("lookup(%d, %#x) = nil", tt.keycode, tt.state)
+			}
+
+			if name.key != tt.want || name.keyUp != linuxKeyUpEvent(tt.want) {
+				t.Fatalf("lookup(%d, %#x) = %q/%q, want %q", tt.keycode, tt.state,
+					name.key, name.keyUp, tt.want)
+			}
+		})
+	}
+
+	for _, keycode := range []uint32{7, 41} {
+		if name := table.lookup(keycode, 0); name != nil {
+			t.Fatalf("lookup(%d) = %+v, want nil outside the table", keycode, *name)
+		}
+	}
+}
+
+func TestX11KeyTableLookupDoesNotAllocate(t *testing.T) {
+	table := newX11KeyTableForTesting(8, 255)
+	defer table.close()
+
+	var sink *x11KeyName
+
+	allocs := testing.AllocsPerRun(1000, func() {
+		sink = table.lookup(38, x11TestShiftMask)
+	})
+	if allocs != 0 {
+		t.Fatalf("lookup allocated %.1f times per call, want 0", allocs)
+	}
+
+	if sink == nil || sink.key == "" {
+		t.Fatal("lookup missed a keycode inside the table")
+	}
+}
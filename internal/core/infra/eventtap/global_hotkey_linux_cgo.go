@@ -79,6 +79,7 @@ func (l *GlobalHotkeyListener) Start() error {
 
 	// Intentionally no grabAll(): a passive read leaves keys flowing to the
 	// focused application, which is what a global hotkey should do.
+	capture.listening.Store(true)
 	capture.startReaders()
 
 	l.capture = capture
@@ -125,21 +126,22 @@ func (l *GlobalHotkeyListener) IsRunning() bool {
 
 func (l *GlobalHotkeyListener) run(capture *waylandEvdevCapture, stopCh chan struct{}) {
 	state := waylandEvdevKeyState{pressed: make(map[uint16]bool)}
+	handleEvent := func(event waylandEvdevEvent) {
+		l.handleEvent(&state, event)
+	}
 
 	for {
 		select {
 		case <-stopCh:
 			return
-		case event, ok := <-capture.events:
-			if !ok {
-				if !l.tryRestartLocked(&capture, &stopCh, &state) {
-					return
-				}
-
+		case <-capture.events.ready():
+			if capture.drainEvents(handleEvent) {
 				continue
 			}
 
-			l.handleEvent(&state, event)
+			if !l.tryRestartLocked(&capture, &stopCh, &state) {
+				return
+			}
 		}
 	}
 }
@@ -174,6 +176,7 @@ func (l *GlobalHotkeyListener) tryRestartLocked(
 		return false
 	}
 
+	newCapture.listening.Store(true)
 	newCapture.startReaders()
 
 	oldCapture := *capture
@@ -15,25 +15,45 @@ import (
 	"time"
 	"unsafe"
 
+	"go.uber.org/zap"
+
 	derrors "github.com/y3owk1n/neru/internal/core/errors"
 	_ "github.com/y3owk1n/neru/internal/core/infra/platform/linux"
 )
 
-const x11HotkeyPollInterval = 10 * time.Millisecond
+const x11WaitForever = -1
 
 type x11HotkeyBinding struct {
+	keysym    C.KeySym
 	keycode   C.int
 	modifiers C.uint
+	callback  Callback
+}
+
+// x11BindingID is the grabbed (keycode, modifiers) pair a KeyPress matches.
+type x11BindingID struct {
+	keycode   C.uint
+	modifiers C.uint
 }
 
+var x11IgnoredLockMasks = []C.uint{0, C.Mod2Mask, C.LockMask, C.Mod2Mask | C.LockMask}
+
 type x11HotkeyState struct {
-	display  *C.Display
-	root     C.Window
+	display *C.Display
+	root    C.Window
+	wakeFD  C.int // eventfd that interrupts runX11HotkeyLoop's poll
+
+	// mu guards the keymap and binding tables. runX11HotkeyLoop takes only
+	// this lock, never Manager.mu: UnregisterAll holds Manager.mu while it
+	// waits for the loop to exit.
+	mu       sync.Mutex
+	keymap   *C.NeruX11Keymap // nil without XKB
 	bindings map[HotkeyID]x11HotkeyBinding
-	ids      map[string]HotkeyID
-	stopCh   chan struct{} // signals runX11HotkeyLoop to exit
-	doneCh   chan struct{} // closed when runX11HotkeyLoop has exited
-	once     sync.Once
+	ids      map[x11BindingID]HotkeyID
+
+	stopCh chan struct{} // signals runX11HotkeyLoop to exit
+	doneCh chan struct{} // closed when runX11HotkeyLoop has exited
+	once   sync.Once
 }
 
 var x11States sync.Map
@@ -44,27 +64,35 @@ func (m *Manager) registerX11Hotkey(hotkeyID HotkeyID, keyString string) error {
 		return err
 	}
 
-	keycode, modifiers, parseErr := parseX11Hotkey(state.display, keyString)
+	keysym, modifiers, parseErr := parseX11Hotkey(keyString)
 	if parseErr != nil {
 		return parseErr
 	}
 
-	for _, mask := range []C.uint{0, C.Mod2Mask, C.LockMask, C.Mod2Mask | C.LockMask} {
-		C.XGrabKey(
-			state.display,
-			C.int(keycode),
-			modifiers|mask,
-			state.root,
-			C.True,
-			C.GrabModeAsync,
-			C.GrabModeAsync, //nolint:nlreturn
+	state.mu.Lock()
+	defer state.mu.Unlock()
+
+	keycode := state.keycodeFor(keysym)
+	if keycode == 0 {
+		return derrors.Newf(
+			derrors.CodeInvalidInput,
+			"failed to resolve X11 keycode for %q",
+			keyString,
 		)
 	}
+
+	binding := x11HotkeyBinding{
+		keysym:    keysym,
+		keycode:   C.int(keycode),
+		modifiers: modifiers,
+		callback:  m.callbacks[hotkeyID],
+	}
+	state.grab(binding)
 	C.XSelectInput(state.display, state.root, C.KeyPressMask) //nolint:nlreturn
 	C.XFlush(state.display)                                   //nolint:nlreturn
 
-	state.bindings[hotkeyID] = x11HotkeyBinding{keycode: C.int(keycode), modifiers: modifiers}
-	state.ids[x11BindingKey(keycode, modifiers)] = hotkeyID
+	state.bindings[hotkeyID] = binding
+	state.ids[x11BindingID{keycode: keycode, modifiers: modifiers}] = hotkeyID
 
 	return nil
 }
@@ -79,22 +107,18 @@ func (m *Manager) unregisterX11Hotkey(hotkeyID HotkeyID) {
 		return
 	}
 
+	state.mu.Lock()
+	defer state.mu.Unlock()
+
 	binding, exists := state.bindings[hotkeyID]
 	if !exists {
 		return
 	}
 
-	for _, mask := range []C.uint{0, C.Mod2Mask, C.LockMask, C.Mod2Mask | C.LockMask} {
-		C.XUngrabKey( //nolint:nlreturn
-			state.display,
-			binding.keycode,
-			binding.modifiers|mask,
-			state.root, //nolint:nlreturn
-		)
-	}
+	state.ungrab(binding)
 	C.XFlush(state.display) //nolint:nlreturn
 
-	delete(state.ids, x11BindingKey(C.uint(binding.keycode), binding.modifiers))
+	delete(state.ids, x11BindingID{keycode: C.uint(binding.keycode), modifiers: binding.modifiers})
 	delete(state.bindings, hotkeyID)
 }
 
@@ -108,7 +132,14 @@ func (m *Manager) unregisterAllX11Hotkeys() {
 		return
 	}
 
+	state.mu.Lock()
+	ids := make([]HotkeyID, 0, len(state.bindings))
 	for id := range state.bindings {
+		ids = append(ids, id)
+	}
+	state.mu.Unlock()
+
+	for _, id := range ids {
 		m.unregisterX11Hotkey(id)
 	}
 
@@ -116,8 +147,11 @@ func (m *Manager) unregisterAllX11Hotkeys() {
 		// Signal the event loop to stop and wait for it to exit
 		// before closing the display, preventing a use-after-free.
 		close(state.stopCh)
+		C.neru_x11_waker_wake(state.wakeFD)
 		<-state.doneCh
 
+		C.neru_x11_waker_close(state.wakeFD)
+		C.neru_x11_keymap_free(state.keymap)
 		C.XCloseDisplay(state.display) //nolint:nlreturn
 		x11States.Delete(m)
 	})
@@ -141,11 +175,23 @@ func (m *Manager) ensureX11State() (*x11HotkeyState, error) {
 		)
 	}
 
+	wakeFD := C.neru_x11_waker_open()
+	if wakeFD < 0 {
+		C.XCloseDisplay(display) //nolint:nlreturn
+
+		return nil, derrors.New(
+			derrors.CodeHotkeyRegisterFailed,
+			"failed to create wakeup fd for X11 global hotkeys",
+		)
+	}
+
 	state := &x11HotkeyState{
 		display:  display,
 		root:     C.neru_hotkeys_root_window(display), //nolint:nlreturn
+		keymap:   C.neru_x11_keymap_new(display),      //nolint:nlreturn
+		wakeFD:   wakeFD,
 		bindings: make(map[HotkeyID]x11HotkeyBinding),
-		ids:      make(map[string]HotkeyID),
+		ids:      make(map[x11BindingID]HotkeyID),
 		stopCh:   make(chan struct{}),
 		doneCh:   make(chan struct{}),
 	}
@@ -158,6 +204,8 @@ func (m *Manager) ensureX11State() (*x11HotkeyState, error) {
 func (m *Manager) runX11HotkeyLoop(state *x11HotkeyState) {
 	defer close(state.doneCh)
 
+	var event C.XEvent
+
 	for {
 		select {
 		case <-state.stopCh:
@@ -165,47 +213,132 @@ func (m *Manager) runX11HotkeyLoop(state *x11HotkeyState) {
 		default:
 		}
 
-		// Use XPending to check for queued events instead of calling the
-		// blocking XNextEvent directly. This allows the stop channel to be
-		// checked between iterations, preventing a goroutine leak and a
-		// use-after-free when unregisterAllX11Hotkeys closes the display.
-		if C.neru_hotkeys_pending(state.display) == 0 { //nolint:nlreturn
-			time.Sleep(x11HotkeyPollInterval)
+		// Block on the X connection instead of sleeping between XPending
+		// checks; unregisterAllX11Hotkeys signals wakeFD so the loop exits
+		// before the display is closed.
+		if C.neru_x11_wait(state.display, state.wakeFD, x11WaitForever) < 0 { //nolint:nlreturn
+			return
+		}
 
-			continue
+		woke := time.Now()
+
+		// Drain everything queued by this wakeup before blocking again.
+		for range int(C.neru_hotkeys_pending(state.display)) { //nolint:nlreturn
+			C.XNextEvent(state.display, &event) //nolint:nlreturn
+
+			if state.keymapChanged(&event) {
+				m.remapX11Hotkeys(state)
+
+				continue
+			}
+
+			m.handleX11HotkeyEvent(state, &event, woke)
 		}
+	}
+}
+
+// remapX11Hotkeys rebuilds the keymap table after a layout change and moves
+// every grab to the keycode its keysym now lives on.
+func (m *Manager) remapX11Hotkeys(state *x11HotkeyState) {
+	state.mu.Lock()
+	defer state.mu.Unlock()
+
+	if C.neru_x11_keymap_rebuild(state.keymap, state.display) == 0 { //nolint:nlreturn
+		return
+	}
+
+	clear(state.ids)
+
+	for id, binding := range state.bindings {
+		state.ungrab(binding)
+
+		keycode := state.keycodeFor(binding.keysym)
+		if keycode == 0 {
+			m.logger.Warn("X11 hotkey key no longer on the keyboard map",
+				zap.Int("id", int(id)))
 
-		var event C.XEvent
-		C.XNextEvent(state.display, &event)           //nolint:nlreturn
-		if C.neru_xevent_type(&event) != C.KeyPress { //nolint:nlreturn
 			continue
 		}
 
-		keycode := C.neru_xkey_keycode(&event)                              //nolint:nlreturn
-		modifiers := C.neru_xkey_state(&event) &^ (C.Mod2Mask | C.LockMask) //nolint:nlreturn
+		binding.keycode = C.int(keycode)
+		state.grab(binding)
+		state.bindings[id] = binding
+		state.ids[x11BindingID{keycode: keycode, modifiers: binding.modifiers}] = id
+	}
 
-		// Hold m.mu while reading state.ids — Register/Unregister write
-		// to this map under the same lock, so an unguarded read here is a
-		// concurrent map read/write (runtime crash under the race detector).
-		// We also fetch the callback in the same critical section to avoid
-		// a second lock acquisition via callbackFor.
-		m.mu.RLock()
-		id, ok := state.ids[x11BindingKey(keycode, modifiers)]
+	C.XFlush(state.display) //nolint:nlreturn
+}
 
-		var callback Callback
-		if ok {
-			callback = m.callbacks[id]
-		}
+func (state *x11HotkeyState) keymapChanged(event *C.XEvent) bool {
+	return state.keymap != nil && C.neru_x11_keymap_changed(state.keymap, event) != 0
+}
 
-		m.mu.RUnlock()
+func (state *x11HotkeyState) keycodeFor(keysym C.KeySym) C.uint {
+	if state.keymap != nil {
+		return C.uint(C.neru_x11_keymap_keycode(state.keymap, keysym))
+	}
 
-		if callback != nil {
-			go callback()
-		}
+	return C.uint(C.XKeysymToKeycode(state.display, keysym))
+}
+
+func (state *x11HotkeyState) grab(binding x11HotkeyBinding) {
+	for _, mask := range x11IgnoredLockMasks {
+		C.XGrabKey(
+			state.display,
+			binding.keycode,
+			binding.modifiers|mask,
+			state.root,
+			C.True,
+			C.GrabModeAsync,
+			C.GrabModeAsync, //nolint:nlreturn
+		)
+	}
+}
+
+func (state *x11HotkeyState) ungrab(binding x11HotkeyBinding) {
+	for _, mask := range x11IgnoredLockMasks {
+		C.XUngrabKey( //nolint:nlreturn
+			state.display,
+			binding.keycode,
+			binding.modifiers|mask,
+			state.root, //nolint:nlreturn
+		)
+	}
+}
+
+func (m *Manager) handleX11HotkeyEvent(state *x11HotkeyState, event *C.XEvent, woke time.Time) {
+	if C.neru_xevent_type(event) != C.KeyPress { //nolint:nlreturn
+		return
+	}
+
+	keycode := C.neru_xkey_keycode(event)                              //nolint:nlreturn
+	modifiers := C.neru_xkey_state(event) &^ (C.Mod2Mask | C.LockMask) //nolint:nlreturn
+
+	// Register/Unregister write state.ids under state.mu, so read it under
+	// the same lock. The callback travels with the binding, which keeps
+	// this goroutine off m.mu.
+	state.mu.Lock()
+	id, ok := state.ids[x11BindingID{keycode: keycode, modifiers: modifiers}]
+
+	var callback Callback
+	if ok {
+		callback = state.bindings[id].callback
+	}
+
+	state.mu.Unlock()
+
+	if callback == nil {
+		return
+	}
+
+	go callback()
+
+	if ce := m.logger.Check(zap.DebugLevel, "X11 hotkey dispatched"); ce != nil {
+		ce.Write(zap.Int("id", int(id)), zap.Duration("latency", time.Since(woke)))
 	}
 }
 
-func parseX11Hotkey(display *C.Display, keyString string) (C.uint, C.uint, error) {
+func parseX11Hotkey(keyString string) (C.KeySym, C.uint, error) {
 	parts := strings.Split(keyString, "+")
 	if len(parts) == 0 {
 		return 0, 0, derrors.Newf(derrors.CodeInvalidInput, "invalid hotkey: %q", keyString)
@@ -244,16 +377,7 @@ func parseX11Hotkey(display *C.Display, keyString string) (C.uint, C.uint, error
 		)
 	}
 
-	keycode := C.XKeysymToKeycode(display, keysym) //nolint:nlreturn
-	if keycode == 0 {
-		return 0, 0, derrors.Newf(
-			derrors.CodeInvalidInput,
-			"failed to resolve X11 keycode for %q",
-			keyString,
-		)
-	}
-
-	return C.uint(keycode), modifiers, nil
+	return keysym, modifiers, nil
 }
 
 func x11KeysymFor(key string) C.KeySym {
@@ -291,29 +415,3 @@ func x11KeysymFor(key string) C.KeySym {
 		return C.XStringToKeysym(cKey)
 	}
 }
-
-func x11BindingKey(keycode C.uint, modifiers C.uint) string {
-	return strings.Join([]string{itoa(int(keycode)), itoa(int(modifiers))}, ":")
-}
-
-func itoa(value int) string {
-	if value == 0 {
-		return "0"
-	}
-
-	sign := ""
-	if value < 0 {
-		sign = "-"
-		value = -value
-	}
-
-	var buf [20]byte
-	index := len(buf)
-	for value > 0 {
-		index--
-		buf[index] = byte('0' + value%10)
-		value /= 10
-	}
-
-	return sign + string(buf[index:])
-}
@@ -7,5 +7,6 @@ package linux
 
 /*
 #cgo linux pkg-config: x11 xtst xrandr wayland-client xkbcommon cairo xrender xfixes xext fontconfig
+#cgo linux LDFLAGS: -lm -lpthread
 */
 import "C"
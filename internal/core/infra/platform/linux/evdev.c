@@ -11,17 +11,6 @@
 
 int neru_evdev_grab(int fd, int grab) { return ioctl(fd, EVIOCGRAB, grab); }
 
-int neru_evdev_key_down(int fd, unsigned int keycode) {
-	unsigned long key_bits[(KEY_MAX + 8 * sizeof(unsigned long)) / (8 * sizeof(unsigned long))];
-	memset(key_bits, 0, sizeof(key_bits));
-
-	if (ioctl(fd, EVIOCGKEY(sizeof(key_bits)), key_bits) < 0) {
-		return 0;
-	}
-
-	return (key_bits[keycode / (8 * sizeof(unsigned long))] >> (keycode % (8 * sizeof(unsigned long)))) & 1UL;
-}
-
 int neru_evdev_is_keyboard(int fd) {
 	unsigned long key_bits[(KEY_MAX + 8 * sizeof(unsigned long)) / (8 * sizeof(unsigned long))];
 	memset(key_bits, 0, sizeof(key_bits));
@@ -60,7 +49,7 @@ ssize_t neru_evdev_read_event(int fd, struct input_event *event) {
 	return n;
 }
 
-int neru_evdev_get_pressed_keys(int fd, unsigned int *out_keys, int max_keys) {
+int neru_evdev_get_key_words(int fd, uint64_t *words) {
 	unsigned long key_bits[(KEY_MAX + 8 * sizeof(unsigned long)) / (8 * sizeof(unsigned long))];
 	memset(key_bits, 0, sizeof(key_bits));
 
@@ -68,18 +57,15 @@ int neru_evdev_get_pressed_keys(int fd, unsigned int *out_keys, int max_keys) {
 		return -1;
 	}
 
-	int count = 0;
-	for (unsigned int i = 0; i < KEY_MAX; i++) {
-		int idx = i / (8 * (int)sizeof(unsigned long));
-		int bit = i % (8 * (int)sizeof(unsigned long));
-		if ((key_bits[idx] >> bit) & 1UL) {
-			if (count < max_keys) {
-				out_keys[count] = i;
-			}
-			count++;
-		}
+	// Repack the kernel's array of longs so bit n of the result is keycode n
+	// whatever the width of long.
+	memset(words, 0, NERU_EVDEV_KEY_WORDS * sizeof(uint64_t));
+	for (size_t i = 0; i < sizeof(key_bits) / sizeof(key_bits[0]); i++) {
+		size_t bit = i * 8 * sizeof(unsigned long);
+		if (bit / 64 < NERU_EVDEV_KEY_WORDS)
+			words[bit / 64] |= (uint64_t)key_bits[i] << (bit % 64);
 	}
-	return count;
+	return 0;
 }
 
 int neru_uinput_create_scroll(int *out_fd) {
@@ -155,40 +141,60 @@ int neru_uinput_scroll(int fd, int axis, int value) {
 	return (w1 == sizeof(ev) && w2 == sizeof(ev) && w3 == sizeof(ev)) ? 1 : 0;
 }
 
-int neru_uinput_scroll_batch(int fd, int axis, int *values, int count) {
-	if (fd < 0 || !values || count <= 0)
-		return 0;
-
-	size_t event_size = sizeof(struct input_event);
-	size_t total = (size_t)count * 3 * event_size;
-	struct input_event *events = (struct input_event *)malloc(total);
-	if (!events)
-		return 0;
-
-	int rel_code = (axis == 0) ? REL_WHEEL : REL_HWHEEL;
-	int rel_hi_code = (axis == 0) ? REL_WHEEL_HI_RES : REL_HWHEEL_HI_RES;
-
-	for (int i = 0; i < count; i++) {
-		int base = i * 3;
-		int v = values[i];
+struct NeruUinputScroller {
+	int fd;
+	// Hi-res units not yet reported as a whole notch, per axis.
+	int notch_rem[2];
+	NeruScrollGlide *glide;
+};
+
+static void neru_uinput_scroller_emit(void *ctx, int axis, int value120, int last) {
+	(void)last;
+	NeruUinputScroller *s = ctx;
+	struct input_event events[3];
+	int n = 0;
+	memset(events, 0, sizeof(events));
+
+	events[n].type = EV_REL;
+	events[n].code = (axis == 0) ? REL_WHEEL_HI_RES : REL_HWHEEL_HI_RES;
+	events[n].value = value120;
+	n++;
+
+	s->notch_rem[axis] += value120;
+	int notches = s->notch_rem[axis] / NERU_SCROLL_VALUE120_PER_NOTCH;
+	if (notches != 0) {
+		s->notch_rem[axis] -= notches * NERU_SCROLL_VALUE120_PER_NOTCH;
+		events[n].type = EV_REL;
+		events[n].code = (axis == 0) ? REL_WHEEL : REL_HWHEEL;
+		events[n].value = notches;
+		n++;
+	}
 
-		memset(&events[base], 0, event_size);
-		events[base].type = EV_REL;
-		events[base].code = rel_hi_code;
-		events[base].value = v * 120;
+	events[n].type = EV_SYN;
+	events[n].code = SYN_REPORT;
+	n++;
 
-		memset(&events[base + 1], 0, event_size);
-		events[base + 1].type = EV_REL;
-		events[base + 1].code = rel_code;
-		events[base + 1].value = v;
+	// Nothing to report a short write to from the glide thread; the next
+	// step is written regardless.
+	ssize_t written = write(s->fd, events, (size_t)n * sizeof(events[0]));
+	(void)written;
+}
 
-		memset(&events[base + 2], 0, event_size);
-		events[base + 2].type = EV_SYN;
-		events[base + 2].code = SYN_REPORT;
-		events[base + 2].value = 0;
+NeruUinputScroller *neru_uinput_scroller_new(int fd) {
+	NeruUinputScroller *s = calloc(1, sizeof(*s));
+	if (!s)
+		return NULL;
+	s->fd = fd;
+	s->glide = neru_scroll_glide_new(neru_uinput_scroller_emit, s);
+	if (!s->glide) {
+		free(s);
+		return NULL;
 	}
+	return s;
+}
 
-	ssize_t written = write(fd, events, total);
-	free(events);
-	return (written == (ssize_t)total) ? 1 : 0;
+int neru_uinput_scroll_by(NeruUinputScroller *s, int dx120, int dy120, int duration_ms, int refresh_mhz) {
+	if (!s)
+		return 0;
+	return neru_scroll_glide_by(s->glide, dx120, dy120, duration_ms, refresh_mhz);
 }
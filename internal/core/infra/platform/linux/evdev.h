@@ -1,19 +1,34 @@
 #ifndef EVDEV_H
 #define EVDEV_H
 
+#include "scroll_glide.h"
+
 #include <linux/input.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <sys/types.h>
 
+// 64-bit words holding one bit per keycode (KEY_CNT bits).
+#define NERU_EVDEV_KEY_WORDS (KEY_CNT / 64)
+
 int neru_evdev_grab(int fd, int grab);
-int neru_evdev_key_down(int fd, unsigned int keycode);
 int neru_evdev_is_keyboard(int fd);
 int neru_evdev_get_name(int fd, char *name, size_t name_size);
 int neru_evdev_get_bustype(int fd);
 ssize_t neru_evdev_read_event(int fd, struct input_event *event);
-int neru_evdev_get_pressed_keys(int fd, unsigned int *out_keys, int max_keys);
+// Fills words with the keys the device reports held (EVIOCGKEY). Returns 0 on
+// success, -1 on error.
+int neru_evdev_get_key_words(int fd, uint64_t *words);
 int neru_uinput_create_scroll(int *out_fd);
 int neru_uinput_scroll(int fd, int axis, int value);
-int neru_uinput_scroll_batch(int fd, int axis, int *values, int count);
+
+// Scrolls the uinput device at fd in value120 units through a scroll glide.
+// REL_*_HI_RES carries every step as is; REL_WHEEL/REL_HWHEEL notches are
+// sent as the hi-res total crosses each multiple of 120, like a hi-res wheel.
+typedef struct NeruUinputScroller NeruUinputScroller;
+
+NeruUinputScroller *neru_uinput_scroller_new(int fd);
+// See neru_scroll_glide_by. axis 0 is positive up, axis 1 positive right.
+int neru_uinput_scroll_by(NeruUinputScroller *s, int dx120, int dy120, int duration_ms, int refresh_mhz);
 
 #endif /* EVDEV_H */
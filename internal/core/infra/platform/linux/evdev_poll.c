@@ -0,0 +1,343 @@
+#include "evdev_poll.h"
+
+#include <errno.h>
+#include <linux/input.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Per-device read buffer. Events after the last SYN_REPORT of a read are
+// carried over so Go only ever sees whole frames.
+typedef struct NeruEvdevDevice {
+	int fd;
+	int pending;
+	// Set once the device left the set; the reading thread may still hold a
+	// pointer to it from its last epoll_wait, so it is freed on the next one.
+	int removed;
+	struct NeruEvdevDevice *next_retired;
+	struct input_event buf[NERU_EVDEV_POLL_BATCH];
+} NeruEvdevDevice;
+
+struct NeruEvdevPoller {
+	int epoll_fd;
+	int wake_fd;
+	int inotify_fd;  // -1 until neru_evdev_poller_watch
+	int timer_fd;
+	atomic_int stopped;
+
+	// Guards devices and retired; the reading thread holds it while reading
+	// a device so the caller cannot close that fd underneath it.
+	pthread_mutex_t mutex;
+	NeruEvdevDevice *devices[NERU_EVDEV_POLL_MAX_DEVICES];
+	int ndevices;
+	NeruEvdevDevice *retired;
+};
+
+// Tags for the non-device entries of the epoll set; device entries point at
+// their NeruEvdevDevice.
+static char neru_evdev_wake_tag, neru_evdev_inotify_tag, neru_evdev_timer_tag;
+
+static int neru_evdev_poller_add_tagged(NeruEvdevPoller *poller, int fd, void *tag) {
+	struct epoll_event ev = {.events = EPOLLIN, .data.ptr = tag};
+	return epoll_ctl(poller->epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+}
+
+static void neru_evdev_poller_free_retired(NeruEvdevPoller *poller) {
+	while (poller->retired != NULL) {
+		NeruEvdevDevice *next = poller->retired->next_retired;
+		free(poller->retired);
+		poller->retired = next;
+	}
+}
+
+NeruEvdevPoller *neru_evdev_poller_new(void) {
+	NeruEvdevPoller *poller = calloc(1, sizeof(*poller));
+	if (poller == NULL)
+		return NULL;
+
+	poller->inotify_fd = -1;
+	poller->timer_fd = -1;
+	poller->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	poller->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (poller->epoll_fd < 0 || poller->wake_fd < 0)
+		goto fail;
+
+	if (neru_evdev_poller_add_tagged(poller, poller->wake_fd, &neru_evdev_wake_tag) < 0)
+		goto fail;
+
+	pthread_mutex_init(&poller->mutex, NULL);
+	return poller;
+
+fail:
+	if (poller->epoll_fd >= 0)
+		close(poller->epoll_fd);
+	if (poller->wake_fd >= 0)
+		close(poller->wake_fd);
+	free(poller);
+	return NULL;
+}
+
+void neru_evdev_poller_free(NeruEvdevPoller *poller) {
+	if (poller == NULL)
+		return;
+
+	for (int i = 0; i < poller->ndevices; i++)
+		free(poller->devices[i]);
+	neru_evdev_poller_free_retired(poller);
+	if (poller->inotify_fd >= 0)
+		close(poller->inotify_fd);
+	if (poller->timer_fd >= 0)
+		close(poller->timer_fd);
+	close(poller->epoll_fd);
+	close(poller->wake_fd);
+	pthread_mutex_destroy(&poller->mutex);
+	free(poller);
+}
+
+int neru_evdev_poller_add(NeruEvdevPoller *poller, int fd) {
+	NeruEvdevDevice *device = calloc(1, sizeof(*device));
+	if (device == NULL)
+		return -1;
+	device->fd = fd;
+
+	pthread_mutex_lock(&poller->mutex);
+	if (poller->ndevices == NERU_EVDEV_POLL_MAX_DEVICES) {
+		pthread_mutex_unlock(&poller->mutex);
+		free(device);
+		return -1;
+	}
+
+	struct epoll_event ev = {.events = EPOLLIN, .data.ptr = device};
+	if (epoll_ctl(poller->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+		pthread_mutex_unlock(&poller->mutex);
+		free(device);
+		return -1;
+	}
+	poller->devices[poller->ndevices++] = device;
+	pthread_mutex_unlock(&poller->mutex);
+	return 0;
+}
+
+// Takes devices[index] out of the set. Caller holds the mutex.
+static void neru_evdev_poller_retire_locked(NeruEvdevPoller *poller, int index) {
+	NeruEvdevDevice *device = poller->devices[index];
+	epoll_ctl(poller->epoll_fd, EPOLL_CTL_DEL, device->fd, NULL);
+	poller->devices[index] = poller->devices[--poller->ndevices];
+	device->removed = 1;
+	device->next_retired = poller->retired;
+	poller->retired = device;
+}
+
+int neru_evdev_poller_remove_fd(NeruEvdevPoller *poller, int fd) {
+	int found = -1;
+	pthread_mutex_lock(&poller->mutex);
+	for (int i = 0; i < poller->ndevices; i++) {
+		if (poller->devices[i]->fd == fd) {
+			neru_evdev_poller_retire_locked(poller, i);
+			found = 0;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&poller->mutex);
+	return found;
+}
+
+int neru_evdev_poller_watch(NeruEvdevPoller *poller, const char *dir) {
+	if (poller->inotify_fd >= 0)
+		return 0;
+
+	int inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (inotify_fd < 0 || timer_fd < 0)
+		goto fail;
+
+	// IN_ATTRIB catches udev granting access after the node was created.
+	if (inotify_add_watch(inotify_fd, dir, IN_CREATE | IN_ATTRIB) < 0)
+		goto fail;
+	if (neru_evdev_poller_add_tagged(poller, inotify_fd, &neru_evdev_inotify_tag) < 0)
+		goto fail;
+	if (neru_evdev_poller_add_tagged(poller, timer_fd, &neru_evdev_timer_tag) < 0) {
+		epoll_ctl(poller->epoll_fd, EPOLL_CTL_DEL, inotify_fd, NULL);
+		goto fail;
+	}
+
+	poller->inotify_fd = inotify_fd;
+	poller->timer_fd = timer_fd;
+	return 0;
+
+fail:
+	if (inotify_fd >= 0)
+		close(inotify_fd);
+	if (timer_fd >= 0)
+		close(timer_fd);
+	return -1;
+}
+
+void neru_evdev_poller_arm_timer(NeruEvdevPoller *poller, int delay_ms) {
+	if (poller->timer_fd < 0)
+		return;
+
+	struct itimerspec spec;
+	memset(&spec, 0, sizeof(spec));
+	if (delay_ms > 0) {
+		spec.it_value.tv_sec = delay_ms / 1000;
+		spec.it_value.tv_nsec = (long)(delay_ms % 1000) * 1000000L;
+	}
+	timerfd_settime(poller->timer_fd, 0, &spec, NULL);
+}
+
+// Collects "eventN" names from queued inotify events, flagging a rescan when
+// they do not fit or the kernel queue overflowed.
+static void neru_evdev_poller_read_inotify(NeruEvdevPoller *poller, NeruEvdevPollResult *result) {
+	char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+	for (;;) {
+		ssize_t n = read(poller->inotify_fd, buf, sizeof(buf));
+		if (n <= 0)
+			return;
+
+		for (char *p = buf; p < buf + n; p += sizeof(struct inotify_event) + ((struct inotify_event *)p)->len) {
+			const struct inotify_event *ev = (const struct inotify_event *)p;
+			if (ev->mask & IN_Q_OVERFLOW) {
+				result->rescan = 1;
+				continue;
+			}
+			if (ev->len == 0 || strncmp(ev->name, "event", 5) != 0 || strlen(ev->name) >= NERU_EVDEV_POLL_NAME_MAX)
+				continue;
+
+			int seen = 0;
+			for (int i = 0; i < result->nhotplug && !seen; i++)
+				seen = strcmp(result->hotplug[i], ev->name) == 0;
+			if (seen)
+				continue;
+			if (result->nhotplug == NERU_EVDEV_POLL_MAX_HOTPLUG) {
+				result->rescan = 1;
+				continue;
+			}
+			strcpy(result->hotplug[result->nhotplug++], ev->name);
+		}
+	}
+}
+
+void neru_evdev_poller_stop(NeruEvdevPoller *poller) {
+	atomic_store(&poller->stopped, 1);
+	uint64_t one = 1;
+	ssize_t written = write(poller->wake_fd, &one, sizeof(one));
+	(void)written;
+}
+
+// Reads what the device has queued (up to the space left after any carried
+// over events) and moves every complete frame into out. Returns the number
+// of events copied, or -1 when the device is gone.
+static int neru_evdev_device_read(NeruEvdevDevice *device, NeruEvdevEvent *out) {
+	size_t room = (size_t)(NERU_EVDEV_POLL_BATCH - device->pending) * sizeof(struct input_event);
+	ssize_t n;
+	do {
+		n = read(device->fd, &device->buf[device->pending], room);
+	} while (n < 0 && errno == EINTR);
+
+	if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		return 0;
+	if (n <= 0)
+		return -1;
+
+	int total = device->pending + (int)(n / (ssize_t)sizeof(struct input_event));
+	int end = 0;
+	for (int i = total - 1; i >= 0; i--) {
+		if (device->buf[i].type == EV_SYN && device->buf[i].code == SYN_REPORT) {
+			end = i + 1;
+			break;
+		}
+	}
+	// A frame larger than the whole buffer is passed on in pieces.
+	if (end == 0 && total == NERU_EVDEV_POLL_BATCH)
+		end = total;
+
+	for (int i = 0; i < end; i++) {
+		out[i].type = device->buf[i].type;
+		out[i].code = device->buf[i].code;
+		out[i].value = device->buf[i].value;
+		out[i].device = device->fd;
+	}
+	device->pending = total - end;
+	memmove(device->buf, &device->buf[end], (size_t)device->pending * sizeof(struct input_event));
+	return end;
+}
+
+int neru_evdev_poller_read(
+    NeruEvdevPoller *poller, NeruEvdevEvent *events, int max_events, NeruEvdevPollResult *result) {
+	result->ndead = 0;
+	result->nhotplug = 0;
+	result->rescan = 0;
+	result->timer_expired = 0;
+	if (max_events < NERU_EVDEV_POLL_BATCH)
+		return -1;
+
+	for (;;) {
+		if (atomic_load(&poller->stopped))
+			return -1;
+
+		// Nothing from the previous epoll_wait is referenced any more.
+		pthread_mutex_lock(&poller->mutex);
+		neru_evdev_poller_free_retired(poller);
+		pthread_mutex_unlock(&poller->mutex);
+
+		struct epoll_event ready[NERU_EVDEV_POLL_MAX_DEVICES];
+		int nready = epoll_wait(poller->epoll_fd, ready, NERU_EVDEV_POLL_MAX_DEVICES, -1);
+		if (nready < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+
+		int count = 0;
+		for (int i = 0; i < nready; i++) {
+			void *tag = ready[i].data.ptr;
+			uint64_t value;
+			if (tag == &neru_evdev_wake_tag) {
+				while (read(poller->wake_fd, &value, sizeof(value)) > 0) {
+				}
+				continue;
+			}
+			if (tag == &neru_evdev_inotify_tag) {
+				neru_evdev_poller_read_inotify(poller, result);
+				continue;
+			}
+			if (tag == &neru_evdev_timer_tag) {
+				if (read(poller->timer_fd, &value, sizeof(value)) > 0)
+					result->timer_expired = 1;
+				continue;
+			}
+
+			// Devices left unread stay ready and are picked up next call.
+			NeruEvdevDevice *device = tag;
+			if (max_events - count < NERU_EVDEV_POLL_BATCH)
+				continue;
+
+			pthread_mutex_lock(&poller->mutex);
+			int n = device->removed ? 0 : neru_evdev_device_read(device, &events[count]);
+			if (n >= 0) {
+				pthread_mutex_unlock(&poller->mutex);
+				count += n;
+				continue;
+			}
+			result->dead_fds[result->ndead++] = device->fd;
+			for (int j = 0; j < poller->ndevices; j++) {
+				if (poller->devices[j] == device) {
+					neru_evdev_poller_retire_locked(poller, j);
+					break;
+				}
+			}
+			pthread_mutex_unlock(&poller->mutex);
+		}
+
+		if (count > 0 || result->ndead > 0 || result->nhotplug > 0 || result->rescan || result->timer_expired)
+			return count;
+	}
+}
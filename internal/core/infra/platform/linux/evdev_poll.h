@@ -0,0 +1,67 @@
+#ifndef EVDEV_POLL_H
+#define EVDEV_POLL_H
+
+#include <stdint.h>
+
+// Events read from a device per read() call.
+#define NERU_EVDEV_POLL_BATCH 64
+#define NERU_EVDEV_POLL_MAX_DEVICES 64
+#define NERU_EVDEV_POLL_MAX_HOTPLUG 16
+#define NERU_EVDEV_POLL_NAME_MAX 32
+
+// An input_event without its timestamp, packed for the trip to Go, tagged
+// with the fd of the device it was read from.
+typedef struct {
+	uint16_t type;
+	uint16_t code;
+	int32_t value;
+	int32_t device;
+} NeruEvdevEvent;
+
+// Everything besides input events that one neru_evdev_poller_read call saw.
+typedef struct {
+	// Devices that failed; already removed from the set.
+	int dead_fds[NERU_EVDEV_POLL_MAX_DEVICES];
+	int ndead;
+	// "eventN" nodes created or whose attributes (permissions) changed in
+	// the watched directory.
+	char hotplug[NERU_EVDEV_POLL_MAX_HOTPLUG][NERU_EVDEV_POLL_NAME_MAX];
+	int nhotplug;
+	// More nodes changed than fit in hotplug; rescan the directory.
+	int rescan;
+	// The one-shot timer set by neru_evdev_poller_arm_timer fired.
+	int timer_expired;
+} NeruEvdevPollResult;
+
+// Waits on every registered device fd with one epoll set and reads events
+// in bulk, so a single thread serves all keyboards. Device fds stay owned by
+// the caller.
+typedef struct NeruEvdevPoller NeruEvdevPoller;
+
+NeruEvdevPoller *neru_evdev_poller_new(void);
+// Must only be called once the reading thread has returned from
+// neru_evdev_poller_read for good.
+void neru_evdev_poller_free(NeruEvdevPoller *poller);
+// Safe to call while another thread is blocked in neru_evdev_poller_read.
+// Returns 0 on success, -1 on failure.
+int neru_evdev_poller_add(NeruEvdevPoller *poller, int fd);
+// Drops fd from the set without closing it; call it before closing a device
+// fd that was added. Safe to call while another thread is blocked in
+// neru_evdev_poller_read. Returns 0 on success, -1 when fd was not in the set.
+int neru_evdev_poller_remove_fd(NeruEvdevPoller *poller, int fd);
+// Adds an inotify watch on dir (for hotplugged "eventN" nodes) and a timerfd
+// to the set. Returns 0 on success, -1 on failure.
+int neru_evdev_poller_watch(NeruEvdevPoller *poller, const char *dir);
+// Arms the one-shot timer to fire after delay_ms, or disarms it when
+// delay_ms <= 0. Requires neru_evdev_poller_watch.
+void neru_evdev_poller_arm_timer(NeruEvdevPoller *poller, int delay_ms);
+// Makes the current and every later neru_evdev_poller_read return -1.
+void neru_evdev_poller_stop(NeruEvdevPoller *poller);
+// Blocks until at least one complete SYN_REPORT frame has been read or
+// something in result happened, then copies whole frames into events
+// (max_events must be at least NERU_EVDEV_POLL_BATCH). Returns the number of
+// events, or -1 once stopped or on error.
+int neru_evdev_poller_read(
+    NeruEvdevPoller *poller, NeruEvdevEvent *events, int max_events, NeruEvdevPollResult *result);
+
+#endif /* EVDEV_POLL_H */
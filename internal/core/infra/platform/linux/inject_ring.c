@@ -0,0 +1,256 @@
+#include "inject_ring.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// Each slot carries a sequence number (Vyukov's bounded queue): seq == pos
+// means the slot is free for the producer claiming position pos, seq == pos + 1
+// means the command at pos is published and the writer may take it.
+typedef struct {
+	_Atomic uint64_t seq;
+	NeruInjectCmd cmd;
+} NeruInjectSlot;
+
+struct NeruInjectRing {
+	// Producers race on tail with CAS; head is only advanced by the writer and
+	// is atomic so producers and stats can read it. Kept on separate cache
+	// lines so injecting threads do not bounce the writer's line.
+	_Alignas(64) _Atomic uint64_t tail;
+	_Alignas(64) _Atomic uint64_t head;
+
+	_Alignas(64) _Atomic uint64_t dropped;
+	_Atomic uint64_t high_water;
+	_Atomic int closed;
+
+	uint64_t mask;
+	NeruInjectSlot *slots;
+	int wake;  // non-blocking eventfd
+};
+
+NeruInjectRing *neru_inject_ring_new(int capacity) {
+	uint64_t size = 1;
+	while (size < (uint64_t)capacity)
+		size <<= 1;
+
+	NeruInjectRing *ring = calloc(1, sizeof(*ring));
+	if (ring == NULL)
+		return NULL;
+	ring->slots = calloc(size, sizeof(*ring->slots));
+	if (ring->slots == NULL) {
+		free(ring);
+		return NULL;
+	}
+	ring->wake = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (ring->wake < 0) {
+		free(ring->slots);
+		free(ring);
+		return NULL;
+	}
+	ring->mask = size - 1;
+	for (uint64_t i = 0; i < size; i++)
+		atomic_init(&ring->slots[i].seq, i);
+	return ring;
+}
+
+void neru_inject_ring_free(NeruInjectRing *ring) {
+	if (ring == NULL)
+		return;
+	close(ring->wake);
+	free(ring->slots);
+	free(ring);
+}
+
+static void neru_inject_ring_signal(NeruInjectRing *ring) {
+	uint64_t one = 1;
+	ssize_t written = write(ring->wake, &one, sizeof(one));
+	(void)written;  // only fails when the counter is already huge, i.e. signalled
+}
+
+// Resets the eventfd counter, consuming every wakeup posted so far.
+static void neru_inject_ring_clear(NeruInjectRing *ring) {
+	uint64_t pending;
+	ssize_t got = read(ring->wake, &pending, sizeof(pending));
+	(void)got;  // EAGAIN when nothing was signalled
+}
+
+static void neru_inject_ring_note_depth(NeruInjectRing *ring, uint64_t depth) {
+	uint64_t seen = atomic_load_explicit(&ring->high_water, memory_order_relaxed);
+	while (depth > seen &&
+	       !atomic_compare_exchange_weak_explicit(
+	           &ring->high_water, &seen, depth, memory_order_relaxed, memory_order_relaxed)) {
+	}
+}
+
+int neru_inject_ring_push(NeruInjectRing *ring, const NeruInjectCmd *cmd) {
+	if (ring == NULL || atomic_load_explicit(&ring->closed, memory_order_acquire))
+		return 0;
+
+	NeruInjectSlot *slot;
+	uint64_t pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	for (;;) {
+		slot = &ring->slots[pos & ring->mask];
+		uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+		int64_t diff = (int64_t)(seq - pos);
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(
+			        &ring->tail, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			// The writer has not freed this slot yet: the ring is full.
+			atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+			return 0;
+		} else {
+			pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+		}
+	}
+
+	slot->cmd = *cmd;
+	atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+
+	// The writer may already have taken this command and more, or have moved
+	// on since head was read, which can overstate the depth past capacity.
+	uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	if (pos + 1 > head) {
+		uint64_t depth = pos + 1 - head;
+		neru_inject_ring_note_depth(ring, depth > ring->mask + 1 ? ring->mask + 1 : depth);
+	}
+	neru_inject_ring_signal(ring);
+	return 1;
+}
+
+static int neru_inject_ring_pop(NeruInjectRing *ring, NeruInjectCmd *out, int max) {
+	uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	int n = 0;
+	while (n < max) {
+		NeruInjectSlot *slot = &ring->slots[head & ring->mask];
+		if (atomic_load_explicit(&slot->seq, memory_order_acquire) != head + 1)
+			break;
+		out[n++] = slot->cmd;
+		atomic_store_explicit(&slot->seq, head + ring->mask + 1, memory_order_release);
+		head++;
+	}
+	atomic_store_explicit(&ring->head, head, memory_order_release);
+	return n;
+}
+
+int neru_inject_ring_wait(NeruInjectRing *ring, NeruInjectCmd *out, int max) {
+	for (;;) {
+		int n = neru_inject_ring_pop(ring, out, max);
+		if (n > 0)
+			return n;
+		if (atomic_load_explicit(&ring->closed, memory_order_acquire))
+			return neru_inject_ring_pop(ring, out, max);
+
+		// A push after the pop above leaves the eventfd readable, so clearing
+		// it here cannot lose that wakeup; the next pop finds the command.
+		struct pollfd pfd = {.fd = ring->wake, .events = POLLIN};
+		while (poll(&pfd, 1, -1) < 0 && errno == EINTR) {
+		}
+		neru_inject_ring_clear(ring);
+	}
+}
+
+int neru_inject_ring_wake_fd(NeruInjectRing *ring) { return ring->wake; }
+
+int neru_inject_ring_drain(NeruInjectRing *ring, NeruInjectCmd *out, int max) {
+	neru_inject_ring_clear(ring);
+	// closed is read before popping so commands pushed before close are
+	// always delivered before -1.
+	int closed = atomic_load_explicit(&ring->closed, memory_order_acquire);
+	// Once closed the fd stays readable, so a writer that stops after a short
+	// batch is woken again to collect the -1 instead of sleeping forever.
+	if (closed)
+		neru_inject_ring_signal(ring);
+	int n = neru_inject_ring_pop(ring, out, max);
+	if (n == 0 && closed)
+		return -1;
+	return n;
+}
+
+void neru_inject_ring_close(NeruInjectRing *ring) {
+	if (ring == NULL)
+		return;
+	atomic_store_explicit(&ring->closed, 1, memory_order_release);
+	neru_inject_ring_signal(ring);
+}
+
+#define NERU_INJECT_BTN_LEFT 0x110
+
+// 0 for codes outside BTN_MOUSE, which always get a frame of their own.
+static uint32_t neru_inject_button_bit(int button) {
+	if (button < NERU_INJECT_BTN_LEFT || button >= NERU_INJECT_BTN_LEFT + 32)
+		return 0;
+	return 1u << (button - NERU_INJECT_BTN_LEFT);
+}
+
+int neru_inject_frame_breaks(const NeruInjectFrame *frame, const NeruInjectCmd *cmd) {
+	if (!frame->open)
+		return 0;
+
+	switch (cmd->kind) {
+	case NERU_INJECT_BUTTON: {
+		uint32_t bit = neru_inject_button_bit(cmd->a);
+		uint32_t seen = cmd->b ? frame->pressed | frame->released : frame->released;
+		return bit == 0 || (seen & bit) != 0;
+	}
+	case NERU_INJECT_AXIS:
+	case NERU_INJECT_AXIS_CONTINUOUS:
+	case NERU_INJECT_AXIS_VALUE120: {
+		uint32_t bit = 1u << (cmd->a & 1);
+		return (frame->axes & bit) != 0 || (frame->axes != 0 && frame->axis_kind != cmd->kind);
+	}
+	default:
+		return 1;
+	}
+}
+
+void neru_inject_frame_add(NeruInjectFrame *frame, const NeruInjectCmd *cmd) {
+	switch (cmd->kind) {
+	case NERU_INJECT_BUTTON:
+		if (cmd->b)
+			frame->pressed |= neru_inject_button_bit(cmd->a);
+		else
+			frame->released |= neru_inject_button_bit(cmd->a);
+		break;
+	case NERU_INJECT_AXIS:
+	case NERU_INJECT_AXIS_CONTINUOUS:
+	case NERU_INJECT_AXIS_VALUE120:
+		frame->axes |= 1u << (cmd->a & 1);
+		frame->axis_kind = cmd->kind;
+		break;
+	default:
+		break;
+	}
+	frame->open = 1;
+}
+
+int neru_inject_coalesce_motion(const NeruInjectCmd *cmds, int n, int i, NeruInjectCmd *out) {
+	*out = cmds[i];
+	while (i + 1 < n && cmds[i + 1].kind == out->kind) {
+		i++;
+		if (out->kind == NERU_INJECT_MOTION_REL) {
+			out->a += cmds[i].a;
+			out->b += cmds[i].b;
+		} else {
+			out->a = cmds[i].a;
+			out->b = cmds[i].b;
+		}
+	}
+	return i;
+}
+
+void neru_inject_ring_stats(NeruInjectRing *ring, NeruInjectRingStats *out) {
+	// head is loaded first so consumed never exceeds produced.
+	uint64_t consumed = atomic_load_explicit(&ring->head, memory_order_acquire);
+	uint64_t dropped = atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+
+	out->capacity = ring->mask + 1;
+	out->produced = atomic_load_explicit(&ring->tail, memory_order_relaxed) + dropped;
+	out->consumed = consumed;
+	out->dropped = dropped;
+	out->high_water = atomic_load_explicit(&ring->high_water, memory_order_relaxed);
+}
@@ -0,0 +1,92 @@
+#ifndef INJECT_RING_H
+#define INJECT_RING_H
+
+#include <stdint.h>
+
+// One queued input request. Fields are interpreted per kind:
+//   MOTION_ABS / MOTION_REL: a = x / dx, b = y / dy
+//   BUTTON:    a = evdev button code, b = pressed
+//   AXIS:      a = axis, b = delta, c = discrete steps (0 for smooth)
+//   AXIS_CONTINUOUS: a = axis, b = delta as wl_fixed_t (sub-pixel),
+//                    c = last delta of the scroll on that axis
+//   AXIS_VALUE120:   a = axis, b = delta in value120 units
+//   KEY:       a = evdev keycode, b = pressed, time = timestamp in ms
+//   MODIFIER:  a = modifier mask, b = is_down
+typedef enum {
+	NERU_INJECT_MOTION_ABS,
+	NERU_INJECT_MOTION_REL,
+	NERU_INJECT_BUTTON,
+	NERU_INJECT_AXIS,
+	NERU_INJECT_AXIS_CONTINUOUS,
+	NERU_INJECT_AXIS_VALUE120,
+	NERU_INJECT_KEY,
+	NERU_INJECT_MODIFIER,
+} NeruInjectKind;
+
+typedef struct {
+	NeruInjectKind kind;
+	int a, b, c;
+	uint32_t time;
+	int64_t submit_ns;  // CLOCK_MONOTONIC, set by producers whose writer reports latency
+} NeruInjectCmd;
+
+typedef struct {
+	uint64_t capacity;
+	uint64_t produced;  // every push, including dropped ones
+	uint64_t consumed;
+	uint64_t dropped;
+	uint64_t high_water;
+} NeruInjectRingStats;
+
+// Bounded lock-free queue from any number of injecting threads to a single
+// writer thread. Pushes never block or take a lock; when the ring is full the
+// command is dropped and counted. The writer sleeps on an eventfd that
+// producers signal after publishing, either in neru_inject_ring_wait or in its
+// own poll loop through neru_inject_ring_wake_fd.
+typedef struct NeruInjectRing NeruInjectRing;
+
+// Capacity is rounded up to a power of two.
+NeruInjectRing *neru_inject_ring_new(int capacity);
+// The writer must have returned from its last neru_inject_ring_wait.
+void neru_inject_ring_free(NeruInjectRing *ring);
+// Returns 1 when cmd was queued, 0 when the ring was full or closed.
+int neru_inject_ring_push(NeruInjectRing *ring, const NeruInjectCmd *cmd);
+// Blocks until commands are queued, then moves up to max of them into out
+// in push order. Returns 0 once the ring is closed and drained. Only the
+// writer thread may call it.
+int neru_inject_ring_wait(NeruInjectRing *ring, NeruInjectCmd *out, int max);
+// Readable while commands may be queued and from the moment the ring is
+// closed on, for a writer that polls it alongside other fds.
+int neru_inject_ring_wake_fd(NeruInjectRing *ring);
+// Non-blocking counterpart of neru_inject_ring_wait for such a writer: clears
+// the wakeup, then moves up to max commands into out. Call it again while it
+// returns max. Returns -1 once the ring is closed and drained.
+int neru_inject_ring_drain(NeruInjectRing *ring, NeruInjectCmd *out, int max);
+// Rejects further pushes and wakes the writer so it can drain and exit.
+void neru_inject_ring_close(NeruInjectRing *ring);
+void neru_inject_ring_stats(NeruInjectRing *ring, NeruInjectRingStats *out);
+
+// The pointer frame a writer is assembling. Buttons and axes accumulate into
+// one frame; anything that would make the frame ambiguous closes it first:
+// motion (always its own frame), a second event on the same axis or from
+// another axis source, a button pressed again or released twice, a button
+// outside BTN_MOUSE, or a keyboard event, which keeps the order between the
+// pointer and keyboard devices.
+typedef struct {
+	int open;
+	uint32_t axes;
+	NeruInjectKind axis_kind;  // of the axes in this frame
+	uint32_t pressed;
+	uint32_t released;
+} NeruInjectFrame;
+
+// Returns 1 when the open frame must be closed before cmd is sent.
+int neru_inject_frame_breaks(const NeruInjectFrame *frame, const NeruInjectCmd *cmd);
+// Records cmd, once sent, as part of the frame.
+void neru_inject_frame_add(NeruInjectFrame *frame, const NeruInjectCmd *cmd);
+// Collapses the run of motions of cmds[i]'s kind starting at i into out: the
+// last absolute position, or the sum of the relative deltas. Returns the index
+// of the last command taken.
+int neru_inject_coalesce_motion(const NeruInjectCmd *cmds, int n, int i, NeruInjectCmd *out);
+
+#endif /* INJECT_RING_H */
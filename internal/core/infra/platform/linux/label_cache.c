@@ -0,0 +1,241 @@
+#include "label_cache.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Transparent margin around the ink box so antialiased edges are kept.
+#define NERU_LABEL_PAD 2
+
+static uint32_t neru_label_hash(
+    const char *text, const char *font_family, double font_size, unsigned int color, double scale) {
+	uint32_t h = 2166136261u;
+	for (const unsigned char *p = (const unsigned char *)text; *p; p++)
+		h = (h ^ *p) * 16777619u;
+	h = (h ^ 0xFF) * 16777619u;
+	for (const unsigned char *p = (const unsigned char *)font_family; *p; p++)
+		h = (h ^ *p) * 16777619u;
+	h = (h ^ color) * 16777619u;
+	h = (h ^ (uint32_t)(font_size * 64.0)) * 16777619u;
+	h = (h ^ (uint32_t)(scale * 64.0)) * 16777619u;
+	return h;
+}
+
+static void neru_label_lru_unlink(NeruLabelCache *cache, NeruLabelEntry *e) {
+	if (e->lru_prev)
+		e->lru_prev->lru_next = e->lru_next;
+	else
+		cache->lru_head = e->lru_next;
+	if (e->lru_next)
+		e->lru_next->lru_prev = e->lru_prev;
+	else
+		cache->lru_tail = e->lru_prev;
+	e->lru_prev = NULL;
+	e->lru_next = NULL;
+}
+
+static void neru_label_lru_push_front(NeruLabelCache *cache, NeruLabelEntry *e) {
+	e->lru_prev = NULL;
+	e->lru_next = cache->lru_head;
+	if (cache->lru_head)
+		cache->lru_head->lru_prev = e;
+	cache->lru_head = e;
+	if (!cache->lru_tail)
+		cache->lru_tail = e;
+}
+
+static void neru_label_entry_free(NeruLabelEntry *e) {
+	if (e->surface)
+		cairo_surface_destroy(e->surface);
+	free(e->text);
+	free(e->font_family);
+	free(e);
+}
+
+static void neru_label_remove(NeruLabelCache *cache, NeruLabelEntry *e) {
+	NeruLabelEntry **slot = &cache->buckets[e->hash % NERU_LABEL_CACHE_BUCKETS];
+	while (*slot && *slot != e)
+		slot = &(*slot)->hash_next;
+	if (*slot)
+		*slot = e->hash_next;
+	neru_label_lru_unlink(cache, e);
+	neru_label_entry_free(e);
+	cache->count--;
+}
+
+NeruLabelCache *neru_label_cache_new(int capacity) {
+	NeruLabelCache *cache = calloc(1, sizeof(NeruLabelCache));
+	if (!cache)
+		return NULL;
+
+	cache->capacity = capacity > 0 ? capacity : NERU_LABEL_CACHE_CAPACITY;
+	cache->scratch_surface = cairo_image_surface_create(CAIRO_FORMAT_A8, 1, 1);
+	cache->scratch = cairo_create(cache->scratch_surface);
+	return cache;
+}
+
+void neru_label_cache_invalidate(NeruLabelCache *cache) {
+	if (!cache)
+		return;
+
+	NeruLabelEntry *e = cache->lru_head;
+	while (e) {
+		NeruLabelEntry *next = e->lru_next;
+		neru_label_entry_free(e);
+		e = next;
+	}
+	memset(cache->buckets, 0, sizeof(cache->buckets));
+	cache->lru_head = NULL;
+	cache->lru_tail = NULL;
+	cache->count = 0;
+}
+
+void neru_label_cache_destroy(NeruLabelCache *cache) {
+	if (!cache)
+		return;
+
+	neru_label_cache_invalidate(cache);
+	if (cache->scratch)
+		cairo_destroy(cache->scratch);
+	if (cache->scratch_surface)
+		cairo_surface_destroy(cache->scratch_surface);
+	free(cache);
+}
+
+void neru_label_cache_stats(NeruLabelCache *cache, NeruLabelCacheStats *out) {
+	if (!out)
+		return;
+	if (!cache) {
+		memset(out, 0, sizeof(*out));
+		return;
+	}
+	*out = cache->stats;
+	out->entries = cache->count;
+}
+
+static NeruLabelEntry *neru_label_lookup(
+    NeruLabelCache *cache, uint32_t hash, const char *text, const char *font_family, double font_size,
+    unsigned int color, double scale) {
+	for (NeruLabelEntry *e = cache->buckets[hash % NERU_LABEL_CACHE_BUCKETS]; e; e = e->hash_next) {
+		if (e->hash == hash && e->color == color && e->font_size == font_size && e->scale == scale &&
+		    strcmp(e->text, text) == 0 && strcmp(e->font_family, font_family) == 0)
+			return e;
+	}
+	return NULL;
+}
+
+// Shapes and rasterizes text once at device resolution. Runs only on a miss.
+static NeruLabelEntry *neru_label_render(
+    NeruLabelCache *cache, uint32_t hash, const char *text, const char *font_family, double font_size,
+    unsigned int color, double scale) {
+	NeruLabelEntry *e = calloc(1, sizeof(NeruLabelEntry));
+	if (!e)
+		return NULL;
+	e->text = strdup(text);
+	e->font_family = strdup(font_family);
+	if (!e->text || !e->font_family) {
+		neru_label_entry_free(e);
+		return NULL;
+	}
+	e->font_size = font_size;
+	e->scale = scale;
+	e->color = color;
+	e->hash = hash;
+
+	double device_size = font_size * scale;
+	cairo_text_extents_t extents;
+	cairo_select_font_face(cache->scratch, font_family, CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
+	cairo_set_font_size(cache->scratch, device_size);
+	cairo_text_extents(cache->scratch, text, &extents);
+
+	e->ink_width = extents.width;
+	int width = (int)ceil(extents.width) + 2 * NERU_LABEL_PAD;
+	int height = (int)ceil(extents.height) + 2 * NERU_LABEL_PAD;
+	if (extents.width <= 0 || extents.height <= 0)
+		return e;
+
+	cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+	if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) {
+		cairo_surface_destroy(surface);
+		neru_label_entry_free(e);
+		return NULL;
+	}
+
+	cairo_t *cr = cairo_create(surface);
+	cairo_select_font_face(cr, font_family, CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
+	cairo_set_font_size(cr, device_size);
+	cairo_set_source_rgba(
+	    cr, ((color >> 16) & 0xFF) / 255.0, ((color >> 8) & 0xFF) / 255.0, (color & 0xFF) / 255.0,
+	    ((color >> 24) & 0xFF) / 255.0);
+	cairo_move_to(cr, NERU_LABEL_PAD - extents.x_bearing, NERU_LABEL_PAD - extents.y_bearing);
+	cairo_show_text(cr, text);
+	cairo_destroy(cr);
+	cairo_surface_flush(surface);
+
+	e->surface = surface;
+	return e;
+}
+
+int neru_label_cache_draw(
+    NeruLabelCache *cache, cairo_t *cr, const char *text, const char *font_family, double x, double y,
+    double font_size, unsigned int color, double scale, double *out_x, double *out_y, double *out_w, double *out_h) {
+	if (!cache || !cr || !text || !font_family || !cache->scratch)
+		return 0;
+	if (scale <= 0)
+		scale = 1;
+
+	uint32_t hash = neru_label_hash(text, font_family, font_size, color, scale);
+	NeruLabelEntry *e = neru_label_lookup(cache, hash, text, font_family, font_size, color, scale);
+	if (e) {
+		cache->stats.hits++;
+		neru_label_lru_unlink(cache, e);
+		neru_label_lru_push_front(cache, e);
+	} else {
+		cache->stats.misses++;
+		e = neru_label_render(cache, hash, text, font_family, font_size, color, scale);
+		if (!e)
+			return 0;
+
+		while (cache->count >= cache->capacity && cache->lru_tail) {
+			neru_label_remove(cache, cache->lru_tail);
+			cache->stats.evictions++;
+		}
+		NeruLabelEntry **bucket = &cache->buckets[hash % NERU_LABEL_CACHE_BUCKETS];
+		e->hash_next = *bucket;
+		*bucket = e;
+		neru_label_lru_push_front(cache, e);
+		cache->count++;
+	}
+
+	if (!e->surface) {
+		*out_x = x;
+		*out_y = y;
+		*out_w = 0;
+		*out_h = 0;
+		return 1;
+	}
+
+	int width = cairo_image_surface_get_width(e->surface);
+	int height = cairo_image_surface_get_height(e->surface);
+
+	// The ink box is centered on (x, y), matching the uncached text path.
+	// Snap the bitmap to whole device pixels so it is never resampled.
+	double dx = x - (e->ink_width / 2.0 + NERU_LABEL_PAD) / scale;
+	double dy = y - (height / 2.0) / scale;
+	cairo_user_to_device(cr, &dx, &dy);
+	dx = round(dx);
+	dy = round(dy);
+
+	cairo_save(cr);
+	cairo_identity_matrix(cr);
+	cairo_set_source_surface(cr, e->surface, dx, dy);
+	cairo_paint(cr);
+	cairo_restore(cr);
+
+	cairo_device_to_user(cr, &dx, &dy);
+	*out_x = dx;
+	*out_y = dy;
+	*out_w = width / scale;
+	*out_h = height / scale;
+	return 1;
+}
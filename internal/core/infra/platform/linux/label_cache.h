@@ -0,0 +1,67 @@
+#ifndef LABEL_CACHE_H
+#define LABEL_CACHE_H
+
+#include <cairo/cairo.h>
+#include <stdint.h>
+
+#define NERU_LABEL_CACHE_CAPACITY 1024
+#define NERU_LABEL_CACHE_BUCKETS 2048
+
+typedef struct NeruLabelEntry {
+	char *text;
+	char *font_family;
+	double font_size;
+	double scale;
+	unsigned int color;
+	uint32_t hash;
+
+	// Pre-rendered label in device pixels: the ink box plus padding on every
+	// side. NULL for labels without ink (e.g. whitespace).
+	cairo_surface_t *surface;
+	double ink_width;
+
+	struct NeruLabelEntry *hash_next;
+	struct NeruLabelEntry *lru_prev;
+	struct NeruLabelEntry *lru_next;
+} NeruLabelEntry;
+
+typedef struct {
+	unsigned long hits;
+	unsigned long misses;
+	unsigned long evictions;
+	int entries;
+} NeruLabelCacheStats;
+
+// Bounded LRU of pre-rasterized labels keyed by (text, font family, size,
+// color, output scale). Not thread-safe; callers serialize access the same
+// way they serialize the cairo contexts it draws into.
+typedef struct {
+	NeruLabelEntry *buckets[NERU_LABEL_CACHE_BUCKETS];
+	NeruLabelEntry *lru_head;
+	NeruLabelEntry *lru_tail;
+	int count;
+	int capacity;
+
+	// Scratch context used only to measure text on a miss.
+	cairo_surface_t *scratch_surface;
+	cairo_t *scratch;
+
+	NeruLabelCacheStats stats;
+} NeruLabelCache;
+
+NeruLabelCache *neru_label_cache_new(int capacity);
+void neru_label_cache_destroy(NeruLabelCache *cache);
+// Drops every cached bitmap. Call when the theme or font configuration
+// changes so labels are re-rasterized with the new fonts.
+void neru_label_cache_invalidate(NeruLabelCache *cache);
+void neru_label_cache_stats(NeruLabelCache *cache, NeruLabelCacheStats *out);
+
+// Paints text centered on (x, y) in the user space of cr, whose CTM maps user
+// units to device pixels by scale. On success returns 1 and stores the
+// painted bounds in user space. Returns 0 when the label could not be cached;
+// the caller should then fall back to drawing the text directly.
+int neru_label_cache_draw(
+    NeruLabelCache *cache, cairo_t *cr, const char *text, const char *font_family, double x, double y,
+    double font_size, unsigned int color, double scale, double *out_x, double *out_y, double *out_w, double *out_h);
+
+#endif /* LABEL_CACHE_H */
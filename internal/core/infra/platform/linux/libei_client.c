@@ -1,11 +1,28 @@
 #include "libei_client.h"
 
+#include <errno.h>
 #include <libei.h>
 #include <liboeffis.h>
 #include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/epoll.h>
 #include <time.h>
+#include <unistd.h>
+
+#define NERU_EI_QUEUE_CAPACITY 512
+#define NERU_EI_QUEUE_BATCH 64
+#define NERU_EI_FRAME_KEYS 16
+#define NERU_EI_HELD_MAX 32
+#define NERU_EI_BTN_LEFT 0x110
+
+// Buttons or keys, by evdev code.
+typedef struct {
+	int codes[NERU_EI_HELD_MAX];
+	int n;
+} EiCodeSet;
 
 struct NeruEiClient {
 	struct oeffis *oeffis;
@@ -23,14 +40,50 @@ struct NeruEiClient {
 	int keyboard_emulating;
 
 	uint32_t seq;
+
+	// What the event thread delivered as pressed and not yet released, and the
+	// releases that found their device paused. Those are owed: they are sent
+	// as soon as the device resumes, so a pause mid-drag cannot leave a
+	// button or key held.
+	EiCodeSet pointer_held;
+	EiCodeSet pointer_owed;
+	EiCodeSet keyboard_held;
+	EiCodeSet keyboard_owed;
+
+	// libei is not thread-safe. Once neru_ei_connect returns, only the event
+	// thread touches the context and the fields above; callers see device
+	// state through these mirrors and hand input over through queue.
+	_Atomic int pointer_ready;
+	_Atomic int keyboard_present;
+	_Atomic int keyboard_ready;
+
+	NeruInjectRing *queue;
+	int epoll_fd;
+	pthread_t thread;
+	int thread_started;
+
+	NeruPointerGlide *glide;
+	NeruScrollGlide *scroll;
+
+	_Atomic uint64_t batches;
+	_Atomic uint64_t coalesced;
+	_Atomic uint64_t frames;
+	_Atomic uint64_t latency_count;
+	_Atomic uint64_t latency_total_ns;
+	_Atomic uint64_t latency_max_ns;
 };
 
-static int64_t now_ms(void) {
+static void emit_abs(void *ctx, int x, int y);
+static void emit_scroll(void *ctx, int axis, int value120, int last);
+
+static int64_t now_ns(void) {
 	struct timespec ts;
 	clock_gettime(CLOCK_MONOTONIC, &ts);
-	return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+	return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
 }
 
+static int64_t now_ms(void) { return now_ns() / 1000000; }
+
 // wait_readable blocks until fd is readable or the deadline passes. Returns 1
 // when readable, 0 on timeout, -1 on error.
 static int wait_readable(int fd, int64_t deadline_ms) {
@@ -111,12 +164,16 @@ static void drain(NeruEiClient *c) {
 				c->pointer = NULL;
 				c->pointer_resumed = 0;
 				c->pointer_emulating = 0;
+				c->pointer_held.n = 0;
+				c->pointer_owed.n = 0;
 			}
 			if (d == c->keyboard) {
 				ei_device_unref(c->keyboard);
 				c->keyboard = NULL;
 				c->keyboard_resumed = 0;
 				c->keyboard_emulating = 0;
+				c->keyboard_held.n = 0;
+				c->keyboard_owed.n = 0;
 			}
 			break;
 		}
@@ -125,17 +182,10 @@ static void drain(NeruEiClient *c) {
 		}
 		ei_event_unref(e);
 	}
-}
 
-// pump dispatches any pending socket data and drains the resulting events.
-// Non-blocking; safe to call before every emit.
-static void pump(NeruEiClient *c) {
-	int fd = ei_get_fd(c->ei);
-	struct pollfd pfd = {.fd = fd, .events = POLLIN};
-	if (poll(&pfd, 1, 0) > 0) {
-		ei_dispatch(c->ei);
-	}
-	drain(c);
+	atomic_store(&c->pointer_ready, c->pointer != NULL && c->pointer_resumed);
+	atomic_store(&c->keyboard_present, c->keyboard != NULL);
+	atomic_store(&c->keyboard_ready, c->keyboard != NULL && c->keyboard_resumed);
 }
 
 // ensure_emulating starts a new emulation transaction on a resumed device.
@@ -151,11 +201,321 @@ static int ensure_emulating(NeruEiClient *c, struct ei_device *device, int resum
 	return 1;
 }
 
+// start_emulating starts emulation on every resumed device. It stays started
+// until the device pauses, so input never waits on ei_device_start_emulating.
+static void start_emulating(NeruEiClient *c) {
+	ensure_emulating(c, c->pointer, c->pointer_resumed, &c->pointer_emulating);
+	ensure_emulating(c, c->keyboard, c->keyboard_resumed, &c->keyboard_emulating);
+}
+
+// ---------- Event thread ----------
+
+static int code_set_remove(EiCodeSet *set, int code) {
+	for (int i = 0; i < set->n; i++) {
+		if (set->codes[i] == code) {
+			set->codes[i] = set->codes[--set->n];
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static void code_set_add(EiCodeSet *set, int code) {
+	for (int i = 0; i < set->n; i++) {
+		if (set->codes[i] == code) {
+			return;
+		}
+	}
+	if (set->n < NERU_EI_HELD_MAX) {
+		set->codes[set->n++] = code;
+	}
+}
+
+// note_delivered tracks a press or release that reached the device.
+static void note_delivered(EiCodeSet *held, int code, int pressed) {
+	if (pressed) {
+		code_set_add(held, code);
+	} else {
+		code_set_remove(held, code);
+	}
+}
+
+// note_undelivered owes a release whose device is paused when it was pressed
+// there. Presses are dropped as before.
+static void note_undelivered(EiCodeSet *held, EiCodeSet *owed, int code, int pressed) {
+	if (!pressed && code_set_remove(held, code)) {
+		code_set_add(owed, code);
+	}
+}
+
+// send_owed sends the owed releases of a device that resumed, in a frame of
+// their own, and reports whether it did.
+static int send_owed(NeruEiClient *c, struct ei_device *device, int resumed, int *emulating, EiCodeSet *owed,
+                     int is_key) {
+	if (owed->n == 0 || !ensure_emulating(c, device, resumed, emulating)) {
+		return 0;
+	}
+	for (int i = 0; i < owed->n; i++) {
+		if (is_key) {
+			ei_device_keyboard_key(device, (uint32_t)owed->codes[i], false);
+		} else {
+			ei_device_button_button(device, (uint32_t)owed->codes[i], false);
+		}
+	}
+	ei_device_frame(device, ei_now(c->ei));
+	owed->n = 0;
+	return 1;
+}
+
+// resend_releases runs after device changes were applied and before any newer
+// input, so owed releases keep their place in the order.
+static void resend_releases(NeruEiClient *c) {
+	int frames = send_owed(c, c->pointer, c->pointer_resumed, &c->pointer_emulating, &c->pointer_owed, 0);
+	frames += send_owed(c, c->keyboard, c->keyboard_resumed, &c->keyboard_emulating, &c->keyboard_owed, 1);
+	if (frames > 0) {
+		ei_dispatch(c->ei);
+		atomic_fetch_add(&c->frames, (uint64_t)frames);
+	}
+}
+
+// The frame the event thread is assembling. A libei frame belongs to one
+// device, so an event for the other device closes it, which also keeps the
+// order between the two. A pointer frame starts with at most one motion and
+// buttons and scrolls join it, like a physical mouse report; anything that
+// would make the frame ambiguous closes it first: a motion after a button or
+// scroll, a second scroll on the same axis, a button pressed again or
+// released twice, or a key already in the frame.
+typedef struct {
+	struct ei_device *device;  // NULL while no frame is open
+	int moved;
+	uint32_t axes;
+	uint32_t pressed;
+	uint32_t released;
+	int keys[NERU_EI_FRAME_KEYS];
+	int nkeys;
+	uint64_t frames;
+} EiFrame;
+
+static void frame_close(NeruEiClient *c, EiFrame *f) {
+	if (!f->device) {
+		return;
+	}
+	ei_device_frame(f->device, ei_now(c->ei));
+	f->frames++;
+	f->device = NULL;
+	f->moved = 0;
+	f->axes = 0;
+	f->pressed = 0;
+	f->released = 0;
+	f->nkeys = 0;
+}
+
+// frame_join closes a frame open on another device and reports whether device
+// can take an event now.
+static int frame_join(NeruEiClient *c, EiFrame *f, struct ei_device *device, int resumed, int *emulating) {
+	if (f->device != device) {
+		frame_close(c, f);
+	}
+	if (!ensure_emulating(c, device, resumed, emulating)) {
+		return 0;
+	}
+	f->device = device;
+	return 1;
+}
+
+static int frame_has_key(const EiFrame *f, int keycode) {
+	for (int i = 0; i < f->nkeys; i++) {
+		if (f->keys[i] == keycode) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// 0 for codes outside BTN_MOUSE, which are always sent in a frame of their own.
+static uint32_t button_bit(int button) {
+	if (button < NERU_EI_BTN_LEFT || button >= NERU_EI_BTN_LEFT + 32) {
+		return 0;
+	}
+	return 1u << (button - NERU_EI_BTN_LEFT);
+}
+
+// record_latency accounts the time each command in the batch spent between
+// submission and being handed to the EIS socket.
+static void record_latency(NeruEiClient *c, const NeruInjectCmd *cmds, int n) {
+	int64_t now = now_ns();
+	uint64_t total = 0;
+	uint64_t worst = 0;
+	for (int i = 0; i < n; i++) {
+		uint64_t latency = now > cmds[i].submit_ns ? (uint64_t)(now - cmds[i].submit_ns) : 0;
+		total += latency;
+		if (latency > worst) {
+			worst = latency;
+		}
+	}
+
+	atomic_fetch_add(&c->latency_count, (uint64_t)n);
+	atomic_fetch_add(&c->latency_total_ns, total);
+	uint64_t seen = atomic_load(&c->latency_max_ns);
+	while (worst > seen && !atomic_compare_exchange_weak(&c->latency_max_ns, &seen, worst)) {
+	}
+}
+
+// write_batch sends one batch of queued input and dispatches it once. Runs
+// of absolute motions collapse into the last position, the only one a client
+// would see. Input for a device that is not resumed is dropped, as it was
+// when the caller emitted directly, except releases of what it had pressed:
+// those are owed until it resumes.
+static void write_batch(NeruEiClient *c, const NeruInjectCmd *cmds, int n) {
+	EiFrame f = {0};
+	uint64_t coalesced = 0;
+	int moved = 0;
+
+	for (int i = 0; i < n; i++) {
+		const NeruInjectCmd *cmd = &cmds[i];
+		switch (cmd->kind) {
+		case NERU_INJECT_MOTION_ABS:
+			while (i + 1 < n && cmds[i + 1].kind == NERU_INJECT_MOTION_ABS) {
+				cmd = &cmds[++i];
+				coalesced++;
+			}
+			if (f.moved || f.axes || f.pressed || f.released) {
+				frame_close(c, &f);
+			}
+			if (!frame_join(c, &f, c->pointer, c->pointer_resumed, &c->pointer_emulating)) {
+				break;
+			}
+			ei_device_pointer_motion_absolute(c->pointer, (double)cmd->a, (double)cmd->b);
+			f.moved = 1;
+			moved = 1;
+			break;
+		case NERU_INJECT_BUTTON: {
+			uint32_t bit = button_bit(cmd->a);
+			uint32_t seen = cmd->b ? f.pressed | f.released : f.released;
+			if (bit == 0 || (seen & bit)) {
+				frame_close(c, &f);
+			}
+			if (!frame_join(c, &f, c->pointer, c->pointer_resumed, &c->pointer_emulating)) {
+				note_undelivered(&c->pointer_held, &c->pointer_owed, cmd->a, cmd->b);
+				break;
+			}
+			ei_device_button_button(c->pointer, (uint32_t)cmd->a, cmd->b != 0);
+			note_delivered(&c->pointer_held, cmd->a, cmd->b);
+			if (cmd->b) {
+				f.pressed |= bit;
+			} else {
+				f.released |= bit;
+			}
+			break;
+		}
+		case NERU_INJECT_AXIS:
+		case NERU_INJECT_AXIS_VALUE120: {
+			uint32_t bit = 1u << (cmd->a & 1);
+			if (f.axes & bit) {
+				frame_close(c, &f);
+			}
+			if (!frame_join(c, &f, c->pointer, c->pointer_resumed, &c->pointer_emulating)) {
+				break;
+			}
+			int horizontal = cmd->a == 1;
+			if (cmd->kind == NERU_INJECT_AXIS_VALUE120) {
+				ei_device_scroll_discrete(c->pointer, horizontal ? cmd->b : 0, horizontal ? 0 : cmd->b);
+			} else {
+				ei_device_scroll_delta(
+				    c->pointer, horizontal ? (double)cmd->b : 0.0, horizontal ? 0.0 : (double)cmd->b);
+			}
+			f.axes |= bit;
+			break;
+		}
+		case NERU_INJECT_KEY:
+			if (f.nkeys == NERU_EI_FRAME_KEYS || frame_has_key(&f, cmd->a)) {
+				frame_close(c, &f);
+			}
+			if (!frame_join(c, &f, c->keyboard, c->keyboard_resumed, &c->keyboard_emulating)) {
+				note_undelivered(&c->keyboard_held, &c->keyboard_owed, cmd->a, cmd->b);
+				break;
+			}
+			ei_device_keyboard_key(c->keyboard, (uint32_t)cmd->a, cmd->b != 0);
+			note_delivered(&c->keyboard_held, cmd->a, cmd->b);
+			f.keys[f.nkeys++] = cmd->a;
+			break;
+		default:
+			break;
+		}
+	}
+	frame_close(c, &f);
+
+	// Nudge with a zero-delta relative motion so KWin repaints the cursor sprite
+	// at the warped position. The absolute motion alone updates the logical
+	// pointer (clicks land) but the visible cursor can lag behind on KWin. Once
+	// per batch is enough: only the last position is drawn.
+	if (moved && c->pointer_emulating && ei_device_has_capability(c->pointer, EI_DEVICE_CAP_POINTER)) {
+		ei_device_pointer_motion(c->pointer, 0.0, 0.0);
+		ei_device_frame(c->pointer, ei_now(c->ei));
+		f.frames++;
+	}
+
+	ei_dispatch(c->ei);
+
+	record_latency(c, cmds, n);
+	atomic_fetch_add(&c->batches, 1);
+	atomic_fetch_add(&c->coalesced, coalesced);
+	atomic_fetch_add(&c->frames, f.frames);
+}
+
+// event_loop owns the libei context once the session is up. It wakes on
+// either EIS traffic or queued input; device changes are applied before the
+// batch so input never goes to a device that was paused in the meantime.
+static void *event_loop(void *arg) {
+	NeruEiClient *c = arg;
+	NeruInjectCmd batch[NERU_EI_QUEUE_BATCH];
+	struct epoll_event events[2];
+	int efd = ei_get_fd(c->ei);
+
+	for (;;) {
+		int ready = epoll_wait(c->epoll_fd, events, 2, -1);
+		if (ready < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return NULL;
+		}
+
+		for (int i = 0; i < ready; i++) {
+			if (events[i].data.fd == efd) {
+				ei_dispatch(c->ei);
+				drain(c);
+				start_emulating(c);
+				resend_releases(c);
+			}
+		}
+
+		int n;
+		while ((n = neru_inject_ring_drain(c->queue, batch, NERU_EI_QUEUE_BATCH)) > 0) {
+			write_batch(c, batch, n);
+			if (n < NERU_EI_QUEUE_BATCH) {
+				break;
+			}
+		}
+		if (n < 0) {
+			return NULL;
+		}
+	}
+}
+
+static int watch_readable(int epoll_fd, int fd) {
+	struct epoll_event ev = {.events = EPOLLIN, .data.fd = fd};
+	return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) == 0;
+}
+
+// ---------- Connect & API ----------
+
 NeruEiClient *neru_ei_connect(int timeout_ms) {
 	NeruEiClient *c = calloc(1, sizeof(*c));
 	if (!c) {
 		return NULL;
 	}
+	c->epoll_fd = -1;
 
 	int64_t deadline = now_ms() + (timeout_ms > 0 ? timeout_ms : 30000);
 
@@ -244,6 +604,20 @@ NeruEiClient *neru_ei_connect(int timeout_ms) {
 		}
 	}
 
+	// 4) Hand the context to the event thread.
+	start_emulating(c);
+	c->queue = neru_inject_ring_new(NERU_EI_QUEUE_CAPACITY);
+	c->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (!c->queue || c->epoll_fd < 0 || !watch_readable(c->epoll_fd, efd) ||
+	    !watch_readable(c->epoll_fd, neru_inject_ring_wake_fd(c->queue)) ||
+	    pthread_create(&c->thread, NULL, event_loop, c) != 0) {
+		neru_ei_disconnect(c);
+		return NULL;
+	}
+	c->thread_started = 1;
+
+	c->glide = neru_glide_new(emit_abs, c);
+	c->scroll = neru_scroll_glide_new(emit_scroll, c);
 	return c;
 }
 
@@ -251,6 +625,18 @@ void neru_ei_disconnect(NeruEiClient *c) {
 	if (!c) {
 		return;
 	}
+	// The glide threads queue input; stop them first, then let the event
+	// thread send what is queued and exit before libei is torn down.
+	neru_glide_free(c->glide);
+	neru_scroll_glide_free(c->scroll);
+	if (c->thread_started) {
+		neru_inject_ring_close(c->queue);
+		pthread_join(c->thread, NULL);
+	}
+	neru_inject_ring_free(c->queue);
+	if (c->epoll_fd >= 0) {
+		close(c->epoll_fd);
+	}
 	if (c->pointer) {
 		if (c->pointer_emulating) {
 			ei_device_stop_emulating(c->pointer);
@@ -275,85 +661,102 @@ void neru_ei_disconnect(NeruEiClient *c) {
 	free(c);
 }
 
+// submit stamps cmd for the latency stats and queues it for the event thread.
+static int submit(NeruEiClient *c, NeruInjectCmd *cmd) {
+	cmd->submit_ns = now_ns();
+	return neru_inject_ring_push(c->queue, cmd);
+}
+
+// emit_abs is the glide engine's per-frame callback.
+static void emit_abs(void *ctx, int x, int y) {
+	NeruInjectCmd cmd = {.kind = NERU_INJECT_MOTION_ABS, .a = x, .b = y};
+	submit(ctx, &cmd);
+}
+
+// emit_scroll is the scroll glide's per-frame callback.
+static void emit_scroll(void *ctx, int axis, int value120, int last) {
+	(void)last;
+	NeruInjectCmd cmd = {.kind = NERU_INJECT_AXIS_VALUE120, .a = axis, .b = value120};
+	submit(ctx, &cmd);
+}
+
 int neru_ei_move_abs(NeruEiClient *c, int x, int y) {
 	if (!c) {
 		return 0;
 	}
-	pump(c);
-	if (!ensure_emulating(c, c->pointer, c->pointer_resumed, &c->pointer_emulating)) {
+	neru_glide_cancel(c->glide);
+	if (!atomic_load(&c->pointer_ready)) {
 		return 0;
 	}
-	ei_device_pointer_motion_absolute(c->pointer, (double)x, (double)y);
-	ei_device_frame(c->pointer, ei_now(c->ei));
-
-	// Nudge with a zero-delta relative motion so KWin repaints the cursor sprite
-	// at the warped position. The absolute motion alone updates the logical
-	// pointer (clicks land) but the visible cursor can lag behind on KWin.
-	if (ei_device_has_capability(c->pointer, EI_DEVICE_CAP_POINTER)) {
-		ei_device_pointer_motion(c->pointer, 0.0, 0.0);
-		ei_device_frame(c->pointer, ei_now(c->ei));
-	}
-
-	ei_dispatch(c->ei);
-	return 1;
+	NeruInjectCmd cmd = {.kind = NERU_INJECT_MOTION_ABS, .a = x, .b = y};
+	return submit(c, &cmd);
 }
 
-int neru_ei_button(NeruEiClient *c, int button, int pressed) {
+int neru_ei_glide_to(
+    NeruEiClient *c, int from_x, int from_y, int x, int y, int duration_ms, int refresh_mhz, NeruGlideDoneFn done,
+    uint64_t token) {
 	if (!c) {
 		return 0;
 	}
-	pump(c);
-	if (!ensure_emulating(c, c->pointer, c->pointer_resumed, &c->pointer_emulating)) {
+	return neru_glide_start(c->glide, from_x, from_y, x, y, duration_ms, refresh_mhz, done, token);
+}
+
+int neru_ei_button(NeruEiClient *c, int button, int pressed) {
+	// A release is queued even while the pointer looks paused: the mirror may
+	// be stale either way, and the event thread owes it until resume.
+	if (!c || (pressed && !atomic_load(&c->pointer_ready))) {
 		return 0;
 	}
-	ei_device_button_button(c->pointer, (uint32_t)button, pressed != 0);
-	ei_device_frame(c->pointer, ei_now(c->ei));
-	ei_dispatch(c->ei);
-	return 1;
+	NeruInjectCmd cmd = {.kind = NERU_INJECT_BUTTON, .a = button, .b = pressed != 0};
+	return submit(c, &cmd);
 }
 
 int neru_ei_scroll(NeruEiClient *c, int axis, int delta) {
-	if (!c) {
-		return 0;
-	}
-	pump(c);
-	if (!ensure_emulating(c, c->pointer, c->pointer_resumed, &c->pointer_emulating)) {
+	if (!c || !atomic_load(&c->pointer_ready)) {
 		return 0;
 	}
-	if (axis == 1) {
-		ei_device_scroll_delta(c->pointer, (double)delta, 0.0);
-	} else {
-		ei_device_scroll_delta(c->pointer, 0.0, (double)delta);
-	}
-	ei_device_frame(c->pointer, ei_now(c->ei));
-	ei_dispatch(c->ei);
-	return 1;
+	NeruInjectCmd cmd = {.kind = NERU_INJECT_AXIS, .a = axis, .b = delta};
+	return submit(c, &cmd);
 }
 
-int neru_ei_key(NeruEiClient *c, int keycode, int pressed) {
+int neru_ei_scroll_by(NeruEiClient *c, int dx120, int dy120, int duration_ms, int refresh_mhz) {
 	if (!c) {
 		return 0;
 	}
-	pump(c);
-	if (!ensure_emulating(c, c->keyboard, c->keyboard_resumed, &c->keyboard_emulating)) {
+	return neru_scroll_glide_by(c->scroll, dx120, dy120, duration_ms, refresh_mhz);
+}
+
+int neru_ei_key(NeruEiClient *c, int keycode, int pressed) {
+	// Releases are queued regardless of the mirror, as in neru_ei_button.
+	if (!c || (pressed && !atomic_load(&c->keyboard_ready))) {
 		return 0;
 	}
-	ei_device_keyboard_key(c->keyboard, (uint32_t)keycode, pressed != 0);
-	ei_device_frame(c->keyboard, ei_now(c->ei));
-	ei_dispatch(c->ei);
-	return 1;
+	NeruInjectCmd cmd = {.kind = NERU_INJECT_KEY, .a = keycode, .b = pressed != 0};
+	return submit(c, &cmd);
 }
 
 int neru_ei_has_keyboard(NeruEiClient *c) {
 	if (!c) {
 		return 0;
 	}
-	// The keyboard device may have been added/resumed after we finished waiting
-	// in neru_ei_connect (which only waits for the pointer device). Pump any
-	// pending EIS events so the keyboard state is visible to the caller.
-	pump(c);
-	// Only check device existence, not resume state: a transient pause by the
-	// compositor would otherwise make the Go layer report a permanent "not
-	// granted" error even though the device exists and will be resumed shortly.
-	return c->keyboard != NULL;
+	// The keyboard device may be added after neru_ei_connect stopped waiting
+	// for it; the event thread keeps this mirror current. Only existence is
+	// checked, not resume state: a transient pause by the compositor would
+	// otherwise make the Go layer report a permanent "not granted" error even
+	// though the device exists and will be resumed shortly.
+	return atomic_load(&c->keyboard_present);
+}
+
+int neru_ei_stats(NeruEiClient *c, NeruEiStats *out) {
+	if (!c || !c->queue) {
+		return 0;
+	}
+	neru_inject_ring_stats(c->queue, &out->ring);
+	out->batches = atomic_load(&c->batches);
+	out->coalesced = atomic_load(&c->coalesced);
+	out->frames = atomic_load(&c->frames);
+	out->latency_count = atomic_load(&c->latency_count);
+	out->latency_total_ns = atomic_load(&c->latency_total_ns);
+	out->latency_max_ns = atomic_load(&c->latency_max_ns);
+	return 1;
 }
@@ -8,8 +8,29 @@
 // keyboard events on it. Screen enumeration and overlays still go through the
 // wlroots client; this wrapper only covers input.
 
+#include "inject_ring.h"
+#include "pointer_glide.h"
+#include "scroll_glide.h"
+
+#include <stdint.h>
+
+// Every function may be called from any thread. The libei context lives on
+// the client's own event thread: input calls only queue the event and return,
+// and the thread sends whatever was queued within one wakeup as shared frames
+// with a single dispatch.
 typedef struct NeruEiClient NeruEiClient;
 
+typedef struct {
+	NeruInjectRingStats ring;
+	uint64_t batches;
+	uint64_t coalesced;
+	uint64_t frames;
+	// Time from each input call until its event was handed to the EIS socket.
+	uint64_t latency_count;
+	uint64_t latency_total_ns;
+	uint64_t latency_max_ns;
+} NeruEiStats;
+
 // Establish a RemoteDesktop portal session and a libei sender context, blocking
 // until the absolute-pointer device is ready or timeout_ms elapses. The portal
 // shows a one-time consent dialog the user must approve. Returns NULL on
@@ -20,22 +41,44 @@ NeruEiClient *neru_ei_connect(int timeout_ms);
 void neru_ei_disconnect(NeruEiClient *c);
 
 // Move the absolute pointer to global compositor coordinates (logical pixels).
-// Returns 1 on success, 0 otherwise.
+// Returns 1 when the motion was queued, 0 when the pointer is not resumed or
+// the queue is full.
 int neru_ei_move_abs(NeruEiClient *c, int x, int y);
 
+// Glide the absolute pointer from (from_x, from_y) to (x, y) over duration_ms,
+// one motion per refresh interval of an output at refresh_mhz (libei has no
+// notion of outputs; the caller looks it up). done is called with token once
+// the glide ends; neru_ei_move_abs or another glide cancels it. Returns 1 when
+// the glide was started.
+int neru_ei_glide_to(
+    NeruEiClient *c, int from_x, int from_y, int x, int y, int duration_ms, int refresh_mhz, NeruGlideDoneFn done,
+    uint64_t token);
+
 // Press (pressed != 0) or release a pointer button. The button code is an
-// evdev code (e.g. 0x110 for BTN_LEFT). Returns 1 on success, 0 otherwise.
+// evdev code (e.g. 0x110 for BTN_LEFT). Returns 1 when queued, 0 otherwise.
+// A release of a pressed button is never lost to a device pause: it is sent
+// once the pointer resumes.
 int neru_ei_button(NeruEiClient *c, int button, int pressed);
 
 // Emit a scroll event. axis: 0 = vertical, 1 = horizontal. delta is the scroll
-// distance in logical pixels (positive = down/right). Returns 1 on success.
+// distance in logical pixels (positive = down/right). Returns 1 when queued.
 int neru_ei_scroll(NeruEiClient *c, int axis, int delta);
 
-// Press or release a keyboard key (evdev keycode). Returns 1 on success, 0 when
-// no keyboard device is available on the granted session.
+// Scroll by (dx120, dy120) value120 units (120 per wheel notch, positive =
+// down/right) over duration_ms, as discrete high-resolution steps paced to an
+// output at refresh_mhz. duration_ms <= 0 sends it at once. Returns 1 when the
+// scroll was sent or started.
+int neru_ei_scroll_by(NeruEiClient *c, int dx120, int dy120, int duration_ms, int refresh_mhz);
+
+// Press or release a keyboard key (evdev keycode). Returns 1 when queued, 0
+// when no keyboard device is available on the granted session. Releases are
+// held across a pause like button releases.
 int neru_ei_key(NeruEiClient *c, int keycode, int pressed);
 
 // Whether the granted session exposes a keyboard device.
 int neru_ei_has_keyboard(NeruEiClient *c);
 
+// Copy the input queue and latency counters. Returns 0 for a NULL client.
+int neru_ei_stats(NeruEiClient *c, NeruEiStats *out);
+
 #endif /* LIBEI_CLIENT_H */
@@ -0,0 +1,109 @@
+#include "overlay_cmds.h"
+
+#include <string.h>
+
+// Resolves a string table offset, rejecting anything that would read past the
+// table or is not NUL-terminated inside it.
+static const char *neru_draw_string(const char *strings, size_t strings_len, uint32_t offset) {
+	if (!strings || offset >= strings_len)
+		return NULL;
+	if (!memchr(strings + offset, '\0', strings_len - offset))
+		return NULL;
+	return strings + offset;
+}
+
+// Executes one command. Returns 0 when the command was skipped.
+static int neru_draw_cmd_exec(
+    const NeruDrawTarget *target, void *ctx, const NeruDrawCmd *cmd, const char *strings, size_t strings_len) {
+	switch (cmd->op) {
+	case NERU_DRAW_OP_CLEAR:
+		target->clear(ctx);
+		return 1;
+	case NERU_DRAW_OP_CLEAR_RECT:
+		target->clear_rect(ctx, cmd->x, cmd->y, cmd->width, cmd->height);
+		return 1;
+	case NERU_DRAW_OP_RECT:
+		target->rect(ctx, cmd->x, cmd->y, cmd->width, cmd->height, cmd->fill, cmd->stroke, cmd->stroke_width);
+		return 1;
+	case NERU_DRAW_OP_ROUNDED_RECT:
+		target->rounded_rect(
+		    ctx, cmd->x, cmd->y, cmd->width, cmd->height, cmd->radius, cmd->fill, cmd->stroke, cmd->stroke_width);
+		return 1;
+	case NERU_DRAW_OP_TEXT: {
+		const char *text = neru_draw_string(strings, strings_len, cmd->text);
+		const char *font = neru_draw_string(strings, strings_len, cmd->font);
+		if (!text || !font)
+			return 0;
+		target->text(ctx, text, font, cmd->x, cmd->y, cmd->font_size, cmd->fill);
+		return 1;
+	}
+	default:
+		return 0;
+	}
+}
+
+int neru_draw_cmds_replay(
+    const NeruDrawTarget *target, void *ctx, unsigned int version, const NeruDrawCmd *cmds, int n,
+    const char *strings, size_t strings_len) {
+	if (!target || version != NERU_DRAW_CMD_VERSION)
+		return -1;
+	if (!cmds || n <= 0)
+		return 0;
+
+	int executed = 0;
+	for (int i = 0; i < n; i++)
+		executed += neru_draw_cmd_exec(target, ctx, &cmds[i], strings, strings_len);
+
+	return executed;
+}
+
+int neru_draw_cmds_replay_bin(
+    const NeruDrawTarget *target, void *ctx, const NeruDrawCmd *cmds, const int *bin, int bin_len,
+    const char *strings, size_t strings_len) {
+	if (!target || !cmds || !bin || bin_len <= 0)
+		return 0;
+
+	int executed = 0;
+	for (int i = 0; i < bin_len; i++)
+		executed += neru_draw_cmd_exec(target, ctx, &cmds[bin[i]], strings, strings_len);
+
+	return executed;
+}
+
+void neru_draw_text_bounds(
+    const char *text, double x, double y, double font_size, double *x1, double *y1, double *x2, double *y2) {
+	// One em per UTF-8 byte over-estimates every glyph advance, which is all
+	// culling needs; it avoids a text-extents call per output.
+	double half_w = (double)(text ? strlen(text) : 0) * font_size / 2.0 + font_size;
+	double half_h = font_size;
+	*x1 = x - half_w;
+	*y1 = y - half_h;
+	*x2 = x + half_w;
+	*y2 = y + half_h;
+}
+
+int neru_draw_cmd_bounds(
+    const NeruDrawCmd *cmd, const char *strings, size_t strings_len, double *x1, double *y1, double *x2, double *y2) {
+	double pad = 0;
+
+	switch (cmd->op) {
+	case NERU_DRAW_OP_CLEAR:
+		return 0;
+	case NERU_DRAW_OP_RECT:
+	case NERU_DRAW_OP_ROUNDED_RECT:
+		pad = cmd->stroke_width / 2.0;
+		// fallthrough
+	case NERU_DRAW_OP_CLEAR_RECT:
+		*x1 = cmd->x - pad;
+		*y1 = cmd->y - pad;
+		*x2 = cmd->x + cmd->width + pad;
+		*y2 = cmd->y + cmd->height + pad;
+		return 1;
+	case NERU_DRAW_OP_TEXT:
+		neru_draw_text_bounds(
+		    neru_draw_string(strings, strings_len, cmd->text), cmd->x, cmd->y, cmd->font_size, x1, y1, x2, y2);
+		return 1;
+	default:
+		return 0;
+	}
+}
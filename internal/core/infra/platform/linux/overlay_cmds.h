@@ -0,0 +1,72 @@
+#ifndef OVERLAY_CMDS_H
+#define OVERLAY_CMDS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Version of the NeruDrawCmd layout. Bump whenever the struct or the op
+// semantics change so a stale Go build cannot feed a newer renderer.
+#define NERU_DRAW_CMD_VERSION 1
+
+typedef enum {
+	NERU_DRAW_OP_CLEAR = 0,
+	NERU_DRAW_OP_CLEAR_RECT = 1,
+	NERU_DRAW_OP_RECT = 2,
+	NERU_DRAW_OP_ROUNDED_RECT = 3,
+	NERU_DRAW_OP_TEXT = 4,
+} NeruDrawOp;
+
+// One overlay primitive in global logical coordinates. Colors are resolved
+// ARGB values. Text and font names are byte offsets into the NUL-separated
+// string table submitted alongside the command list; text is centered on
+// (x, y). Doubles come first so the layout has no interior padding.
+typedef struct {
+	double x, y, width, height;
+	double radius;
+	double stroke_width;
+	double font_size;
+	uint32_t op;
+	uint32_t fill;
+	uint32_t stroke;
+	uint32_t text;
+	uint32_t font;
+	uint32_t reserved;
+} NeruDrawCmd;
+
+// Backend primitives a command list is replayed onto.
+typedef struct {
+	void (*clear)(void *ctx);
+	void (*clear_rect)(void *ctx, double x, double y, double width, double height);
+	void (*rect)(
+	    void *ctx, double x, double y, double width, double height, unsigned int fill, unsigned int stroke,
+	    double stroke_width);
+	void (*rounded_rect)(
+	    void *ctx, double x, double y, double width, double height, double radius, unsigned int fill,
+	    unsigned int stroke, double stroke_width);
+	void (*text)(
+	    void *ctx, const char *text, const char *font_family, double x, double y, double font_size,
+	    unsigned int color);
+} NeruDrawTarget;
+
+// Replays cmds onto target. Returns the number of commands executed, or -1
+// when version does not match NERU_DRAW_CMD_VERSION.
+int neru_draw_cmds_replay(
+    const NeruDrawTarget *target, void *ctx, unsigned int version, const NeruDrawCmd *cmds, int n,
+    const char *strings, size_t strings_len);
+
+// Replays only the commands listed in bin (indices into cmds, in order).
+// The caller has already validated the version.
+int neru_draw_cmds_replay_bin(
+    const NeruDrawTarget *target, void *ctx, const NeruDrawCmd *cmds, const int *bin, int bin_len,
+    const char *strings, size_t strings_len);
+
+// Computes a conservative bounding box for text centered on (x, y).
+void neru_draw_text_bounds(
+    const char *text, double x, double y, double font_size, double *x1, double *y1, double *x2, double *y2);
+
+// Computes a conservative global bounding box for cmd. Returns 0 for
+// full-surface commands (clear), which have no bounds and touch every output.
+int neru_draw_cmd_bounds(
+    const NeruDrawCmd *cmd, const char *strings, size_t strings_len, double *x1, double *y1, double *x2, double *y2);
+
+#endif /* OVERLAY_CMDS_H */
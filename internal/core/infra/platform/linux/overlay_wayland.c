@@ -1,17 +1,23 @@
 #include "overlay_wayland.h"
 
+#include "wlr_protocol/fractional-scale-v1.h"
 #include "wlr_protocol/layer-shell.h"
+#include "wlr_protocol/presentation-time.h"
+#include "wlr_protocol/viewporter.h"
 #include "wlr_protocol/xdg-output.h"
 #include "wlr_protocol/xdg-shell.h"
 
 #include <cairo/cairo.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <math.h>
 #include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/eventfd.h>
 #include <sys/mman.h>
+#include <time.h>
 #include <unistd.h>
 #include <wayland-client.h>
 #include <xkbcommon/xkbcommon-keysyms.h>
@@ -20,43 +26,34 @@
 // Keyboard event ring buffer.
 // Thread safety: all accesses happen while the Go-side displayMu mutex is
 // held (shared with renderMu). The Wayland keyboard callback
-// (neru_keyboard_key) fires inside wl_display_dispatch / wl_display_roundtrip,
-// which only run while displayMu is held. The consumer
-// (neru_wayland_overlay_get_key) is called from the keyboard poller goroutine
+// (neru_keyboard_key) fires inside dispatches and roundtrips of the overlay's
+// event queue, which only run while displayMu is held; the input client
+// sharing the connection dispatches its own queue. The consumer
+// (neru_wayland_overlay_read_keys) is called from the keyboard poller goroutine
 // which also holds displayMu. Therefore no concurrent access can occur.
+// The poller releases displayMu only while blocked in neru_wayland_overlay_wait,
+// which reads events but never dispatches them.
 //
 // A ring buffer (rather than a single slot) is necessary because
 // wl_display_roundtrip — called from the rendering path — may dispatch
-// multiple keyboard events in a single call. With a single-slot buffer the
-// second event would silently overwrite the first.
-static void neru_key_ring_push(NeruWaylandOverlay *overlay, const char *key) {
-	if (!key || key[0] == '\0' || overlay->key_ring.count >= NERU_KEY_RING_CAP)
-		return;
-
-	snprintf(overlay->key_ring.keys[overlay->key_ring.head], sizeof(overlay->key_ring.keys[0]), "%s", key);
-	overlay->key_ring.head = (overlay->key_ring.head + 1) % NERU_KEY_RING_CAP;
-	overlay->key_ring.count++;
-}
-
-static const char *neru_modifier_name_from_keysym(xkb_keysym_t keysym) {
-	switch (keysym) {
-	case XKB_KEY_Shift_L:
-	case XKB_KEY_Shift_R:
-		return "shift";
-	case XKB_KEY_Control_L:
-	case XKB_KEY_Control_R:
-		return "ctrl";
-	case XKB_KEY_Alt_L:
-	case XKB_KEY_Alt_R:
-		return "alt";
-	case XKB_KEY_Super_L:
-	case XKB_KEY_Super_R:
-	case XKB_KEY_Meta_L:
-	case XKB_KEY_Meta_R:
-		return "cmd";
-	default:
-		return NULL;
+// multiple keyboard events in a single call. Events are small packed structs
+// so the ring can absorb held-key repeats; anything beyond that is counted
+// in overflows rather than dropped silently.
+static void neru_key_ring_push(NeruWaylandOverlay *overlay, const NeruKeyEvent *event) {
+	NeruWaylandKeyRing *ring = &overlay->key_ring;
+	if (ring->count >= NERU_KEY_RING_CAP) {
+		ring->overflows++;
+		return;
 	}
+
+	ring->events[ring->head] = *event;
+	ring->head = (ring->head + 1) % NERU_KEY_RING_CAP;
+	ring->count++;
+
+	// The key may have been dispatched by the render path while the poller
+	// sleeps in neru_wayland_overlay_wait; wake it so delivery does not wait
+	// for the next unrelated event.
+	neru_wayland_overlay_wake(overlay);
 }
 
 // Create anonymous shared memory
@@ -102,6 +99,7 @@ static void neru_layer_surface_configure(
 				overlay->screens[i].width = width;
 			if (height > 0)
 				overlay->screens[i].height = height;
+			overlay->screens[i].configured = 1;
 			break;
 		}
 	}
@@ -110,7 +108,16 @@ static void neru_layer_surface_configure(
 }
 
 static void neru_layer_surface_closed(void *data, struct zwlr_layer_surface_v1 *layer_surface) {
-	// No-op
+	// The compositor will never map this surface again (e.g. its output went
+	// away). Flag it so setup_buffers recreates it instead of reusing a
+	// standby surface.
+	NeruWaylandOverlay *overlay = (NeruWaylandOverlay *)data;
+	for (int i = 0; i < overlay->nr_screens; i++) {
+		if (overlay->screens[i].layer_surface == layer_surface) {
+			overlay->screens[i].closed = 1;
+			break;
+		}
+	}
 }
 
 static const struct zwlr_layer_surface_v1_listener layer_surface_listener = {
@@ -118,89 +125,26 @@ static const struct zwlr_layer_surface_v1_listener layer_surface_listener = {
     .closed = neru_layer_surface_closed,
 };
 
-// Output listener to track per-output buffer scale.
-static void neru_wl_output_geometry(
-    void *data, struct wl_output *output, int32_t x, int32_t y, int32_t phys_w, int32_t phys_h, int32_t subpixel,
-    const char *make, const char *model, int32_t transform) {}
-
-static void neru_wl_output_mode(
-    void *data, struct wl_output *output, uint32_t flags, int32_t width, int32_t height, int32_t refresh) {}
-
-static void neru_wl_output_done(void *data, struct wl_output *output) {}
-
-static void neru_wl_output_scale(void *data, struct wl_output *output, int32_t factor) {
+static void neru_fractional_scale_preferred(void *data, struct wp_fractional_scale_v1 *fractional, uint32_t scale) {
+	// Applied by the next setup_buffers, which reallocates the pool when the
+	// resulting buffer size or scale differs.
 	NeruWaylandOverlayScreen *scr = (NeruWaylandOverlayScreen *)data;
-	scr->scale = factor;
+	scr->preferred_scale = scale;
 }
 
-static const struct wl_output_listener wl_output_listener = {
-    .geometry = neru_wl_output_geometry,
-    .mode = neru_wl_output_mode,
-    .done = neru_wl_output_done,
-    .scale = neru_wl_output_scale,
+static const struct wp_fractional_scale_v1_listener fractional_scale_listener = {
+    .preferred_scale = neru_fractional_scale_preferred,
 };
 
-static void neru_overlay_registry_global(
-    void *data, struct wl_registry *registry, uint32_t name, const char *interface, uint32_t version) {
-	NeruWaylandOverlay *overlay = (NeruWaylandOverlay *)data;
-
-	if (strcmp(interface, "wl_compositor") == 0) {
-		overlay->compositor = wl_registry_bind(registry, name, &wl_compositor_interface, 4);
-	} else if (strcmp(interface, "wl_shm") == 0) {
-		overlay->shm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
-	} else if (strcmp(interface, "zwlr_layer_shell_v1") == 0) {
-		overlay->layer_shell = wl_registry_bind(registry, name, &zwlr_layer_shell_v1_interface, 1);
-	} else if (strcmp(interface, "wl_output") == 0) {
-		if (overlay->nr_screens < NERU_MAX_OUTPUTS) {
-			NeruWaylandOverlayScreen *scr = &overlay->screens[overlay->nr_screens];
-			scr->scale = 1;
-			scr->wl_output = wl_registry_bind(registry, name, &wl_output_interface, 3 < version ? 3 : version);
-			wl_output_add_listener(scr->wl_output, &wl_output_listener, scr);
-			overlay->nr_screens++;
-		}
-	} else if (strcmp(interface, "zxdg_output_manager_v1") == 0) {
-		overlay->xdg_output_mgr =
-		    wl_registry_bind(registry, name, &zxdg_output_manager_v1_interface, 3 < version ? 3 : version);
-	} else if (strcmp(interface, "wl_seat") == 0) {
-		overlay->wl_seat = wl_registry_bind(registry, name, &wl_seat_interface, 5);
-	}
-}
-
-static void neru_overlay_registry_global_remove(void *data, struct wl_registry *registry, uint32_t name) {
-	// No-op
-}
-
-static const struct wl_registry_listener overlay_registry_listener = {
-    .global = neru_overlay_registry_global,
-    .global_remove = neru_overlay_registry_global_remove,
-};
-
-static void neru_xdg_output_logical_position(void *data, struct zxdg_output_v1 *xdg_output, int32_t x, int32_t y) {
-	NeruWaylandOverlayScreen *scr = (NeruWaylandOverlayScreen *)data;
-	scr->x = x;
-	scr->y = y;
+// Logical-to-buffer scale for scr. Fractional scales need a viewport to map
+// the buffer back onto the logical surface size; without one we fall back to
+// the integer wl_output scale and let the compositor downsample.
+static double neru_screen_scale(const NeruWaylandOverlayScreen *scr) {
+	if (scr->viewport && scr->preferred_scale > 0)
+		return scr->preferred_scale / 120.0;
+	return scr->scale > 0 ? scr->scale : 1;
 }
 
-static void neru_xdg_output_logical_size(void *data, struct zxdg_output_v1 *xdg_output, int32_t w, int32_t h) {
-	NeruWaylandOverlayScreen *scr = (NeruWaylandOverlayScreen *)data;
-	scr->width = w;
-	scr->height = h;
-}
-
-static void neru_xdg_output_done(void *data, struct zxdg_output_v1 *xdg_output) {}
-
-static void neru_xdg_output_name(void *data, struct zxdg_output_v1 *xdg_output, const char *name) {}
-
-static void neru_xdg_output_description(void *data, struct zxdg_output_v1 *xdg_output, const char *description) {}
-
-static const struct zxdg_output_v1_listener xdg_output_listener = {
-    .logical_position = neru_xdg_output_logical_position,
-    .logical_size = neru_xdg_output_logical_size,
-    .done = neru_xdg_output_done,
-    .name = neru_xdg_output_name,
-    .description = neru_xdg_output_description,
-};
-
 // Wayland keyboard listener for key events
 static void neru_keyboard_keymap(void *data, struct wl_keyboard *keyboard, uint32_t format, int32_t fd, uint32_t size) {
 	NeruWaylandOverlay *overlay = (NeruWaylandOverlay *)data;
@@ -232,35 +176,17 @@ static void neru_keyboard_enter(
 static void neru_keyboard_leave(void *data, struct wl_keyboard *keyboard, uint32_t serial, struct wl_surface *surface) {
 }
 
-// Returns a normalized base key name in buf/utf8_buf, or NULL when unknown.
-static const char *neru_keyboard_base_key(
-    NeruWaylandOverlay *overlay, uint32_t key, xkb_keysym_t keysym, char *buf, size_t buf_size, char *utf8_buf,
-    size_t utf8_size) {
-	memset(buf, 0, buf_size);
-	memset(utf8_buf, 0, utf8_size);
-	xkb_keysym_get_name(keysym, buf, buf_size);
-	xkb_state_key_get_utf8(overlay->xkb_state, key + 8, utf8_buf, utf8_size);
-
-	char *final_key = buf;
-
-	if (utf8_buf[0] != '\0' && utf8_buf[1] == '\0' && utf8_buf[0] > 32 && utf8_buf[0] <= 126) {
-		final_key = utf8_buf;
-		if (final_key[0] >= 'A' && final_key[0] <= 'Z') {
-			final_key[0] = final_key[0] + 32;
-		}
-	} else if (buf[0]) {
-		for (size_t i = 0; buf[i]; i++) {
-			if (buf[i] >= 'A' && buf[i] <= 'Z') {
-				buf[i] = buf[i] + 32;
-			}
-		}
-	}
-
-	if (!final_key[0]) {
-		return NULL;
-	}
-
-	return final_key;
+static uint16_t neru_keyboard_mods(struct xkb_state *state) {
+	uint16_t mods = 0;
+	if (xkb_state_mod_name_is_active(state, XKB_MOD_NAME_SHIFT, XKB_STATE_MODS_EFFECTIVE) > 0)
+		mods |= NERU_KEY_MOD_SHIFT;
+	if (xkb_state_mod_name_is_active(state, XKB_MOD_NAME_CTRL, XKB_STATE_MODS_EFFECTIVE) > 0)
+		mods |= NERU_KEY_MOD_CTRL;
+	if (xkb_state_mod_name_is_active(state, XKB_MOD_NAME_ALT, XKB_STATE_MODS_EFFECTIVE) > 0)
+		mods |= NERU_KEY_MOD_ALT;
+	if (xkb_state_mod_name_is_active(state, XKB_MOD_NAME_LOGO, XKB_STATE_MODS_EFFECTIVE) > 0)
+		mods |= NERU_KEY_MOD_LOGO;
+	return mods;
 }
 
 static void neru_keyboard_key(
@@ -268,55 +194,19 @@ static void neru_keyboard_key(
 	NeruWaylandOverlay *overlay = (NeruWaylandOverlay *)data;
 	if (!overlay->xkb_state)
 		return;
-
-	xkb_keysym_t keysym = xkb_state_key_get_one_sym(overlay->xkb_state, key + 8);
-	const char *modifier_name = neru_modifier_name_from_keysym(keysym);
-	if (modifier_name) {
-		char modifier_key[64] = {0};
-		snprintf(
-		    modifier_key, sizeof(modifier_key), "__modifier_%s_%s", modifier_name,
-		    state == WL_KEYBOARD_KEY_STATE_PRESSED ? "down" : "up");
-		neru_key_ring_push(overlay, modifier_key);
-
-		return;
-	}
-
-	char buf[64] = {0};
-	char utf8_buf[64] = {0};
-	const char *final_key = neru_keyboard_base_key(overlay, key, keysym, buf, sizeof(buf), utf8_buf, sizeof(utf8_buf));
-	if (!final_key) {
-		return;
-	}
-
-	if (state == WL_KEYBOARD_KEY_STATE_RELEASED) {
-		char release_key[128] = {0};
-		snprintf(release_key, sizeof(release_key), "__keyup_%s", final_key);
-		neru_key_ring_push(overlay, release_key);
-
+	if (state != WL_KEYBOARD_KEY_STATE_PRESSED && state != WL_KEYBOARD_KEY_STATE_RELEASED)
 		return;
-	}
 
-	if (state != WL_KEYBOARD_KEY_STATE_PRESSED) {
+	NeruKeyEvent event = {
+	    .time_ms = time,
+	    .keycode = key,
+	    .keysym = xkb_state_key_get_one_sym(overlay->xkb_state, key + 8),
+	    .mods = neru_keyboard_mods(overlay->xkb_state),
+	    .pressed = state == WL_KEYBOARD_KEY_STATE_PRESSED,
+	};
+	if (event.keysym == XKB_KEY_NoSymbol)
 		return;
-	}
-
-	char mod_prefix[64] = "";
-	if (xkb_state_mod_name_is_active(overlay->xkb_state, XKB_MOD_NAME_SHIFT, XKB_STATE_MODS_EFFECTIVE) > 0) {
-		strcat(mod_prefix, "Shift+");
-	}
-	if (xkb_state_mod_name_is_active(overlay->xkb_state, XKB_MOD_NAME_CTRL, XKB_STATE_MODS_EFFECTIVE) > 0) {
-		strcat(mod_prefix, "Ctrl+");
-	}
-	if (xkb_state_mod_name_is_active(overlay->xkb_state, XKB_MOD_NAME_ALT, XKB_STATE_MODS_EFFECTIVE) > 0) {
-		strcat(mod_prefix, "Alt+");
-	}
-	if (xkb_state_mod_name_is_active(overlay->xkb_state, XKB_MOD_NAME_LOGO, XKB_STATE_MODS_EFFECTIVE) > 0) {
-		strcat(mod_prefix, "Cmd+");
-	}
-
-	char full_key[128] = {0};
-	snprintf(full_key, sizeof(full_key), "%s%s", mod_prefix, final_key);
-	neru_key_ring_push(overlay, full_key);
+	neru_key_ring_push(overlay, &event);
 }
 
 static void neru_keyboard_modifiers(
@@ -339,25 +229,39 @@ static const struct wl_keyboard_listener keyboard_listener = {
     .repeat_info = neru_keyboard_repeat_info,
 };
 
-// Seat listener to detect keyboard
-static void neru_seat_capabilities(void *data, struct wl_seat *seat, uint32_t capabilities) {
-	NeruWaylandOverlay *overlay = (NeruWaylandOverlay *)data;
-	if (capabilities & WL_SEAT_CAPABILITY_KEYBOARD) {
-		if (!overlay->wl_keyboard) {
-			overlay->wl_keyboard = wl_seat_get_keyboard(seat);
-			if (overlay->wl_keyboard) {
-				wl_keyboard_add_listener(overlay->wl_keyboard, &keyboard_listener, overlay);
-			}
-		}
+// Picks up output changes and keyboard capability from the shared
+// connection. Output i of the connection is always screen i here; new
+// outputs get surfaces on the next setup.
+static void neru_overlay_sync_conn(NeruWaylandOverlay *overlay) {
+	NeruWaylandOutput outputs[NERU_MAX_OUTPUTS];
+	int n = neru_wayland_conn_outputs(overlay->conn, outputs, &overlay->outputs_generation);
+	for (int i = 0; i < n; i++) {
+		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
+		scr->wl_output = outputs[i].wl_output;
+		scr->x = outputs[i].x;
+		scr->y = outputs[i].y;
+		scr->width = outputs[i].width;
+		scr->height = outputs[i].height;
+		scr->scale = outputs[i].scale;
+		scr->label_cache = overlay->label_cache;
+	}
+	if (n >= 0)
+		overlay->nr_screens = n;
+
+	if (!overlay->wl_keyboard && overlay->wl_seat &&
+	    (neru_wayland_conn_seat_capabilities(overlay->conn) & WL_SEAT_CAPABILITY_KEYBOARD)) {
+		overlay->wl_keyboard = wl_seat_get_keyboard(overlay->wl_seat);
+		if (overlay->wl_keyboard)
+			wl_keyboard_add_listener(overlay->wl_keyboard, &keyboard_listener, overlay);
 	}
 }
 
-static void neru_seat_name(void *data, struct wl_seat *seat, const char *name) {}
-
-static const struct wl_seat_listener seat_listener = {
-    .capabilities = neru_seat_capabilities,
-    .name = neru_seat_name,
-};
+// Roundtrip on the overlay queue only; the input client's events stay on
+// its own queue for its dispatch thread.
+static void neru_overlay_roundtrip(NeruWaylandOverlay *overlay) {
+	wl_display_roundtrip_queue(overlay->display, overlay->queue);
+	neru_wayland_conn_dispatch(overlay->conn);
+}
 
 // Buffer release listener - compositor tells us it's done reading a buffer
 static void neru_buffer_release(void *data, struct wl_buffer *wl_buffer) {
@@ -374,6 +278,226 @@ static const struct wl_buffer_listener neru_buffer_listener = {
     .release = neru_buffer_release,
 };
 
+static void neru_badge_buffer_release(void *data, struct wl_buffer *wl_buffer) {
+	NeruWaylandBadge *badge = (NeruWaylandBadge *)data;
+	for (int i = 0; i < NERU_BADGE_BUFFERS; i++) {
+		if (badge->buffers[i] == wl_buffer) {
+			badge->busy[i] = 0;
+			break;
+		}
+	}
+}
+
+static const struct wl_buffer_listener neru_badge_buffer_listener = {
+    .release = neru_badge_buffer_release,
+};
+
+// Frame callback - the compositor is ready for the next frame on this output.
+static void neru_frame_done(void *data, struct wl_callback *callback, uint32_t time_ms) {
+	NeruWaylandOverlayScreen *scr = (NeruWaylandOverlayScreen *)data;
+	if (scr->frame_callback == callback)
+		scr->frame_callback = NULL;
+	wl_callback_destroy(callback);
+}
+
+static const struct wl_callback_listener neru_frame_listener = {
+    .done = neru_frame_done,
+};
+
+typedef struct NeruPresentationFeedback {
+	NeruWaylandOverlay *overlay;
+	struct wp_presentation_feedback *feedback;
+	uint64_t commit_ns;
+	struct NeruPresentationFeedback *next;
+} NeruPresentationFeedback;
+
+static uint64_t neru_presentation_now(NeruWaylandOverlay *overlay) {
+	struct timespec ts;
+	if (clock_gettime((clockid_t)overlay->presentation_clock, &ts) != 0)
+		return 0;
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void neru_presentation_feedback_free(NeruPresentationFeedback *fb) {
+	NeruPresentationFeedback **link = &fb->overlay->feedbacks;
+	while (*link && *link != fb)
+		link = &(*link)->next;
+	if (*link)
+		*link = fb->next;
+	wp_presentation_feedback_destroy(fb->feedback);
+	free(fb);
+}
+
+static void neru_feedback_sync_output(
+    void *data, struct wp_presentation_feedback *feedback, struct wl_output *output) {}
+
+static void neru_feedback_presented(
+    void *data, struct wp_presentation_feedback *feedback, uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec,
+    uint32_t refresh, uint32_t seq_hi, uint32_t seq_lo, uint32_t flags) {
+	NeruPresentationFeedback *fb = (NeruPresentationFeedback *)data;
+	NeruPresentationStats *stats = &fb->overlay->presentation_stats;
+
+	uint64_t sec = ((uint64_t)tv_sec_hi << 32) | tv_sec_lo;
+	uint64_t presented_ns = sec * 1000000000u + tv_nsec;
+	uint64_t latency = presented_ns > fb->commit_ns ? presented_ns - fb->commit_ns : 0;
+
+	stats->presented++;
+	stats->last_latency_ns = latency;
+	stats->total_latency_ns += latency;
+	if (latency > stats->max_latency_ns)
+		stats->max_latency_ns = latency;
+	if (refresh)
+		stats->refresh_ns = refresh;
+
+	neru_presentation_feedback_free(fb);
+}
+
+static void neru_feedback_discarded(void *data, struct wp_presentation_feedback *feedback) {
+	NeruPresentationFeedback *fb = (NeruPresentationFeedback *)data;
+	fb->overlay->presentation_stats.discarded++;
+	neru_presentation_feedback_free(fb);
+}
+
+static const struct wp_presentation_feedback_listener neru_feedback_listener = {
+    .sync_output = neru_feedback_sync_output,
+    .presented = neru_feedback_presented,
+    .discarded = neru_feedback_discarded,
+};
+
+// Requests a frame callback and presentation feedback for the commit that is
+// about to happen on scr. Only damaged commits ask for them: a commit without
+// damage may not be repainted, and its callback could stall the animation.
+static void neru_screen_request_frame(NeruWaylandOverlay *overlay, NeruWaylandOverlayScreen *scr) {
+	if (!scr->frame_callback) {
+		scr->frame_callback = wl_surface_frame(scr->wl_surface);
+		wl_callback_add_listener(scr->frame_callback, &neru_frame_listener, scr);
+	}
+
+	if (!overlay->presentation)
+		return;
+
+	NeruPresentationFeedback *fb = calloc(1, sizeof(NeruPresentationFeedback));
+	if (!fb)
+		return;
+	fb->overlay = overlay;
+	fb->feedback = wp_presentation_feedback(overlay->presentation, scr->wl_surface);
+	fb->commit_ns = neru_presentation_now(overlay);
+	fb->next = overlay->feedbacks;
+	overlay->feedbacks = fb;
+	wp_presentation_feedback_add_listener(fb->feedback, &neru_feedback_listener, fb);
+}
+
+static void neru_screen_cancel_frame(NeruWaylandOverlayScreen *scr) {
+	if (scr->frame_callback) {
+		wl_callback_destroy(scr->frame_callback);
+		scr->frame_callback = NULL;
+	}
+}
+
+// Destroys the SHM pool and cairo contexts of one output.
+static void neru_screen_release_buffers(NeruWaylandOverlayScreen *scr) {
+	for (int b = 0; b < scr->num_buffers; b++) {
+		if (scr->crs[b])
+			cairo_destroy(scr->crs[b]);
+		if (scr->cairo_surfaces[b])
+			cairo_surface_destroy(scr->cairo_surfaces[b]);
+		if (scr->buffers[b])
+			wl_buffer_destroy(scr->buffers[b]);
+		if (scr->shm_datas[b])
+			munmap(scr->shm_datas[b], scr->shm_sizes[b]);
+		scr->crs[b] = NULL;
+		scr->cairo_surfaces[b] = NULL;
+		scr->buffers[b] = NULL;
+		scr->shm_datas[b] = NULL;
+		scr->shm_sizes[b] = 0;
+		scr->busy[b] = 0;
+	}
+	scr->num_buffers = 0;
+	// Reset current pointers
+	scr->buffer = NULL;
+	scr->cairo_surface = NULL;
+	scr->cr = NULL;
+	scr->shm_data = NULL;
+	scr->shm_size = 0;
+	scr->current_buffer = -1;
+	scr->front_buffer = -1;
+}
+
+// Destroys the layer surface and wl_surface of one output.
+static void neru_screen_release_surface(NeruWaylandOverlayScreen *scr) {
+	neru_screen_cancel_frame(scr);
+	if (scr->fractional_scale) {
+		wp_fractional_scale_v1_destroy(scr->fractional_scale);
+		scr->fractional_scale = NULL;
+	}
+	if (scr->viewport) {
+		wp_viewport_destroy(scr->viewport);
+		scr->viewport = NULL;
+	}
+	if (scr->layer_surface) {
+		zwlr_layer_surface_v1_destroy(scr->layer_surface);
+		scr->layer_surface = NULL;
+	}
+	if (scr->wl_surface) {
+		wl_surface_destroy(scr->wl_surface);
+		scr->wl_surface = NULL;
+	}
+	scr->configured = 0;
+	scr->closed = 0;
+	scr->preferred_scale = 0;
+}
+
+static void neru_badge_release_buffers(NeruWaylandBadge *badge) {
+	for (int b = 0; b < NERU_BADGE_BUFFERS; b++) {
+		if (badge->buffers[b])
+			wl_buffer_destroy(badge->buffers[b]);
+		if (badge->shm_datas[b])
+			munmap(badge->shm_datas[b], badge->shm_size);
+		badge->buffers[b] = NULL;
+		badge->shm_datas[b] = NULL;
+		badge->busy[b] = 0;
+	}
+	badge->shm_size = 0;
+	badge->buf_width = 0;
+	badge->buf_height = 0;
+	badge->front = -1;
+	badge->has_content = 0;
+}
+
+// Destroys a badge subsurface and its buffers; the next draw recreates them.
+// Must run before the parent output's wl_surface is destroyed.
+static void neru_badge_release(NeruWaylandBadge *badge) {
+	neru_badge_release_buffers(badge);
+	free(badge->text);
+	free(badge->font_family);
+	badge->text = badge->font_family = NULL;
+	badge->text_len = badge->text_cap = 0;
+	badge->font_family_len = badge->font_family_cap = 0;
+	if (badge->viewport) {
+		wp_viewport_destroy(badge->viewport);
+		badge->viewport = NULL;
+	}
+	if (badge->subsurface) {
+		wl_subsurface_destroy(badge->subsurface);
+		badge->subsurface = NULL;
+	}
+	if (badge->wl_surface) {
+		wl_surface_destroy(badge->wl_surface);
+		badge->wl_surface = NULL;
+	}
+	badge->screen = -1;
+	badge->mapped = 0;
+}
+
+// Releases the badges parented to output screen, or all of them when screen < 0.
+static void neru_overlay_release_badges(NeruWaylandOverlay *overlay, int screen) {
+	for (int i = 0; i < NERU_BADGE_SLOTS; i++) {
+		NeruWaylandBadge *badge = &overlay->badges[i];
+		if (screen < 0 || badge->screen == screen)
+			neru_badge_release(badge);
+	}
+}
+
 NeruWaylandOverlay *neru_wayland_overlay_new(void) {
 	NeruWaylandOverlay *overlay = calloc(1, sizeof(NeruWaylandOverlay));
 	if (!overlay)
@@ -382,93 +506,182 @@ NeruWaylandOverlay *neru_wayland_overlay_new(void) {
 	// EXCLUSIVE by default for keyboard capture fallback
 	// SetKeyboardCaptureEnabled can change it to NONE when not needed
 	overlay->keyboard_interactivity_set = ZWLR_LAYER_SURFACE_V1_KEYBOARD_INTERACTIVITY_EXCLUSIVE;
+	overlay->event_fd = -1;
+	for (int i = 0; i < NERU_BADGE_SLOTS; i++) {
+		overlay->badges[i].screen = -1;
+		overlay->badges[i].front = -1;
+	}
+	overlay->standby_enabled = 1;
+	overlay->standby_max_bytes = NERU_STANDBY_DEFAULT_MAX_BYTES;
 
-	overlay->display = wl_display_connect(NULL);
-	if (!overlay->display) {
+	// Globals and output geometry are already known when the input client
+	// connected first, so this costs no roundtrip then.
+	NeruWaylandConn *conn = neru_wayland_conn_acquire();
+	if (!conn) {
 		free(overlay);
 		return NULL;
 	}
-
-	overlay->registry = wl_display_get_registry(overlay->display);
-	wl_registry_add_listener(overlay->registry, &overlay_registry_listener, overlay);
-	wl_display_roundtrip(overlay->display);  // get globals
-
-	if (!overlay->compositor || !overlay->layer_shell || !overlay->shm || !overlay->xdg_output_mgr) {
-		wl_display_disconnect(overlay->display);
+	if (!conn->compositor || !conn->layer_shell || !conn->shm || !conn->xdg_output_mgr) {
+		neru_wayland_conn_release(conn);
 		free(overlay);
 		return NULL;
 	}
-
-	for (int i = 0; i < overlay->nr_screens; i++) {
-		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
-		scr->xdg_output = zxdg_output_manager_v1_get_xdg_output(overlay->xdg_output_mgr, scr->wl_output);
-		zxdg_output_v1_add_listener(scr->xdg_output, &xdg_output_listener, scr);
-	}
-	wl_display_roundtrip(overlay->display);  // get screen sizes
-
-	// Setup seat listener for keyboard
-	if (overlay->wl_seat) {
-		wl_seat_add_listener(overlay->wl_seat, &seat_listener, overlay);
-		wl_display_roundtrip(overlay->display);
-	}
+	overlay->conn = conn;
+	overlay->display = conn->display;
+	overlay->presentation_clock = conn->presentation_clock;
+
+	overlay->queue = wl_display_create_queue(overlay->display);
+	overlay->compositor = neru_wayland_conn_wrap(conn->compositor, overlay->queue);
+	overlay->subcompositor = neru_wayland_conn_wrap(conn->subcompositor, overlay->queue);
+	overlay->shm = neru_wayland_conn_wrap(conn->shm, overlay->queue);
+	overlay->layer_shell = neru_wayland_conn_wrap(conn->layer_shell, overlay->queue);
+	overlay->wl_seat = neru_wayland_conn_wrap(conn->seat, overlay->queue);
+	overlay->fractional_scale_mgr = neru_wayland_conn_wrap(conn->fractional_scale_mgr, overlay->queue);
+	overlay->viewporter = neru_wayland_conn_wrap(conn->viewporter, overlay->queue);
+	overlay->presentation = neru_wayland_conn_wrap(conn->presentation, overlay->queue);
+
+	// Wakes the keyboard poller out of poll() for shutdown and for keys the
+	// render path dispatched on its behalf.
+	overlay->event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+	// Created before the first output sync so every screen picks it up.
+	overlay->label_cache = neru_label_cache_new(NERU_LABEL_CACHE_CAPACITY);
 
 	// Setup xkb context
 	overlay->xkb_ctx = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
 
-	// Try to get keyboard immediately and set up listener
-	if (overlay->wl_seat) {
-		struct wl_keyboard *kb = wl_seat_get_keyboard(overlay->wl_seat);
-		if (kb) {
-			wl_keyboard_add_listener(kb, &keyboard_listener, overlay);
-		}
-	}
-
+	neru_overlay_sync_conn(overlay);
 	return overlay;
 }
 
+static void neru_overlay_unwrap(void *wrapper) {
+	if (wrapper)
+		wl_proxy_wrapper_destroy(wrapper);
+}
+
 void neru_wayland_overlay_destroy(NeruWaylandOverlay *overlay) {
 	if (!overlay)
 		return;
 
+	neru_overlay_release_badges(overlay, -1);
 	for (int i = 0; i < overlay->nr_screens; i++) {
 		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
-		for (int b = 0; b < scr->num_buffers; b++) {
-			if (scr->crs[b])
-				cairo_destroy(scr->crs[b]);
-			if (scr->cairo_surfaces[b])
-				cairo_surface_destroy(scr->cairo_surfaces[b]);
-			if (scr->buffers[b])
-				wl_buffer_destroy(scr->buffers[b]);
-			if (scr->shm_datas[b])
-				munmap(scr->shm_datas[b], scr->shm_sizes[b]);
-		}
-		scr->num_buffers = 0;
-		if (scr->layer_surface)
-			zwlr_layer_surface_v1_destroy(scr->layer_surface);
-		if (scr->wl_surface)
-			wl_surface_destroy(scr->wl_surface);
-		if (scr->xdg_output)
-			zxdg_output_v1_destroy(scr->xdg_output);
+		neru_screen_release_buffers(scr);
+		neru_screen_release_surface(scr);
 	}
 
+	while (overlay->feedbacks)
+		neru_presentation_feedback_free(overlay->feedbacks);
+	// The connection outlives the overlay when the input client still uses
+	// it, so the keyboard is released rather than left sending events.
+	if (overlay->wl_keyboard) {
+		if (wl_keyboard_get_version(overlay->wl_keyboard) >= WL_KEYBOARD_RELEASE_SINCE_VERSION)
+			wl_keyboard_release(overlay->wl_keyboard);
+		else
+			wl_keyboard_destroy(overlay->wl_keyboard);
+	}
 	if (overlay->xkb_state)
 		xkb_state_unref(overlay->xkb_state);
 	if (overlay->xkb_ctx)
 		xkb_context_unref(overlay->xkb_ctx);
-	if (overlay->xdg_output_mgr)
-		zxdg_output_manager_v1_destroy(overlay->xdg_output_mgr);
-	if (overlay->layer_shell)
-		zwlr_layer_shell_v1_destroy(overlay->layer_shell);
-	if (overlay->registry)
-		wl_registry_destroy(overlay->registry);
-	if (overlay->display)
-		wl_display_disconnect(overlay->display);
+
+	neru_overlay_unwrap(overlay->compositor);
+	neru_overlay_unwrap(overlay->subcompositor);
+	neru_overlay_unwrap(overlay->shm);
+	neru_overlay_unwrap(overlay->layer_shell);
+	neru_overlay_unwrap(overlay->wl_seat);
+	neru_overlay_unwrap(overlay->fractional_scale_mgr);
+	neru_overlay_unwrap(overlay->viewporter);
+	neru_overlay_unwrap(overlay->presentation);
+	wl_display_flush(overlay->display);
+	wl_event_queue_destroy(overlay->queue);
+	neru_wayland_conn_release(overlay->conn);
+
+	if (overlay->event_fd >= 0)
+		close(overlay->event_fd);
+	neru_label_cache_destroy(overlay->label_cache);
+	free(overlay->submit_bounds);
+	free(overlay->submit_bin);
 	free(overlay);
 }
 
+void neru_wayland_overlay_conn_stats(NeruWaylandOverlay *overlay, NeruWaylandConnStats *stats) {
+	if (!overlay || !stats)
+		return;
+	neru_wayland_conn_stats(overlay->conn, stats);
+}
+
+static int neru_damage_empty(const NeruDamageRect *r) { return r->x2 <= r->x1 || r->y2 <= r->y1; }
+
+static void neru_damage_union(NeruDamageRect *dst, const NeruDamageRect *src) {
+	if (neru_damage_empty(src))
+		return;
+	if (neru_damage_empty(dst)) {
+		*dst = *src;
+		return;
+	}
+	if (src->x1 < dst->x1)
+		dst->x1 = src->x1;
+	if (src->y1 < dst->y1)
+		dst->y1 = src->y1;
+	if (src->x2 > dst->x2)
+		dst->x2 = src->x2;
+	if (src->y2 > dst->y2)
+		dst->y2 = src->y2;
+}
+
+static void neru_damage_clip(NeruDamageRect *r, int width, int height) {
+	if (r->x1 < 0)
+		r->x1 = 0;
+	if (r->y1 < 0)
+		r->y1 = 0;
+	if (r->x2 > width)
+		r->x2 = width;
+	if (r->y2 > height)
+		r->y2 = height;
+}
+
+// Converts a logical, screen-local rectangle to buffer pixels, grown by pad
+// logical pixels to cover strokes and antialiasing, and records it as both
+// damage and content of the current frame.
+static void neru_screen_add_damage(
+    NeruWaylandOverlayScreen *scr, double x, double y, double width, double height, double pad) {
+	double scale = scr->buf_scale > 0 ? scr->buf_scale : 1.0;
+	NeruDamageRect r = {
+	    .x1 = (int)((x - pad) * scale) - 1,
+	    .y1 = (int)((y - pad) * scale) - 1,
+	    .x2 = (int)((x + width + pad) * scale) + 2,
+	    .y2 = (int)((y + height + pad) * scale) + 2,
+	};
+	neru_damage_clip(&r, scr->buf_width, scr->buf_height);
+	if (neru_damage_empty(&r))
+		return;
+	neru_damage_union(&scr->damage, &r);
+	neru_damage_union(&scr->content, &r);
+}
+
+// Copies the rows of r from buffer src to buffer dst so that dst matches the
+// front buffer before new primitives are drawn on top of it.
+static void neru_screen_copy_forward(NeruWaylandOverlayScreen *scr, int src, int dst, const NeruDamageRect *r) {
+	if (neru_damage_empty(r) || !scr->shm_datas[src] || !scr->shm_datas[dst])
+		return;
+
+	cairo_surface_flush(scr->cairo_surfaces[src]);
+	cairo_surface_flush(scr->cairo_surfaces[dst]);
+
+	size_t offset = (size_t)r->x1 * 4u;
+	size_t len = (size_t)(r->x2 - r->x1) * 4u;
+	for (int row = r->y1; row < r->y2; row++) {
+		size_t line = (size_t)row * (size_t)scr->stride;
+		memcpy((char *)scr->shm_datas[dst] + line + offset, (char *)scr->shm_datas[src] + line + offset, len);
+	}
+
+	cairo_surface_mark_dirty_rectangle(scr->cairo_surfaces[dst], r->x1, r->y1, r->x2 - r->x1, r->y2 - r->y1);
+}
+
 static int neru_create_single_buffer(
     NeruWaylandOverlay *overlay, NeruWaylandOverlayScreen *scr, int buf_idx, int buf_width, int buf_height, int stride,
-    int scale) {
+    double scale) {
 	size_t buf_size = (size_t)stride * (size_t)buf_height;
 	int fd = create_shm_file(buf_size);
 	if (fd < 0)
@@ -501,11 +714,24 @@ static int neru_create_single_buffer(
 void neru_wayland_overlay_setup_buffers(NeruWaylandOverlay *overlay) {
 	int new_surfaces = 0;
 
+	neru_overlay_sync_conn(overlay);
+
 	for (int i = 0; i < overlay->nr_screens; i++) {
 		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
 
-		if (scr->layer_surface)
-			continue;  // Already configured
+		if (scr->closed) {
+			neru_overlay_release_badges(overlay, i);
+			neru_screen_release_buffers(scr);
+			neru_screen_release_surface(scr);
+		}
+
+		if (scr->layer_surface) {
+			// A standby surface re-arms its configure on hide; that event is
+			// normally dispatched by the poller long before the next show.
+			if (!scr->configured)
+				new_surfaces = 1;
+			continue;
+		}
 
 		// Skip if dimensions aren't set yet
 		if (scr->width <= 0 || scr->height <= 0)
@@ -534,6 +760,16 @@ void neru_wayland_overlay_setup_buffers(NeruWaylandOverlay *overlay) {
 		zwlr_layer_surface_v1_set_keyboard_interactivity(scr->layer_surface, overlay->keyboard_interactivity_set);
 
 		zwlr_layer_surface_v1_add_listener(scr->layer_surface, &layer_surface_listener, overlay);
+
+		// Both are needed for fractional rendering: the preferred scale sizes
+		// the buffer and the viewport maps it back onto the logical surface.
+		if (overlay->fractional_scale_mgr && overlay->viewporter) {
+			scr->viewport = wp_viewporter_get_viewport(overlay->viewporter, scr->wl_surface);
+			scr->fractional_scale =
+			    wp_fractional_scale_manager_v1_get_fractional_scale(overlay->fractional_scale_mgr, scr->wl_surface);
+			wp_fractional_scale_v1_add_listener(scr->fractional_scale, &fractional_scale_listener, scr);
+		}
+
 		wl_surface_commit(scr->wl_surface);
 
 		new_surfaces = 1;
@@ -541,17 +777,23 @@ void neru_wayland_overlay_setup_buffers(NeruWaylandOverlay *overlay) {
 
 	// Only roundtrip when new surfaces were created (avoids sync delay on every draw).
 	if (new_surfaces) {
-		wl_display_roundtrip(overlay->display);
+		neru_overlay_roundtrip(overlay);
 	}
 
 	for (int i = 0; i < overlay->nr_screens; i++) {
 		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
-		if (scr->num_buffers > 0)
-			continue;
+		double scale = neru_screen_scale(scr);
+		// Round half away from zero, as wp_fractional_scale_v1 specifies.
+		int buf_width = (int)(scr->width * scale + 0.5);
+		int buf_height = (int)(scr->height * scale + 0.5);
+
+		if (scr->num_buffers > 0) {
+			if (scr->buf_width == buf_width && scr->buf_height == buf_height && scr->buf_scale == scale)
+				continue;
+			// The output was resized or rescaled while the pool sat in standby.
+			neru_screen_release_buffers(scr);
+		}
 
-		int scale = scr->scale > 0 ? scr->scale : 1;
-		int buf_width = scr->width * scale;
-		int buf_height = scr->height * scale;
 		size_t stride = ((size_t)buf_width) * 4u;
 
 		int ok = 0;
@@ -560,6 +802,20 @@ void neru_wayland_overlay_setup_buffers(NeruWaylandOverlay *overlay) {
 				ok++;
 		}
 		scr->num_buffers = ok;
+		scr->buf_width = buf_width;
+		scr->buf_height = buf_height;
+		scr->buf_scale = scale;
+		scr->stride = (int)stride;
+
+		// Fresh SHM is zero-filled (fully transparent), so every buffer already
+		// matches and only the first commit needs full damage.
+		NeruDamageRect full = {0, 0, buf_width, buf_height};
+		NeruDamageRect none = {0, 0, 0, 0};
+		scr->damage = full;
+		scr->content = none;
+		for (int b = 0; b < NERU_NUM_BUFFERS; b++)
+			scr->stale[b] = none;
+		scr->front_buffer = -1;
 
 		if (ok > 0) {
 			// Point current pointers to buffer 0
@@ -571,8 +827,13 @@ void neru_wayland_overlay_setup_buffers(NeruWaylandOverlay *overlay) {
 			scr->shm_size = scr->shm_sizes[0];
 		}
 
-		if (scr->wl_surface)
-			wl_surface_set_buffer_scale(scr->wl_surface, scale);
+		if (scr->viewport) {
+			// Buffer scale must stay 1 when a viewport sets the destination.
+			wl_surface_set_buffer_scale(scr->wl_surface, 1);
+			wp_viewport_set_destination(scr->viewport, scr->width, scr->height);
+		} else if (scr->wl_surface) {
+			wl_surface_set_buffer_scale(scr->wl_surface, (int)scale);
+		}
 	}
 }
 
@@ -582,64 +843,146 @@ void neru_wayland_overlay_show(NeruWaylandOverlay *overlay) {
 	for (int i = 0; i < overlay->nr_screens; i++) {
 		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
 		if (scr->wl_surface && scr->buffer) {
+			if (neru_damage_empty(&scr->damage) && scr->current_buffer == scr->front_buffer) {
+				// Nothing was drawn: commit without re-attaching so the
+				// compositor keeps the front buffer and only applies
+				// subsurface (badge) positions.
+				wl_surface_commit(scr->wl_surface);
+				overlay->visible = 1;
+				continue;
+			}
 			wl_surface_attach(scr->wl_surface, scr->buffer, 0, 0);
-			wl_surface_damage_buffer(scr->wl_surface, 0, 0, INT32_MAX, INT32_MAX);
+			if (!neru_damage_empty(&scr->damage)) {
+				wl_surface_damage_buffer(
+				    scr->wl_surface, scr->damage.x1, scr->damage.y1, scr->damage.x2 - scr->damage.x1,
+				    scr->damage.y2 - scr->damage.y1);
+				neru_screen_request_frame(overlay, scr);
+			}
 			wl_surface_commit(scr->wl_surface);
 			// Mark the committed buffer as busy (compositor owns it now)
 			if (scr->current_buffer >= 0) {
 				scr->busy[scr->current_buffer] = 1;
+				// Every other buffer now lags behind by this frame's damage.
+				for (int b = 0; b < scr->num_buffers; b++) {
+					if (b != scr->current_buffer)
+						neru_damage_union(&scr->stale[b], &scr->damage);
+				}
+				scr->front_buffer = scr->current_buffer;
 			}
+			scr->damage = (NeruDamageRect){0, 0, 0, 0};
+			overlay->visible = 1;
 		}
 	}
 	wl_display_flush(overlay->display);
 }
 
+size_t neru_wayland_overlay_pool_bytes(NeruWaylandOverlay *overlay) {
+	if (!overlay)
+		return 0;
+	size_t total = 0;
+	for (int i = 0; i < overlay->nr_screens; i++) {
+		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
+		for (int b = 0; b < scr->num_buffers; b++)
+			total += scr->shm_sizes[b];
+	}
+	return total;
+}
+
+int neru_wayland_overlay_is_visible(NeruWaylandOverlay *overlay) { return overlay ? overlay->visible : 0; }
+
+int neru_wayland_overlay_is_warm(NeruWaylandOverlay *overlay) {
+	if (!overlay)
+		return 0;
+	for (int i = 0; i < overlay->nr_screens; i++) {
+		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
+		if (scr->layer_surface && scr->num_buffers > 0 && !scr->closed)
+			return 1;
+	}
+	return 0;
+}
+
+void neru_wayland_overlay_set_standby(NeruWaylandOverlay *overlay, int enabled, size_t max_bytes) {
+	if (!overlay)
+		return;
+	overlay->standby_enabled = enabled;
+	overlay->standby_max_bytes = max_bytes;
+}
+
+// Makes every kept buffer transparent again, so a show after standby starts
+// from an empty surface like a fresh pool would. Buffer b can only hold pixels
+// inside what was drawn since the last clear or where it lags the others.
+static void neru_screen_wipe_buffers(NeruWaylandOverlayScreen *scr) {
+	for (int b = 0; b < scr->num_buffers; b++) {
+		NeruDamageRect r = scr->content;
+		neru_damage_union(&r, &scr->stale[b]);
+		if (scr->crs[b] && !neru_damage_empty(&r)) {
+			cairo_save(scr->crs[b]);
+			cairo_identity_matrix(scr->crs[b]);
+			cairo_set_operator(scr->crs[b], CAIRO_OPERATOR_CLEAR);
+			cairo_rectangle(scr->crs[b], r.x1, r.y1, r.x2 - r.x1, r.y2 - r.y1);
+			cairo_fill(scr->crs[b]);
+			cairo_restore(scr->crs[b]);
+		}
+		scr->stale[b] = (NeruDamageRect){0, 0, 0, 0};
+	}
+	scr->content = (NeruDamageRect){0, 0, 0, 0};
+}
+
 void neru_wayland_overlay_hide(NeruWaylandOverlay *overlay) {
 	if (!overlay)
 		return;
+
+	// Badges are tiny; recreate them on the next activation rather than
+	// tracking their state across an unmapped parent.
+	neru_overlay_release_badges(overlay, -1);
+
+	size_t pool_bytes = neru_wayland_overlay_pool_bytes(overlay);
+	int keep =
+	    overlay->standby_enabled && (overlay->standby_max_bytes == 0 || pool_bytes <= overlay->standby_max_bytes);
+
 	for (int i = 0; i < overlay->nr_screens; i++) {
 		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
+		// An unmapped surface is not repainted, so its callback may never fire.
+		neru_screen_cancel_frame(scr);
 		if (scr->wl_surface) {
+			// Attaching a NULL buffer unmaps the layer surface.
 			wl_surface_attach(scr->wl_surface, NULL, 0, 0);
 			wl_surface_commit(scr->wl_surface);
 		}
-		// Destroy layer surface to allow proper recreation on next show
-		if (scr->layer_surface) {
-			zwlr_layer_surface_v1_destroy(scr->layer_surface);
-			scr->layer_surface = NULL;
-		}
-		// Also destroy the surface
-		if (scr->wl_surface) {
-			wl_surface_destroy(scr->wl_surface);
-			scr->wl_surface = NULL;
-		}
-		// Destroy all buffers and cairo
-		for (int b = 0; b < scr->num_buffers; b++) {
-			if (scr->crs[b])
-				cairo_destroy(scr->crs[b]);
-			if (scr->cairo_surfaces[b])
-				cairo_surface_destroy(scr->cairo_surfaces[b]);
-			if (scr->buffers[b])
-				wl_buffer_destroy(scr->buffers[b]);
-			if (scr->shm_datas[b])
-				munmap(scr->shm_datas[b], scr->shm_sizes[b]);
-			scr->crs[b] = NULL;
-			scr->cairo_surfaces[b] = NULL;
-			scr->buffers[b] = NULL;
-			scr->shm_datas[b] = NULL;
-			scr->shm_sizes[b] = 0;
-			scr->busy[b] = 0;
+
+		if (keep && scr->layer_surface) {
+			// Warm standby: keep the surface and SHM pool. An unmapped layer
+			// surface is back in its initial state, so commit once more to get
+			// the configure the next map needs while we are still hidden. The
+			// compositor dropped our contents, so the next commit is full. The
+			// buffers are wiped so a Show without a Clear stays empty, as it
+			// was with a fresh pool.
+			scr->configured = 0;
+			wl_surface_commit(scr->wl_surface);
+			neru_screen_wipe_buffers(scr);
+			scr->damage = (NeruDamageRect){0, 0, scr->buf_width, scr->buf_height};
+			continue;
 		}
-		scr->num_buffers = 0;
-		// Reset current pointers
-		scr->buffer = NULL;
-		scr->cairo_surface = NULL;
-		scr->cr = NULL;
-		scr->shm_data = NULL;
-		scr->shm_size = 0;
-		scr->current_buffer = -1;
+
+		neru_screen_release_buffers(scr);
+		neru_screen_release_surface(scr);
+	}
+	overlay->visible = 0;
+	wl_display_flush(overlay->display);
+}
+
+size_t neru_wayland_overlay_release_standby(NeruWaylandOverlay *overlay) {
+	if (!overlay || overlay->visible)
+		return 0;
+
+	size_t released = neru_wayland_overlay_pool_bytes(overlay);
+	for (int i = 0; i < overlay->nr_screens; i++) {
+		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
+		neru_screen_release_buffers(scr);
+		neru_screen_release_surface(scr);
 	}
 	wl_display_flush(overlay->display);
+	return released;
 }
 
 void neru_wayland_overlay_set_keyboard_capture(NeruWaylandOverlay *overlay, int enabled) {
@@ -658,21 +1001,57 @@ void neru_wayland_overlay_set_keyboard_capture(NeruWaylandOverlay *overlay, int
 		wl_surface_commit(scr->wl_surface);
 	}
 
-	wl_display_roundtrip(overlay->display);
+	neru_overlay_roundtrip(overlay);
+}
+
+static void neru_screen_clear(NeruWaylandOverlayScreen *scr) {
+	if (!scr->cr || neru_damage_empty(&scr->content))
+		return;
+
+	// Only the previously drawn bounds hold pixels; the rest of the
+	// buffer is already transparent.
+	NeruDamageRect r = scr->content;
+	cairo_save(scr->cr);
+	cairo_identity_matrix(scr->cr);
+	cairo_set_operator(scr->cr, CAIRO_OPERATOR_CLEAR);
+	cairo_rectangle(scr->cr, r.x1, r.y1, r.x2 - r.x1, r.y2 - r.y1);
+	cairo_fill(scr->cr);
+	cairo_restore(scr->cr);
+
+	neru_damage_union(&scr->damage, &r);
+	scr->content = (NeruDamageRect){0, 0, 0, 0};
+}
+
+// Rejects primitives whose global bounds miss this output entirely, before
+// any cairo path or text-extents work is done for it.
+static int neru_screen_intersects(const NeruWaylandOverlayScreen *scr, double x1, double y1, double x2, double y2) {
+	return x1 < scr->x + scr->width && x2 > scr->x && y1 < scr->y + scr->height && y2 > scr->y;
+}
+
+static void neru_screen_clear_rect(NeruWaylandOverlayScreen *scr, double x, double y, double width, double height) {
+	if (!scr->cr || width <= 0 || height <= 0)
+		return;
+
+	double scr_x = x - scr->x;
+	double scr_y = y - scr->y;
+
+	cairo_t *cr = scr->cr;
+	cairo_save(cr);
+	cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+	cairo_rectangle(cr, scr_x, scr_y, width, height);
+	cairo_fill(cr);
+	cairo_restore(cr);
+
+	NeruDamageRect saved = scr->content;
+	neru_screen_add_damage(scr, scr_x, scr_y, width, height, 0);
+	scr->content = saved;
 }
 
 void neru_wayland_overlay_clear(NeruWaylandOverlay *overlay) {
 	if (!overlay)
 		return;
-	for (int i = 0; i < overlay->nr_screens; i++) {
-		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
-		if (scr->cr) {
-			cairo_save(scr->cr);
-			cairo_set_operator(scr->cr, CAIRO_OPERATOR_CLEAR);
-			cairo_paint(scr->cr);
-			cairo_restore(scr->cr);
-		}
-	}
+	for (int i = 0; i < overlay->nr_screens; i++)
+		neru_screen_clear(&overlay->screens[i]);
 }
 
 void neru_wayland_overlay_clear_rect(NeruWaylandOverlay *overlay, double x, double y, double width, double height) {
@@ -680,18 +1059,8 @@ void neru_wayland_overlay_clear_rect(NeruWaylandOverlay *overlay, double x, doub
 		return;
 	for (int i = 0; i < overlay->nr_screens; i++) {
 		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
-		if (!scr->cr)
-			continue;
-
-		double scr_x = x - scr->x;
-		double scr_y = y - scr->y;
-
-		cairo_t *cr = scr->cr;
-		cairo_save(cr);
-		cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
-		cairo_rectangle(cr, scr_x, scr_y, width, height);
-		cairo_fill(cr);
-		cairo_restore(cr);
+		if (neru_screen_intersects(scr, x, y, x + width, y + height))
+			neru_screen_clear_rect(scr, x, y, width, height);
 	}
 }
 
@@ -700,7 +1069,132 @@ void neru_wayland_overlay_flush(NeruWaylandOverlay *overlay) { neru_wayland_over
 void neru_wayland_overlay_sync(NeruWaylandOverlay *overlay) {
 	if (!overlay || !overlay->display)
 		return;
-	wl_display_roundtrip(overlay->display);
+	neru_overlay_roundtrip(overlay);
+}
+
+static int neru_frames_done(NeruWaylandOverlay *overlay) {
+	for (int i = 0; i < overlay->nr_screens; i++) {
+		if (overlay->screens[i].frame_callback)
+			return 0;
+	}
+	return 1;
+}
+
+static int neru_buffer_free(NeruWaylandOverlay *overlay) { return neru_wayland_overlay_available_buffer(overlay) >= 0; }
+
+static int64_t neru_monotonic_ms(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Blocks on the display fd, dispatching events, until done(overlay) holds.
+// Uses the prepare_read protocol so it can share the connection with the
+// keyboard poller and the input client's dispatch thread.
+static int neru_dispatch_until(NeruWaylandOverlay *overlay, int (*done)(NeruWaylandOverlay *), int timeout_ms) {
+	if (!overlay || !overlay->display)
+		return -1;
+
+	struct wl_display *display = overlay->display;
+	int64_t deadline = neru_monotonic_ms() + timeout_ms;
+
+	while (!done(overlay)) {
+		while (wl_display_prepare_read_queue(display, overlay->queue) != 0) {
+			if (wl_display_dispatch_queue_pending(display, overlay->queue) < 0)
+				return -1;
+		}
+		if (done(overlay)) {
+			wl_display_cancel_read(display);
+			return 1;
+		}
+
+		wl_display_flush(display);
+
+		int remaining = (int)(deadline - neru_monotonic_ms());
+		if (remaining <= 0) {
+			wl_display_cancel_read(display);
+			return 0;
+		}
+
+		struct pollfd pfd = {.fd = wl_display_get_fd(display), .events = POLLIN, .revents = 0};
+		int ret = poll(&pfd, 1, remaining);
+		if (ret > 0 && (pfd.revents & POLLIN)) {
+			if (wl_display_read_events(display) < 0)
+				return -1;
+		} else {
+			wl_display_cancel_read(display);
+			if (ret < 0 && errno != EINTR)
+				return -1;
+			if (ret > 0)
+				return -1;  // POLLERR / POLLHUP
+		}
+
+		if (wl_display_dispatch_queue_pending(display, overlay->queue) < 0 ||
+		    neru_wayland_conn_dispatch(overlay->conn) < 0)
+			return -1;
+	}
+	return 1;
+}
+
+int neru_wayland_overlay_wait_buffer(NeruWaylandOverlay *overlay, int timeout_ms) {
+	return neru_dispatch_until(overlay, neru_buffer_free, timeout_ms);
+}
+
+int neru_wayland_overlay_prepare_frame_wait(NeruWaylandOverlay *overlay) {
+	if (!overlay || !overlay->display)
+		return -1;
+
+	struct wl_display *display = overlay->display;
+	if (neru_wayland_conn_dispatch(overlay->conn) < 0)
+		return -1;
+	while (wl_display_prepare_read_queue(display, overlay->queue) != 0) {
+		if (wl_display_dispatch_queue_pending(display, overlay->queue) < 0)
+			return -1;
+	}
+
+	if (neru_frames_done(overlay)) {
+		wl_display_cancel_read(display);
+		return 1;
+	}
+
+	if (wl_display_flush(display) < 0 && errno != EAGAIN) {
+		wl_display_cancel_read(display);
+		return -1;
+	}
+	return 0;
+}
+
+// Unlike neru_wayland_overlay_wait this leaves the wakeup eventfd alone: it
+// belongs to the keyboard poller, which must see a stop request.
+int neru_wayland_overlay_wait_display(NeruWaylandOverlay *overlay, int timeout_ms) {
+	struct wl_display *display = overlay->display;
+	struct pollfd pfd = {.fd = wl_display_get_fd(display), .events = POLLIN, .revents = 0};
+
+	int ret;
+	do {
+		ret = poll(&pfd, 1, timeout_ms);
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret > 0 && (pfd.revents & POLLIN)) {
+		if (wl_display_read_events(display) < 0)
+			return -1;
+		return 1;
+	}
+	wl_display_cancel_read(display);
+	if (ret < 0 || (pfd.revents & (POLLERR | POLLHUP)))
+		return -1;
+	return 0;
+}
+
+void neru_wayland_overlay_presentation_stats(NeruWaylandOverlay *overlay, NeruPresentationStats *stats, int reset) {
+	if (!overlay || !stats)
+		return;
+	*stats = overlay->presentation_stats;
+	if (reset) {
+		uint32_t refresh_ns = overlay->presentation_stats.refresh_ns;
+		overlay->presentation_stats = (NeruPresentationStats){0};
+		overlay->presentation_stats.refresh_ns = refresh_ns;
+	}
 }
 
 void neru_wayland_overlay_select_buffer(NeruWaylandOverlay *overlay, int index) {
@@ -710,6 +1204,10 @@ void neru_wayland_overlay_select_buffer(NeruWaylandOverlay *overlay, int index)
 		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
 		if (index < 0 || index >= scr->num_buffers)
 			continue;
+		if (scr->front_buffer >= 0 && scr->front_buffer != index) {
+			neru_screen_copy_forward(scr, scr->front_buffer, index, &scr->stale[index]);
+		}
+		scr->stale[index] = (NeruDamageRect){0, 0, 0, 0};
 		scr->buffer = scr->buffers[index];
 		scr->cairo_surface = scr->cairo_surfaces[index];
 		scr->cr = scr->crs[index];
@@ -733,7 +1231,8 @@ int neru_wayland_overlay_available_buffer(NeruWaylandOverlay *overlay) {
 void neru_wayland_overlay_dispatch_pending(NeruWaylandOverlay *overlay) {
 	if (!overlay || !overlay->display)
 		return;
-	wl_display_dispatch_pending(overlay->display);
+	wl_display_dispatch_queue_pending(overlay->display, overlay->queue);
+	neru_wayland_conn_dispatch(overlay->conn);
 }
 
 static void neru_wayland_overlay_color(cairo_t *cr, unsigned int color) {
@@ -744,28 +1243,27 @@ static void neru_wayland_overlay_color(cairo_t *cr, unsigned int color) {
 	cairo_set_source_rgba(cr, r, g, b, a);
 }
 
-void neru_wayland_overlay_rect(
-    NeruWaylandOverlay *overlay, double x, double y, double width, double height, unsigned int fill,
+static void neru_screen_rect(
+    NeruWaylandOverlayScreen *scr, double x, double y, double width, double height, unsigned int fill,
     unsigned int stroke, double stroke_width) {
-	for (int i = 0; i < overlay->nr_screens; i++) {
-		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
-		if (!scr->cr)
-			continue;
-
-		// Convert global coordinates to screen-local
-		double scr_x = x - scr->x;
-		double scr_y = y - scr->y;
+	if (!scr->cr)
+		return;
 
-		cairo_t *cr = scr->cr;
-		cairo_save(cr);
-		cairo_rectangle(cr, scr_x, scr_y, width, height);
-		neru_wayland_overlay_color(cr, fill);
-		cairo_fill_preserve(cr);
-		neru_wayland_overlay_color(cr, stroke);
-		cairo_set_line_width(cr, stroke_width);
-		cairo_stroke(cr);
-		cairo_restore(cr);
-	}
+	// Convert global coordinates to screen-local
+	double scr_x = x - scr->x;
+	double scr_y = y - scr->y;
+
+	cairo_t *cr = scr->cr;
+	cairo_save(cr);
+	cairo_rectangle(cr, scr_x, scr_y, width, height);
+	neru_wayland_overlay_color(cr, fill);
+	cairo_fill_preserve(cr);
+	neru_wayland_overlay_color(cr, stroke);
+	cairo_set_line_width(cr, stroke_width);
+	cairo_stroke(cr);
+	cairo_restore(cr);
+
+	neru_screen_add_damage(scr, scr_x, scr_y, width, height, stroke_width / 2.0);
 }
 
 static void neru_wayland_overlay_rounded_path(
@@ -788,95 +1286,526 @@ static void neru_wayland_overlay_rounded_path(
 	cairo_close_path(cr);
 }
 
+static void neru_screen_rounded_rect(
+    NeruWaylandOverlayScreen *scr, double x, double y, double width, double height, double radius, unsigned int fill,
+    unsigned int stroke, double stroke_width) {
+	if (!scr->cr)
+		return;
+
+	double scr_x = x - scr->x;
+	double scr_y = y - scr->y;
+
+	cairo_t *cr = scr->cr;
+	cairo_save(cr);
+	neru_wayland_overlay_rounded_path(cr, scr_x, scr_y, width, height, radius);
+	neru_wayland_overlay_color(cr, fill);
+	cairo_fill_preserve(cr);
+	neru_wayland_overlay_color(cr, stroke);
+	cairo_set_line_width(cr, stroke_width);
+	cairo_stroke(cr);
+	cairo_restore(cr);
+
+	neru_screen_add_damage(scr, scr_x, scr_y, width, height, stroke_width / 2.0);
+}
+
+// Paints text centered on (x, y) in the user space of cr, through the label
+// cache when possible, and stores the painted bounds in user space.
+static void neru_cairo_text_centered(
+    NeruLabelCache *cache, cairo_t *cr, const char *text, const char *font_family, double x, double y,
+    double font_size, unsigned int color, double scale, double *out_x, double *out_y, double *out_w, double *out_h) {
+	if (neru_label_cache_draw(
+	        cache, cr, text, font_family, x, y, font_size, color, scale, out_x, out_y, out_w, out_h))
+		return;
+
+	cairo_text_extents_t extents;
+	cairo_save(cr);
+	cairo_select_font_face(cr, font_family, CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
+	cairo_set_font_size(cr, font_size);
+	cairo_text_extents(cr, text, &extents);
+	neru_wayland_overlay_color(cr, color);
+	double origin_x = x - (extents.width / 2.0) - extents.x_bearing;
+	double origin_y = y - (extents.height / 2.0) - extents.y_bearing;
+	cairo_move_to(cr, origin_x, origin_y);
+	cairo_show_text(cr, text);
+	cairo_restore(cr);
+
+	*out_x = origin_x + extents.x_bearing;
+	*out_y = origin_y + extents.y_bearing;
+	*out_w = extents.width;
+	*out_h = extents.height;
+}
+
+static void neru_screen_text(
+    NeruWaylandOverlayScreen *scr, const char *text, const char *font_family, double x, double y, double font_size,
+    unsigned int color) {
+	if (!scr->cr)
+		return;
+
+	// Convert global coordinates to screen-local
+	double scr_x = x - scr->x;
+	double scr_y = y - scr->y;
+
+	double lx, ly, lw, lh;
+	neru_cairo_text_centered(
+	    scr->label_cache, scr->cr, text, font_family, scr_x, scr_y, font_size, color, scr->buf_scale, &lx, &ly, &lw,
+	    &lh);
+	neru_screen_add_damage(scr, lx, ly, lw, lh, 1.0);
+}
+
+void neru_wayland_overlay_rect(
+    NeruWaylandOverlay *overlay, double x, double y, double width, double height, unsigned int fill,
+    unsigned int stroke, double stroke_width) {
+	double pad = stroke_width / 2.0;
+	for (int i = 0; i < overlay->nr_screens; i++) {
+		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
+		if (neru_screen_intersects(scr, x - pad, y - pad, x + width + pad, y + height + pad))
+			neru_screen_rect(scr, x, y, width, height, fill, stroke, stroke_width);
+	}
+}
+
 void neru_wayland_overlay_rounded_rect(
     NeruWaylandOverlay *overlay, double x, double y, double width, double height, double radius, unsigned int fill,
     unsigned int stroke, double stroke_width) {
+	double pad = stroke_width / 2.0;
 	for (int i = 0; i < overlay->nr_screens; i++) {
 		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
-		if (!scr->cr)
-			continue;
-
-		double scr_x = x - scr->x;
-		double scr_y = y - scr->y;
-
-		cairo_t *cr = scr->cr;
-		cairo_save(cr);
-		neru_wayland_overlay_rounded_path(cr, scr_x, scr_y, width, height, radius);
-		neru_wayland_overlay_color(cr, fill);
-		cairo_fill_preserve(cr);
-		neru_wayland_overlay_color(cr, stroke);
-		cairo_set_line_width(cr, stroke_width);
-		cairo_stroke(cr);
-		cairo_restore(cr);
+		if (neru_screen_intersects(scr, x - pad, y - pad, x + width + pad, y + height + pad))
+			neru_screen_rounded_rect(scr, x, y, width, height, radius, fill, stroke, stroke_width);
 	}
 }
 
 void neru_wayland_overlay_text(
     NeruWaylandOverlay *overlay, const char *text, const char *font_family, double x, double y, double font_size,
     unsigned int color) {
+	double x1, y1, x2, y2;
+	neru_draw_text_bounds(text, x, y, font_size, &x1, &y1, &x2, &y2);
+	for (int i = 0; i < overlay->nr_screens; i++) {
+		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
+		if (neru_screen_intersects(scr, x1, y1, x2, y2))
+			neru_screen_text(scr, text, font_family, x, y, font_size, color);
+	}
+}
+
+// Per-output draw target: submit bins commands by output and replays each bin
+// with the output itself as the context.
+static void neru_screen_target_clear(void *ctx) { neru_screen_clear((NeruWaylandOverlayScreen *)ctx); }
+
+static void neru_screen_target_clear_rect(void *ctx, double x, double y, double width, double height) {
+	neru_screen_clear_rect((NeruWaylandOverlayScreen *)ctx, x, y, width, height);
+}
+
+static void neru_screen_target_rect(
+    void *ctx, double x, double y, double width, double height, unsigned int fill, unsigned int stroke,
+    double stroke_width) {
+	neru_screen_rect((NeruWaylandOverlayScreen *)ctx, x, y, width, height, fill, stroke, stroke_width);
+}
+
+static void neru_screen_target_rounded_rect(
+    void *ctx, double x, double y, double width, double height, double radius, unsigned int fill, unsigned int stroke,
+    double stroke_width) {
+	neru_screen_rounded_rect((NeruWaylandOverlayScreen *)ctx, x, y, width, height, radius, fill, stroke, stroke_width);
+}
+
+static void neru_screen_target_text(
+    void *ctx, const char *text, const char *font_family, double x, double y, double font_size, unsigned int color) {
+	neru_screen_text((NeruWaylandOverlayScreen *)ctx, text, font_family, x, y, font_size, color);
+}
+
+static const NeruDrawTarget neru_screen_draw_target = {
+    .clear = neru_screen_target_clear,
+    .clear_rect = neru_screen_target_clear_rect,
+    .rect = neru_screen_target_rect,
+    .rounded_rect = neru_screen_target_rounded_rect,
+    .text = neru_screen_target_text,
+};
+
+typedef struct NeruDrawBounds {
+	double x1, y1, x2, y2;
+	int bounded;
+} NeruDrawBounds;
+
+static int neru_overlay_reserve_submit(NeruWaylandOverlay *overlay, int n) {
+	if (n <= overlay->submit_cap)
+		return 1;
+	NeruDrawBounds *bounds = malloc((size_t)n * sizeof(NeruDrawBounds));
+	int *bin = malloc((size_t)n * sizeof(int));
+	if (!bounds || !bin) {
+		free(bounds);
+		free(bin);
+		return 0;
+	}
+	free(overlay->submit_bounds);
+	free(overlay->submit_bin);
+	overlay->submit_bounds = bounds;
+	overlay->submit_bin = bin;
+	overlay->submit_cap = n;
+	return 1;
+}
+
+// Replays a whole frame of draw commands built on the Go side, so a frame
+// costs one cgo transition instead of one per primitive. Command bounds are
+// computed once, binned per output, and each output only rasterizes the
+// commands that intersect it.
+int neru_wayland_overlay_submit(
+    NeruWaylandOverlay *overlay, unsigned int version, const NeruDrawCmd *cmds, int n, const char *strings,
+    size_t strings_len) {
+	if (!overlay || version != NERU_DRAW_CMD_VERSION)
+		return -1;
+	for (int i = 0; i < overlay->nr_screens; i++)
+		overlay->screens[i].frame_primitives = 0;
+	if (!cmds || n <= 0)
+		return 0;
+
+	if (!neru_overlay_reserve_submit(overlay, n))
+		return -1;
+	NeruDrawBounds *bounds = overlay->submit_bounds;
+	int *bin = overlay->submit_bin;
+
+	for (int c = 0; c < n; c++) {
+		NeruDrawBounds *b = &bounds[c];
+		b->bounded = neru_draw_cmd_bounds(&cmds[c], strings, strings_len, &b->x1, &b->y1, &b->x2, &b->y2);
+	}
+
+	int executed = 0;
 	for (int i = 0; i < overlay->nr_screens; i++) {
 		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
 		if (!scr->cr)
 			continue;
 
-		// Convert global coordinates to screen-local
-		double scr_x = x - scr->x;
-		double scr_y = y - scr->y;
+		int bin_len = 0;
+		for (int c = 0; c < n; c++) {
+			const NeruDrawBounds *b = &bounds[c];
+			if (!b->bounded || neru_screen_intersects(scr, b->x1, b->y1, b->x2, b->y2))
+				bin[bin_len++] = c;
+		}
 
-		cairo_t *cr = scr->cr;
-		cairo_text_extents_t extents;
-		cairo_save(cr);
-		cairo_select_font_face(cr, font_family, CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
-		cairo_set_font_size(cr, font_size);
-		cairo_text_extents(cr, text, &extents);
-		neru_wayland_overlay_color(cr, color);
-		cairo_move_to(
-		    cr, scr_x - (extents.width / 2.0) - extents.x_bearing, scr_y - (extents.height / 2.0) - extents.y_bearing);
-		cairo_show_text(cr, text);
-		cairo_restore(cr);
+		scr->frame_primitives =
+		    neru_draw_cmds_replay_bin(&neru_screen_draw_target, scr, cmds, bin, bin_len, strings, strings_len);
+		executed += scr->frame_primitives;
 	}
+	return executed;
 }
 
-// Poll for Wayland events without blocking
-int neru_wayland_overlay_poll(NeruWaylandOverlay *overlay) {
+// Copies the per-output primitive counts of the last submit into counts.
+// Returns the number of outputs written.
+int neru_wayland_overlay_frame_stats(NeruWaylandOverlay *overlay, int *counts, int max_counts) {
+	if (!overlay || !counts)
+		return 0;
+	int n = overlay->nr_screens < max_counts ? overlay->nr_screens : max_counts;
+	for (int i = 0; i < n; i++)
+		counts[i] = overlay->screens[i].frame_primitives;
+	return n;
+}
+
+// Phase one of the keyboard poller wait; call with displayMu held. Dispatches
+// anything already queued, then announces the intent to read. Returns 1 when
+// keys are already queued (the read was cancelled), 0 when the caller must
+// now call neru_wayland_overlay_wait, or -1 if the connection failed.
+int neru_wayland_overlay_prepare_wait(NeruWaylandOverlay *overlay) {
 	if (!overlay || !overlay->display)
 		return -1;
 
 	struct wl_display *display = overlay->display;
-
-	int prepare_retries = 0;
-	while (wl_display_prepare_read(display) != 0) {
-		if (wl_display_dispatch_pending(display) < 0)
-			return -1;
-		if (++prepare_retries > 100)
+	if (neru_wayland_conn_dispatch(overlay->conn) < 0)
+		return -1;
+	while (wl_display_prepare_read_queue(display, overlay->queue) != 0) {
+		if (wl_display_dispatch_queue_pending(display, overlay->queue) < 0)
 			return -1;
 	}
 
-	wl_display_flush(display);
+	if (overlay->key_ring.count > 0) {
+		wl_display_cancel_read(display);
+		return 1;
+	}
 
-	struct pollfd pfd = {.fd = wl_display_get_fd(display), .events = POLLIN, .revents = 0};
+	// EAGAIN only means the socket is full; the next wakeup retries.
+	if (wl_display_flush(display) < 0 && errno != EAGAIN) {
+		wl_display_cancel_read(display);
+		return -1;
+	}
+	return 0;
+}
 
-	int ret = poll(&pfd, 1, 0);
-	if (ret > 0 && (pfd.revents & POLLIN)) {
+// Phase two; call WITHOUT displayMu so rendering can proceed. Blocks until the
+// display fd is readable or the wakeup eventfd is signalled, then reads (but
+// does not dispatch) the events. wl_display_read_events and
+// wl_display_cancel_read are thread-safe, and a renderer that reads the same
+// fd concurrently is released once this call reads or cancels. Returns 1 on
+// activity, 0 on timeout and -1 if the connection failed.
+int neru_wayland_overlay_wait(NeruWaylandOverlay *overlay, int timeout_ms) {
+	struct wl_display *display = overlay->display;
+	struct pollfd pfds[2] = {
+	    {.fd = wl_display_get_fd(display), .events = POLLIN, .revents = 0},
+	    {.fd = overlay->event_fd, .events = POLLIN, .revents = 0},
+	};
+	int nfds = overlay->event_fd >= 0 ? 2 : 1;
+
+	int ret;
+	do {
+		ret = poll(pfds, nfds, timeout_ms);
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret > 0 && (pfds[0].revents & POLLIN)) {
 		if (wl_display_read_events(display) < 0)
-			ret = -1;
+			return -1;
 	} else {
 		wl_display_cancel_read(display);
-		if (ret > 0)
-			ret = -1;
+		if (ret < 0 || (pfds[0].revents & (POLLERR | POLLHUP)))
+			return -1;
 	}
 
-	wl_display_dispatch_pending(display);
-	return ret;
+	if (nfds > 1 && (pfds[1].revents & POLLIN)) {
+		uint64_t count;
+		while (read(overlay->event_fd, &count, sizeof(count)) > 0) {
+		}
+	}
+	return ret > 0 ? 1 : 0;
 }
 
-// Get next pending key from ring buffer (non-blocking).
-// Returns NULL when the ring is empty.
-const char *neru_wayland_overlay_get_key(NeruWaylandOverlay *overlay) {
-	if (overlay->key_ring.count == 0)
-		return NULL;
-	const char *key = overlay->key_ring.keys[overlay->key_ring.tail];
-	overlay->key_ring.tail = (overlay->key_ring.tail + 1) % NERU_KEY_RING_CAP;
-	overlay->key_ring.count--;
-	return key;
+void neru_wayland_overlay_wake(NeruWaylandOverlay *overlay) {
+	if (!overlay || overlay->event_fd < 0)
+		return;
+	uint64_t one = 1;
+	ssize_t written = write(overlay->event_fd, &one, sizeof(one));
+	(void)written;
+}
+
+int neru_wayland_overlay_read_keys(NeruWaylandOverlay *overlay, NeruKeyEvent *out, int max) {
+	if (!overlay || !out)
+		return 0;
+	NeruWaylandKeyRing *ring = &overlay->key_ring;
+	int n = 0;
+	while (n < max && ring->count > 0) {
+		out[n++] = ring->events[ring->tail];
+		ring->tail = (ring->tail + 1) % NERU_KEY_RING_CAP;
+		ring->count--;
+	}
+	return n;
+}
+
+unsigned long neru_wayland_overlay_key_overflows(NeruWaylandOverlay *overlay) {
+	return overlay ? overlay->key_ring.overflows : 0;
+}
+
+static int neru_badge_same_string(const char *stored, size_t stored_len, const char *s) {
+	return strlen(s) == stored_len && memcmp(stored, s, stored_len) == 0;
+}
+
+// Copies s into the grow-only buffer *dst. Returns 0 when it cannot grow.
+static int neru_badge_store_string(char **dst, size_t *len, size_t *cap, const char *s) {
+	size_t n = strlen(s);
+	if (n + 1 > *cap) {
+		char *grown = realloc(*dst, n + 1);
+		if (!grown)
+			return 0;
+		*dst = grown;
+		*cap = n + 1;
+	}
+	memcpy(*dst, s, n + 1);
+	*len = n;
+	return 1;
+}
+
+static int neru_badge_same_content(
+    const NeruWaylandBadge *badge, int width, int height, const char *text, const char *font_family,
+    double font_size, unsigned int fill, unsigned int stroke, double stroke_width, unsigned int text_color,
+    double scale) {
+	return badge->front >= 0 && badge->has_content && badge->width == width && badge->height == height &&
+	       badge->font_size == font_size && badge->fill == fill && badge->stroke == stroke &&
+	       badge->stroke_width == stroke_width && badge->text_color == text_color && badge->scale == scale &&
+	       neru_badge_same_string(badge->text, badge->text_len, text) &&
+	       neru_badge_same_string(badge->font_family, badge->font_family_len, font_family);
+}
+
+// Returns a released buffer of the badge pool, allocating it on first use, or
+// -1 when every buffer is still held by the compositor.
+static int neru_badge_acquire_buffer(NeruWaylandOverlay *overlay, NeruWaylandBadge *badge) {
+	for (int b = 0; b < NERU_BADGE_BUFFERS; b++) {
+		if (badge->buffers[b] && !badge->busy[b])
+			return b;
+	}
+	for (int b = 0; b < NERU_BADGE_BUFFERS; b++) {
+		if (badge->buffers[b])
+			continue;
+
+		int fd = create_shm_file(badge->shm_size);
+		if (fd < 0)
+			return -1;
+		void *data = mmap(NULL, badge->shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (data == MAP_FAILED) {
+			close(fd);
+			return -1;
+		}
+		struct wl_shm_pool *pool = wl_shm_create_pool(overlay->shm, fd, (int)badge->shm_size);
+		badge->buffers[b] = wl_shm_pool_create_buffer(
+		    pool, 0, badge->buf_width, badge->buf_height, badge->buf_width * 4, WL_SHM_FORMAT_ARGB8888);
+		wl_buffer_add_listener(badge->buffers[b], &neru_badge_buffer_listener, badge);
+		wl_shm_pool_destroy(pool);
+		close(fd);
+		badge->shm_datas[b] = data;
+		badge->busy[b] = 0;
+		return b;
+	}
+	return -1;
+}
+
+// Attaches buffer b to the badge surface and commits it. The subsurface is
+// desynchronized, so the new content shows without a parent commit.
+static void neru_badge_commit(NeruWaylandBadge *badge, int b, int total_width, int total_height, double scale) {
+	wl_surface_attach(badge->wl_surface, badge->buffers[b], 0, 0);
+	wl_surface_damage_buffer(badge->wl_surface, 0, 0, badge->buf_width, badge->buf_height);
+	if (badge->viewport) {
+		wl_surface_set_buffer_scale(badge->wl_surface, 1);
+		wp_viewport_set_destination(badge->viewport, total_width, total_height);
+	} else {
+		wl_surface_set_buffer_scale(badge->wl_surface, (int)scale);
+	}
+	wl_surface_commit(badge->wl_surface);
+	badge->busy[b] = 1;
+	badge->front = b;
+	badge->mapped = 1;
+}
+
+int neru_wayland_overlay_badge_draw(
+    NeruWaylandOverlay *overlay, int slot, int x, int y, int width, int height, const char *text,
+    const char *font_family, double font_size, unsigned int fill, unsigned int stroke, double stroke_width,
+    unsigned int text_color) {
+	if (!overlay || !overlay->subcompositor || slot < 0 || slot >= NERU_BADGE_SLOTS || !text || !font_family ||
+	    width <= 0 || height <= 0)
+		return 0;
+
+	// The parent must have buffers so the flush that follows maps it.
+	int cx = x + width / 2;
+	int cy = y + height / 2;
+	int idx = -1;
+	for (int i = 0; i < overlay->nr_screens; i++) {
+		NeruWaylandOverlayScreen *scr = &overlay->screens[i];
+		if (scr->wl_surface && scr->buffer && cx >= scr->x && cx < scr->x + scr->width && cy >= scr->y &&
+		    cy < scr->y + scr->height) {
+			idx = i;
+			break;
+		}
+	}
+	if (idx < 0)
+		return 0;
+
+	NeruWaylandOverlayScreen *scr = &overlay->screens[idx];
+	NeruWaylandBadge *badge = &overlay->badges[slot];
+
+	if (badge->screen != idx) {
+		neru_badge_release(badge);
+		badge->wl_surface = wl_compositor_create_surface(overlay->compositor);
+		struct wl_region *empty_region = wl_compositor_create_region(overlay->compositor);
+		wl_surface_set_input_region(badge->wl_surface, empty_region);
+		wl_region_destroy(empty_region);
+		badge->subsurface =
+		    wl_subcompositor_get_subsurface(overlay->subcompositor, badge->wl_surface, scr->wl_surface);
+		wl_subsurface_set_desync(badge->subsurface);
+		if (scr->viewport)
+			badge->viewport = wp_viewporter_get_viewport(overlay->viewporter, badge->wl_surface);
+		badge->screen = idx;
+	}
+
+	// Half the border is stroked outside the rect, as in the overlay buffer.
+	int pad = (int)ceil(stroke_width / 2.0);
+	int local_x = x - scr->x - pad;
+	int local_y = y - scr->y - pad;
+	if (!badge->mapped || badge->x != local_x || badge->y != local_y) {
+		wl_subsurface_set_position(badge->subsurface, local_x, local_y);
+		badge->x = local_x;
+		badge->y = local_y;
+	}
+
+	int total_width = width + 2 * pad;
+	int total_height = height + 2 * pad;
+	double scale = scr->buf_scale > 0 ? scr->buf_scale : 1.0;
+
+	if (neru_badge_same_content(
+	        badge, width, height, text, font_family, font_size, fill, stroke, stroke_width, text_color, scale)) {
+		if (!badge->mapped)
+			neru_badge_commit(badge, badge->front, total_width, total_height, scale);
+		return 1;
+	}
+
+	int buf_width = (int)(total_width * scale + 0.5);
+	int buf_height = (int)(total_height * scale + 0.5);
+	if (badge->buf_width != buf_width || badge->buf_height != buf_height) {
+		neru_badge_release_buffers(badge);
+		badge->buf_width = buf_width;
+		badge->buf_height = buf_height;
+		badge->shm_size = (size_t)buf_width * 4u * (size_t)buf_height;
+	}
+
+	int b = neru_badge_acquire_buffer(overlay, badge);
+	if (b < 0) {
+		// Keep the old content up; the next draw retries.
+		return 1;
+	}
+
+	cairo_surface_t *surface = cairo_image_surface_create_for_data(
+	    badge->shm_datas[b], CAIRO_FORMAT_ARGB32, buf_width, buf_height, buf_width * 4);
+	cairo_t *cr = cairo_create(surface);
+	cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+	cairo_paint(cr);
+	cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+	cairo_scale(cr, scale, scale);
+
+	cairo_rectangle(cr, pad, pad, width, height);
+	neru_wayland_overlay_color(cr, fill);
+	cairo_fill_preserve(cr);
+	neru_wayland_overlay_color(cr, stroke);
+	cairo_set_line_width(cr, stroke_width);
+	cairo_stroke(cr);
+
+	double lx, ly, lw, lh;
+	neru_cairo_text_centered(
+	    overlay->label_cache, cr, text, font_family, pad + width / 2, pad + height / 2, font_size, text_color, scale,
+	    &lx, &ly, &lw, &lh);
+
+	cairo_destroy(cr);
+	cairo_surface_flush(surface);
+	cairo_surface_destroy(surface);
+
+	neru_badge_commit(badge, b, total_width, total_height, scale);
+
+	// Without a copy the next draw simply rasterizes again.
+	badge->has_content =
+	    neru_badge_store_string(&badge->text, &badge->text_len, &badge->text_cap, text) &&
+	    neru_badge_store_string(&badge->font_family, &badge->font_family_len, &badge->font_family_cap, font_family);
+	badge->font_size = font_size;
+	badge->width = width;
+	badge->height = height;
+	badge->fill = fill;
+	badge->stroke = stroke;
+	badge->stroke_width = stroke_width;
+	badge->text_color = text_color;
+	badge->scale = scale;
+	return 1;
+}
+
+void neru_wayland_overlay_badge_hide(NeruWaylandOverlay *overlay, int slot) {
+	if (!overlay || slot < 0 || slot >= NERU_BADGE_SLOTS)
+		return;
+
+	NeruWaylandBadge *badge = &overlay->badges[slot];
+	if (!badge->wl_surface || !badge->mapped)
+		return;
+
+	wl_surface_attach(badge->wl_surface, NULL, 0, 0);
+	wl_surface_commit(badge->wl_surface);
+	badge->mapped = 0;
+	wl_display_flush(overlay->display);
+}
+
+void neru_wayland_overlay_invalidate_label_cache(NeruWaylandOverlay *overlay) {
+	if (!overlay)
+		return;
+	neru_label_cache_invalidate(overlay->label_cache);
+	// Badge buffers hold labels too; force the next draw to re-rasterize.
+	for (int i = 0; i < NERU_BADGE_SLOTS; i++)
+		overlay->badges[i].has_content = 0;
+}
+
+void neru_wayland_overlay_label_cache_stats(NeruWaylandOverlay *overlay, NeruLabelCacheStats *stats) {
+	neru_label_cache_stats(overlay ? overlay->label_cache : NULL, stats);
 }
@@ -2,23 +2,59 @@
 #define OVERLAY_WAYLAND_H
 
 #include "common_defs.h"
+#include "label_cache.h"
+#include "overlay_cmds.h"
+#include "wayland_conn.h"
 
 #include <cairo/cairo.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <wayland-client.h>
 #include <xkbcommon/xkbcommon.h>
 
-#define NERU_KEY_RING_CAP 32
+#define NERU_KEY_RING_CAP 256
 #define NERU_NUM_BUFFERS 3
+#define NERU_BADGE_SLOTS 2
+#define NERU_BADGE_BUFFERS 2
+// Default cap on SHM kept mapped while the overlay is hidden in warm standby.
+#define NERU_STANDBY_DEFAULT_MAX_BYTES ((size_t)256 * 1024 * 1024)
+
+// Axis-aligned damage rectangle in buffer pixels. Empty when x2 <= x1 or y2 <= y1.
+typedef struct {
+	int x1, y1, x2, y2;
+} NeruDamageRect;
+
+// Presentation feedback (wp_presentation) accumulated since the last reset.
+// Latency is measured from our commit to the time the compositor reports the
+// content was shown, both on the presentation clock.
+typedef struct {
+	unsigned long presented;
+	unsigned long discarded;
+	uint64_t last_latency_ns;
+	uint64_t max_latency_ns;
+	uint64_t total_latency_ns;
+	uint32_t refresh_ns;
+} NeruPresentationStats;
+
+struct NeruPresentationFeedback;
 
 typedef struct {
 	int x, y, width, height;
 	int scale;
+	// wp_fractional_scale_v1 preferred scale in 120ths; 0 until the compositor
+	// sends one, in which case the integer wl_output scale is used.
+	uint32_t preferred_scale;
 	struct wl_output *wl_output;
-	struct zxdg_output_v1 *xdg_output;
 
 	struct wl_surface *wl_surface;
 	struct zwlr_layer_surface_v1 *layer_surface;
+	struct wp_fractional_scale_v1 *fractional_scale;
+	struct wp_viewport *viewport;
+	int configured;  // last configure for layer_surface has been acked
+	int closed;      // compositor sent closed; recreate on next setup
+
+	// Outstanding wl_surface.frame callback for the last damaged commit.
+	struct wl_callback *frame_callback;
 
 	// Current buffer (pointers updated by select_buffer, avoids changing all C functions)
 	struct wl_buffer *buffer;
@@ -36,24 +72,107 @@ typedef struct {
 	int busy[NERU_NUM_BUFFERS];
 	int num_buffers;
 	int current_buffer;
+	int buf_width;
+	int buf_height;
+	int stride;
+	double buf_scale;  // logical-to-buffer factor the pool was allocated at
+
+	// Damage tracking (buffer pixels). damage is what the next commit changes,
+	// content bounds everything drawn since the last clear, and stale[i] is the
+	// region where buffer i lags behind the last committed (front) buffer.
+	NeruDamageRect damage;
+	NeruDamageRect content;
+	NeruDamageRect stale[NERU_NUM_BUFFERS];
+	int front_buffer;
+
+	// Primitives rasterized on this output by the last submit (after culling).
+	int frame_primitives;
+
+	// Shared with every other output; owned by NeruWaylandOverlay.
+	NeruLabelCache *label_cache;
 } NeruWaylandOverlayScreen;
 
+// Small cursor-following element (mode indicator, sticky-modifier badge) on
+// its own wl_subsurface of an output's layer surface. Moving it is a
+// set_position applied by the next parent commit; its tiny buffer is only
+// re-rasterized when the content changes.
+typedef struct {
+	struct wl_surface *wl_surface;
+	struct wl_subsurface *subsurface;
+	struct wp_viewport *viewport;
+	int screen;  // index of the parent output, -1 while no surface exists
+	int mapped;
+	int x, y;  // logical position relative to the parent output
+
+	// Content of the last rasterized buffer; a redraw with equal content only
+	// moves the subsurface. text and font_family are grow-only heap copies,
+	// so labels of any length compare exactly; has_content is 0 while they do
+	// not describe the front buffer.
+	int has_content;
+	char *text;
+	size_t text_len, text_cap;
+	char *font_family;
+	size_t font_family_len, font_family_cap;
+	double font_size;
+	int width, height;
+	unsigned int fill, stroke, text_color;
+	double stroke_width;
+	double scale;
+
+	struct wl_buffer *buffers[NERU_BADGE_BUFFERS];
+	void *shm_datas[NERU_BADGE_BUFFERS];
+	int busy[NERU_BADGE_BUFFERS];
+	int front;  // buffer last attached, -1 when none
+	size_t shm_size;
+	int buf_width;
+	int buf_height;
+} NeruWaylandBadge;
+
+// Modifier bits of NeruKeyEvent.mods, sampled from the effective xkb state.
+#define NERU_KEY_MOD_SHIFT (1u << 0)
+#define NERU_KEY_MOD_CTRL (1u << 1)
+#define NERU_KEY_MOD_ALT (1u << 2)
+#define NERU_KEY_MOD_LOGO (1u << 3)
+
+// One wl_keyboard.key event. Names are resolved on the Go side from keysym,
+// so the dispatch path does no string formatting.
 typedef struct {
-	char keys[NERU_KEY_RING_CAP][256];
+	uint32_t time_ms;  // wl_keyboard timestamp
+	uint32_t keycode;  // evdev keycode
+	uint32_t keysym;   // xkb keysym under the current layout and modifiers
+	uint16_t mods;     // NERU_KEY_MOD_* at the time of the event
+	uint8_t pressed;   // 1 on press, 0 on release
+	uint8_t reserved;
+} NeruKeyEvent;
+
+typedef struct {
+	NeruKeyEvent events[NERU_KEY_RING_CAP];
 	int head;
 	int tail;
 	int count;
+	unsigned long overflows;  // events dropped because the ring was full
 } NeruWaylandKeyRing;
 
 typedef struct {
+	// Shared with the input client; see wayland_conn.h. Every overlay object
+	// lives on queue, and the global pointers below are wrappers that create
+	// new objects there.
+	NeruWaylandConn *conn;
 	struct wl_display *display;
-	struct wl_registry *registry;
+	struct wl_event_queue *queue;
+	uint64_t outputs_generation;
 	struct wl_compositor *compositor;
+	struct wl_subcompositor *subcompositor;
 	struct wl_shm *shm;
-	struct zxdg_output_manager_v1 *xdg_output_mgr;
 	struct zwlr_layer_shell_v1 *layer_shell;
 	struct wl_seat *wl_seat;
 	struct wl_keyboard *wl_keyboard;
+	struct wp_fractional_scale_manager_v1 *fractional_scale_mgr;
+	struct wp_viewporter *viewporter;
+	struct wp_presentation *presentation;
+	int presentation_clock;
+	NeruPresentationStats presentation_stats;
+	struct NeruPresentationFeedback *feedbacks;
 
 	struct xkb_context *xkb_ctx;
 	struct xkb_state *xkb_state;
@@ -61,25 +180,63 @@ typedef struct {
 	NeruWaylandOverlayScreen screens[NERU_MAX_OUTPUTS];
 	int nr_screens;
 
+	NeruWaylandBadge badges[NERU_BADGE_SLOTS];
+
 	int configured;
 	int keyboard_interactivity_set;
 
 	int event_fd;
 	int running;
 
+	// Warm standby: hide unmaps the layer surfaces but keeps them and their
+	// SHM pools so the next show skips the roundtrip and mmap. Pools larger
+	// than standby_max_bytes (0 = unlimited) are released on hide instead.
+	int standby_enabled;
+	size_t standby_max_bytes;
+	int visible;
+
 	NeruWaylandKeyRing key_ring;
+
+	NeruLabelCache *label_cache;
+
+	// Submit's per-command scratch, grown to the largest frame seen and kept
+	// so steady-state frames do not allocate.
+	struct NeruDrawBounds *submit_bounds;
+	int *submit_bin;
+	int submit_cap;
 } NeruWaylandOverlay;
 
 NeruWaylandOverlay *neru_wayland_overlay_new(void);
 void neru_wayland_overlay_destroy(NeruWaylandOverlay *overlay);
+void neru_wayland_overlay_conn_stats(NeruWaylandOverlay *overlay, NeruWaylandConnStats *stats);
 void neru_wayland_overlay_setup_buffers(NeruWaylandOverlay *overlay);
 void neru_wayland_overlay_show(NeruWaylandOverlay *overlay);
 void neru_wayland_overlay_hide(NeruWaylandOverlay *overlay);
+void neru_wayland_overlay_set_standby(NeruWaylandOverlay *overlay, int enabled, size_t max_bytes);
+// Releases standby surfaces and buffers while hidden; returns the SHM bytes freed.
+size_t neru_wayland_overlay_release_standby(NeruWaylandOverlay *overlay);
+size_t neru_wayland_overlay_pool_bytes(NeruWaylandOverlay *overlay);
+int neru_wayland_overlay_is_warm(NeruWaylandOverlay *overlay);
+int neru_wayland_overlay_is_visible(NeruWaylandOverlay *overlay);
 void neru_wayland_overlay_set_keyboard_capture(NeruWaylandOverlay *overlay, int enabled);
 void neru_wayland_overlay_clear(NeruWaylandOverlay *overlay);
 void neru_wayland_overlay_clear_rect(NeruWaylandOverlay *overlay, double x, double y, double width, double height);
 void neru_wayland_overlay_flush(NeruWaylandOverlay *overlay);
 void neru_wayland_overlay_sync(NeruWaylandOverlay *overlay);
+// Dispatch events until a buffer is released (1), the timeout expired (0) or
+// the connection failed (-1).
+int neru_wayland_overlay_wait_buffer(NeruWaylandOverlay *overlay, int timeout_ms);
+// Waiting for the frame callbacks in two phases, like the keyboard poller, so
+// the animation does not hold displayMu while it blocks. Phase one, with
+// displayMu held: returns 1 when every output's last frame callback fired, 0
+// when the caller must call neru_wayland_overlay_wait_display, or -1 if the
+// connection failed.
+int neru_wayland_overlay_prepare_frame_wait(NeruWaylandOverlay *overlay);
+// Phase two, without displayMu: reads the display fd once it is readable or
+// cancels the read on timeout. Returns 1 on activity, 0 on timeout and -1 if
+// the connection failed.
+int neru_wayland_overlay_wait_display(NeruWaylandOverlay *overlay, int timeout_ms);
+void neru_wayland_overlay_presentation_stats(NeruWaylandOverlay *overlay, NeruPresentationStats *stats, int reset);
 void neru_wayland_overlay_select_buffer(NeruWaylandOverlay *overlay, int index);
 int neru_wayland_overlay_available_buffer(NeruWaylandOverlay *overlay);
 void neru_wayland_overlay_dispatch_pending(NeruWaylandOverlay *overlay);
@@ -92,7 +249,27 @@ void neru_wayland_overlay_rounded_rect(
 void neru_wayland_overlay_text(
     NeruWaylandOverlay *overlay, const char *text, const char *font_family, double x, double y, double font_size,
     unsigned int color);
-int neru_wayland_overlay_poll(NeruWaylandOverlay *overlay);
-const char *neru_wayland_overlay_get_key(NeruWaylandOverlay *overlay);
+int neru_wayland_overlay_submit(
+    NeruWaylandOverlay *overlay, unsigned int version, const NeruDrawCmd *cmds, int n, const char *strings,
+    size_t strings_len);
+int neru_wayland_overlay_frame_stats(NeruWaylandOverlay *overlay, int *counts, int max_counts);
+// Draws a bordered, labelled box at the global logical rect on its own
+// subsurface. Returns 1 when the badge is shown that way and 0 when the
+// caller must draw it into the overlay buffer instead (no wl_subcompositor
+// or no mapped output under the rect). Position changes take effect on the
+// next flush.
+int neru_wayland_overlay_badge_draw(
+    NeruWaylandOverlay *overlay, int slot, int x, int y, int width, int height, const char *text,
+    const char *font_family, double font_size, unsigned int fill, unsigned int stroke, double stroke_width,
+    unsigned int text_color);
+void neru_wayland_overlay_badge_hide(NeruWaylandOverlay *overlay, int slot);
+void neru_wayland_overlay_invalidate_label_cache(NeruWaylandOverlay *overlay);
+void neru_wayland_overlay_label_cache_stats(NeruWaylandOverlay *overlay, NeruLabelCacheStats *stats);
+int neru_wayland_overlay_prepare_wait(NeruWaylandOverlay *overlay);
+int neru_wayland_overlay_wait(NeruWaylandOverlay *overlay, int timeout_ms);
+void neru_wayland_overlay_wake(NeruWaylandOverlay *overlay);
+// Moves up to max queued key events into out and returns how many were copied.
+int neru_wayland_overlay_read_keys(NeruWaylandOverlay *overlay, NeruKeyEvent *out, int max);
+unsigned long neru_wayland_overlay_key_overflows(NeruWaylandOverlay *overlay);
 
 #endif /* OVERLAY_WAYLAND_H */
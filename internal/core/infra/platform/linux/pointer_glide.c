@@ -0,0 +1,186 @@
+#include "pointer_glide.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+struct NeruPointerGlide {
+	NeruGlideEmitFn emit;
+	void *ctx;
+
+	// Guards everything below. Held across emit so that neru_glide_cancel
+	// returning means no stale frame can still reach the compositor.
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;  // CLOCK_MONOTONIC
+	pthread_t thread;
+	int thread_started;
+	int stopping;
+
+	int active;
+	int from_x, from_y, to_x, to_y;
+	int64_t start_ns, duration_ns, period_ns, next_ns;
+	NeruGlideDoneFn done;
+	uint64_t token;
+};
+
+static int64_t neru_glide_now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Ease-out cubic: fast departure, gentle arrival, so the pointer settles over
+// the target for the last frames instead of arriving at full speed.
+static double neru_glide_ease(double t) {
+	double u = 1.0 - t;
+	return 1.0 - u * u * u;
+}
+
+static void neru_glide_wait_until(NeruPointerGlide *glide, int64_t deadline_ns) {
+	struct timespec ts = {.tv_sec = deadline_ns / 1000000000LL, .tv_nsec = deadline_ns % 1000000000LL};
+	pthread_cond_timedwait(&glide->cond, &glide->mutex, &ts);
+}
+
+static void *neru_glide_loop(void *arg) {
+	NeruPointerGlide *glide = arg;
+
+	pthread_mutex_lock(&glide->mutex);
+	while (!glide->stopping) {
+		if (!glide->active) {
+			pthread_cond_wait(&glide->cond, &glide->mutex);
+			continue;
+		}
+
+		int64_t now = neru_glide_now_ns();
+		if (now < glide->next_ns) {
+			neru_glide_wait_until(glide, glide->next_ns);
+			continue;
+		}
+
+		int64_t elapsed = now - glide->start_ns;
+		int finished = elapsed >= glide->duration_ns;
+		int x = glide->to_x, y = glide->to_y;
+		if (!finished) {
+			double eased = neru_glide_ease((double)elapsed / (double)glide->duration_ns);
+			x = glide->from_x + (int)((double)(glide->to_x - glide->from_x) * eased + 0.5);
+			y = glide->from_y + (int)((double)(glide->to_y - glide->from_y) * eased + 0.5);
+		}
+		glide->emit(glide->ctx, x, y);
+
+		if (!finished) {
+			// Skip frames we were late for rather than bunching them up.
+			glide->next_ns += glide->period_ns;
+			if (glide->next_ns <= now)
+				glide->next_ns = now + glide->period_ns;
+			continue;
+		}
+
+		NeruGlideDoneFn done = glide->done;
+		uint64_t token = glide->token;
+		glide->active = 0;
+		pthread_mutex_unlock(&glide->mutex);
+		if (done != NULL)
+			done(token, 1);
+		pthread_mutex_lock(&glide->mutex);
+	}
+	pthread_mutex_unlock(&glide->mutex);
+	return NULL;
+}
+
+NeruPointerGlide *neru_glide_new(NeruGlideEmitFn emit, void *ctx) {
+	NeruPointerGlide *glide = calloc(1, sizeof(*glide));
+	if (glide == NULL)
+		return NULL;
+	glide->emit = emit;
+	glide->ctx = ctx;
+
+	pthread_condattr_t attr;
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&glide->cond, &attr);
+	pthread_condattr_destroy(&attr);
+	pthread_mutex_init(&glide->mutex, NULL);
+	return glide;
+}
+
+// Ends the glide in flight and returns its done callback for the caller to
+// invoke once the mutex is released. Must be called with the mutex held.
+static NeruGlideDoneFn neru_glide_take_active(NeruPointerGlide *glide, uint64_t *token) {
+	if (!glide->active)
+		return NULL;
+	glide->active = 0;
+	*token = glide->token;
+	return glide->done;
+}
+
+void neru_glide_free(NeruPointerGlide *glide) {
+	if (glide == NULL)
+		return;
+
+	neru_glide_cancel(glide);
+
+	pthread_mutex_lock(&glide->mutex);
+	glide->stopping = 1;
+	pthread_cond_signal(&glide->cond);
+	int started = glide->thread_started;
+	pthread_mutex_unlock(&glide->mutex);
+	if (started)
+		pthread_join(glide->thread, NULL);
+
+	pthread_cond_destroy(&glide->cond);
+	pthread_mutex_destroy(&glide->mutex);
+	free(glide);
+}
+
+int neru_glide_start(
+    NeruPointerGlide *glide, int from_x, int from_y, int to_x, int to_y, int duration_ms, int refresh_mhz,
+    NeruGlideDoneFn done, uint64_t token) {
+	if (glide == NULL || duration_ms <= 0)
+		return 0;
+	if (refresh_mhz <= 0)
+		refresh_mhz = NERU_GLIDE_DEFAULT_REFRESH_MHZ;
+
+	pthread_mutex_lock(&glide->mutex);
+	if (!glide->thread_started) {
+		if (pthread_create(&glide->thread, NULL, neru_glide_loop, glide) != 0) {
+			pthread_mutex_unlock(&glide->mutex);
+			return 0;
+		}
+		glide->thread_started = 1;
+	}
+
+	uint64_t replaced_token = 0;
+	NeruGlideDoneFn replaced = neru_glide_take_active(glide, &replaced_token);
+
+	int64_t now = neru_glide_now_ns();
+	glide->from_x = from_x;
+	glide->from_y = from_y;
+	glide->to_x = to_x;
+	glide->to_y = to_y;
+	glide->start_ns = now;
+	glide->duration_ns = (int64_t)duration_ms * 1000000LL;
+	glide->period_ns = 1000000000000LL / refresh_mhz;
+	glide->next_ns = now + glide->period_ns;
+	glide->done = done;
+	glide->token = token;
+	glide->active = 1;
+	pthread_cond_signal(&glide->cond);
+	pthread_mutex_unlock(&glide->mutex);
+
+	if (replaced != NULL)
+		replaced(replaced_token, 0);
+	return 1;
+}
+
+void neru_glide_cancel(NeruPointerGlide *glide) {
+	if (glide == NULL)
+		return;
+
+	pthread_mutex_lock(&glide->mutex);
+	uint64_t token = 0;
+	NeruGlideDoneFn done = neru_glide_take_active(glide, &token);
+	pthread_mutex_unlock(&glide->mutex);
+
+	if (done != NULL)
+		done(token, 0);
+}
@@ -0,0 +1,35 @@
+#ifndef POINTER_GLIDE_H
+#define POINTER_GLIDE_H
+
+#include <stdint.h>
+
+// Refresh rate assumed when no output reported one, in mHz.
+#define NERU_GLIDE_DEFAULT_REFRESH_MHZ 60000
+
+// Emits one absolute pointer position. Called on the glide thread.
+typedef void (*NeruGlideEmitFn)(void *ctx, int x, int y);
+// Reports that the glide identified by token ended: completed is 1 when it
+// reached its target, 0 when it was cancelled or replaced. Called without any
+// glide lock held, on the glide thread or the thread that cancelled it.
+typedef void (*NeruGlideDoneFn)(uint64_t token, int completed);
+
+// Moves a pointer along an eased path from a dedicated thread, one emit per
+// output frame, so hover-sensitive clients see intermediate motion instead of
+// a single jump. At most one glide is in flight; starting another or
+// cancelling ends it first. scroll_glide.c drives scroll amounts with it too.
+typedef struct NeruPointerGlide NeruPointerGlide;
+
+NeruPointerGlide *neru_glide_new(NeruGlideEmitFn emit, void *ctx);
+// Cancels any glide in flight and joins the thread.
+void neru_glide_free(NeruPointerGlide *glide);
+// Glides from (from_x, from_y) to (to_x, to_y) over duration_ms, emitting
+// once per refresh interval of an output running at refresh_mhz (<= 0 picks
+// NERU_GLIDE_DEFAULT_REFRESH_MHZ). The last emit lands exactly on the target.
+// Returns 1 when the glide was started; on 0 done is never called.
+int neru_glide_start(
+    NeruPointerGlide *glide, int from_x, int from_y, int to_x, int to_y, int duration_ms, int refresh_mhz,
+    NeruGlideDoneFn done, uint64_t token);
+// Stops the glide in flight, if any. No emit happens after it returns.
+void neru_glide_cancel(NeruPointerGlide *glide);
+
+#endif /* POINTER_GLIDE_H */
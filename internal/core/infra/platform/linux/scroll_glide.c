@@ -0,0 +1,85 @@
+#include "scroll_glide.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+// The pointer glide animates a point from (0, 0) to the total scroll; each of
+// its frames is turned into the value120 delta since the previous frame.
+struct NeruScrollGlide {
+	NeruScrollEmitFn emit;
+	void *ctx;
+	NeruPointerGlide *glide;
+
+	// Serializes neru_scroll_glide_by. The glide thread never takes it, so it
+	// can be held across neru_glide_cancel and neru_glide_start.
+	pthread_mutex_t mutex;
+
+	// The scroll in flight: its total and how much of it was emitted. sent_*
+	// is written by whichever thread emits and only read once
+	// neru_glide_cancel has stopped the glide thread.
+	int target_x, target_y;
+	int sent_x, sent_y;
+};
+
+static void neru_scroll_glide_emit(void *ctx, int x, int y) {
+	NeruScrollGlide *scroll = ctx;
+	int dx = x - scroll->sent_x;
+	int dy = y - scroll->sent_y;
+	scroll->sent_x = x;
+	scroll->sent_y = y;
+
+	// target_* is only rewritten after neru_glide_cancel has stopped us.
+	if (dy != 0)
+		scroll->emit(scroll->ctx, 0, dy, y == scroll->target_y);
+	if (dx != 0)
+		scroll->emit(scroll->ctx, 1, dx, x == scroll->target_x);
+}
+
+NeruScrollGlide *neru_scroll_glide_new(NeruScrollEmitFn emit, void *ctx) {
+	NeruScrollGlide *scroll = calloc(1, sizeof(*scroll));
+	if (scroll == NULL)
+		return NULL;
+	scroll->emit = emit;
+	scroll->ctx = ctx;
+	scroll->glide = neru_glide_new(neru_scroll_glide_emit, scroll);
+	if (scroll->glide == NULL) {
+		free(scroll);
+		return NULL;
+	}
+	pthread_mutex_init(&scroll->mutex, NULL);
+	return scroll;
+}
+
+void neru_scroll_glide_free(NeruScrollGlide *scroll) {
+	if (scroll == NULL)
+		return;
+	neru_glide_free(scroll->glide);
+	pthread_mutex_destroy(&scroll->mutex);
+	free(scroll);
+}
+
+int neru_scroll_glide_by(NeruScrollGlide *scroll, int dx120, int dy120, int duration_ms, int refresh_mhz) {
+	if (scroll == NULL)
+		return 0;
+
+	pthread_mutex_lock(&scroll->mutex);
+	neru_glide_cancel(scroll->glide);
+
+	int x = scroll->target_x - scroll->sent_x + dx120;
+	int y = scroll->target_y - scroll->sent_y + dy120;
+	scroll->target_x = x;
+	scroll->target_y = y;
+	scroll->sent_x = 0;
+	scroll->sent_y = 0;
+
+	int ok = 1;
+	if (duration_ms <= 0 || (x == 0 && y == 0)) {
+		neru_scroll_glide_emit(scroll, x, y);
+	} else if (!neru_glide_start(scroll->glide, 0, 0, x, y, duration_ms, refresh_mhz, NULL, 0)) {
+		scroll->target_x = 0;
+		scroll->target_y = 0;
+		ok = 0;
+	}
+	pthread_mutex_unlock(&scroll->mutex);
+	return ok;
+}
@@ -0,0 +1,32 @@
+#ifndef SCROLL_GLIDE_H
+#define SCROLL_GLIDE_H
+
+#include "pointer_glide.h"
+
+// Scroll amounts are in value120 units: 120 is one wheel notch, the unit of
+// REL_WHEEL_HI_RES and wl_pointer.axis_value120. Fractions of a notch are
+// carried instead of being rounded to whole notches.
+#define NERU_SCROLL_VALUE120_PER_NOTCH 120
+
+// Emits value120 units of scroll on axis (0 vertical, 1 horizontal). last is
+// 1 when this emit completes the scroll on that axis; a scroll joined by a
+// later one before then gets no last emit of its own.
+typedef void (*NeruScrollEmitFn)(void *ctx, int axis, int value120, int last);
+
+// Spreads scroll amounts over time along the pointer glide's ease-out curve:
+// fast at first and decaying into the target like a flicked wheel, with one
+// emit per output frame. An amount added while a scroll is in flight joins
+// what that scroll has not delivered yet, so repeated scrolls keep their
+// momentum instead of restarting from rest or queueing behind each other.
+typedef struct NeruScrollGlide NeruScrollGlide;
+
+NeruScrollGlide *neru_scroll_glide_new(NeruScrollEmitFn emit, void *ctx);
+// Drops whatever is still undelivered and joins the glide thread.
+void neru_scroll_glide_free(NeruScrollGlide *scroll);
+// Scrolls by (dx120, dy120) over duration_ms, one emit per refresh interval
+// at refresh_mhz. duration_ms <= 0 emits everything at once on the calling
+// thread. Returns 0 when the glide could not be started; nothing is emitted
+// then.
+int neru_scroll_glide_by(NeruScrollGlide *scroll, int dx120, int dy120, int duration_ms, int refresh_mhz);
+
+#endif /* SCROLL_GLIDE_H */
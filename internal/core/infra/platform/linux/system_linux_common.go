@@ -32,6 +32,10 @@ type SystemAdapter struct {
 
 // NewSystemAdapter creates a new SystemAdapter.
 func NewSystemAdapter(backend string) *SystemAdapter {
+	if backend == backendX11 {
+		x11InitThreads()
+	}
+
 	return &SystemAdapter{backend: backend}
 }
 
@@ -218,6 +222,15 @@ func (s *SystemAdapter) MoveCursorToPoint(
 	}
 
 	if s.waylandUsesWlrClientStack() {
+		cfg := currentConfig()
+		if cfg != nil && cfg.SmoothCursor.MoveMouseEnabled && !bypassSmooth {
+			return waylandGlideCursorToPoint(
+				point,
+				cfg.SmoothCursor.MaxDuration,
+				cfg.SmoothCursor.DurationPerPixel,
+			)
+		}
+
 		// Route through the Wayland input dispatcher so KDE (no virtual
 		// pointer) uses libei while wlroots compositors use the native path.
 		return waylandMoveCursorToPoint(point)
@@ -240,8 +253,13 @@ func (s *SystemAdapter) MoveCursorBy(
 	return false, nil
 }
 
-// WaitForCursorIdle returns immediately on Linux until smooth cursor support exists.
+// WaitForCursorIdle blocks until the latest Wayland pointer glide settles. X11
+// moves are instantaneous, so it returns immediately there.
 func (s *SystemAdapter) WaitForCursorIdle(ctx context.Context) error {
+	if s.waylandUsesWlrClientStack() {
+		return globalPointerGlides.wait(ctx)
+	}
+
 	return nil
 }
 
@@ -301,9 +319,37 @@ func (s *SystemAdapter) waylandUsesWlrClientStack() bool {
 	return s.backend == backendWaylandWlroots || s.backend == backendWaylandKDE
 }
 
+// EventQueueStats reports the wlroots client's injection queue as the
+// "inject" stage and the libei event thread's queue as the "libei" stage,
+// each once its client is connected.
+func (s *SystemAdapter) EventQueueStats() map[string]ports.EventQueueStats {
+	if !s.waylandUsesWlrClientStack() {
+		return nil
+	}
+
+	queues := make(map[string]ports.EventQueueStats)
+
+	if stats, ok := wlrootsInjectStats(); ok {
+		queues["inject"] = stats
+	}
+
+	if stats, ok := libeiInjectStats(); ok {
+		queues["libei"] = stats
+	}
+
+	if len(queues) == 0 {
+		return nil
+	}
+
+	return queues
+}
+
 // Ensure SystemAdapter implements ports.SystemPort.
 var _ ports.SystemPort = (*SystemAdapter)(nil)
 
+// Ensure SystemAdapter reports its injection queue counters.
+var _ ports.EventQueueStatsProvider = (*SystemAdapter)(nil)
+
 // darkModeSource names which input produced a color-scheme value.
 type darkModeSource string
 
@@ -0,0 +1,33 @@
+//go:build linux
+
+package linux
+
+import (
+	"sync"
+
+	"github.com/y3owk1n/neru/internal/config"
+)
+
+var configProviderState struct {
+	mu       sync.RWMutex
+	provider config.Provider
+}
+
+// SetConfigProvider updates the runtime config provider used by pointer helpers.
+func SetConfigProvider(provider config.Provider) {
+	configProviderState.mu.Lock()
+	defer configProviderState.mu.Unlock()
+
+	configProviderState.provider = provider
+}
+
+func currentConfig() *config.Config {
+	configProviderState.mu.RLock()
+	defer configProviderState.mu.RUnlock()
+
+	if configProviderState.provider == nil {
+		return nil
+	}
+
+	return configProviderState.provider.Get()
+}
@@ -0,0 +1,111 @@
+//go:build linux
+
+package linux
+
+import (
+	"context"
+	"image"
+	"math"
+	"sync"
+
+	"github.com/y3owk1n/neru/internal/config"
+)
+
+// Smooth cursor moves on the Wayland backends are glides run by the C glide
+// engine (pointer_glide.c), which emits one position per output frame on its
+// own thread. Each glide carries a token; the engine reports it back through
+// neruPointerGlideDone when the glide completes or is cancelled, and
+// WaitForCursorIdle blocks on the latest one instead of sleeping.
+
+// glideMinDuration is the shortest glide in ms, matching the darwin animator.
+const glideMinDuration = 10
+
+type pointerGlides struct {
+	mu      sync.Mutex
+	next    uint64
+	pending map[uint64]chan struct{}
+	latest  chan struct{}
+}
+
+var globalPointerGlides = &pointerGlides{pending: make(map[uint64]chan struct{})}
+
+// begin allocates the token for a glide about to start and makes it the one
+// wait blocks on.
+func (g *pointerGlides) begin() uint64 {
+	g.mu.Lock()
+	defer g.mu.Unlock()
+
+	g.next++
+	done := make(chan struct{})
+	g.pending[g.next] = done
+	g.latest = done
+
+	return g.next
+}
+
+// finish marks the glide identified by token as ended. Unknown tokens are
+// ignored so a glide that failed to start can be finished by its caller.
+func (g *pointerGlides) finish(token uint64) {
+	g.mu.Lock()
+	defer g.mu.Unlock()
+
+	done, ok := g.pending[token]
+	if !ok {
+		return
+	}
+
+	delete(g.pending, token)
+	close(done)
+}
+
+// wait blocks until the most recently started glide has ended.
+func (g *pointerGlides) wait(ctx context.Context) error {
+	g.mu.Lock()
+	done := g.latest
+	g.mu.Unlock()
+
+	if done == nil {
+		return nil
+	}
+
+	select {
+	case <-done:
+		return nil
+	case <-ctx.Done():
+		return ctx.Err()
+	}
+}
+
+// glideDurationMs scales the glide with distance, capped at maxDuration, the
+// same way the darwin animator sizes its animations.
+func glideDurationMs(from, to image.Point, maxDuration int, durationPerPixel float64) int {
+	distance := math.Hypot(float64(to.X-from.X), float64(to.Y-from.Y))
+	duration := math.Min(float64(maxDuration), distance*durationPerPixel)
+
+	return max(int(math.Round(duration)), glideMinDuration)
+}
+
+// SmoothScrollDurationMs is how long a Wayland scroll by (deltaX, deltaY)
+// pixels should take under the current smooth_scroll settings, or 0 to scroll
+// at once. Scrolls are paced like cursor glides, by distance up to the cap.
+func SmoothScrollDurationMs(deltaX, deltaY int) int {
+	cfg := currentConfig()
+	if cfg == nil {
+		return 0
+	}
+
+	return smoothScrollDurationMs(cfg.SmoothScroll, deltaX, deltaY)
+}
+
+func smoothScrollDurationMs(cfg config.SmoothScrollConfig, deltaX, deltaY int) int {
+	if !cfg.Enabled || cfg.MaxDuration <= 0 || (deltaX == 0 && deltaY == 0) {
+		return 0
+	}
+
+	return glideDurationMs(
+		image.Point{},
+		image.Point{X: deltaX, Y: deltaY},
+		cfg.MaxDuration,
+		cfg.DurationPerPixel,
+	)
+}
@@ -0,0 +1,17 @@
+//go:build linux && cgo
+
+package linux
+
+/*
+#include <stdint.h>
+*/
+import "C"
+
+// neruPointerGlideDone is the NeruGlideDoneFn handed to the C glide engine by
+// both the wlroots and libei clients. The completed flag is not needed: a
+// cancelled glide has settled just as much as a finished one.
+//
+//export neruPointerGlideDone
+func neruPointerGlideDone(token C.uint64_t, _ C.int) {
+	globalPointerGlides.finish(uint64(token))
+}
@@ -0,0 +1,100 @@
+//go:build linux
+
+//nolint:testpackage // These tests exercise the unexported glide registry directly.
+package linux
+
+import (
+	"context"
+	"image"
+	"testing"
+	"time"
+
+	"github.com/y3owk1n/neru/internal/config"
+)
+
+func TestPointerGlidesWaitBlocksOnLatest(t *testing.T) {
+	t.Parallel()
+
+	glides := &pointerGlides{pending: make(map[uint64]chan struct{})}
+
+	err := glides.wait(context.Background())
+	if err != nil {
+		t.Fatalf("wait with no glide = %v, want nil", err)
+	}
+
+	first := glides.begin()
+	second := glides.begin()
+
+	// A replaced glide ending must not release waiters of the newer one.
+	glides.finish(first)
+
+	ctx, cancel := context.WithTimeout(context.Background(), 10*time.Millisecond)
+	defer cancel()
+
+	if err := glides.wait(ctx); err == nil {
+		t.Fatal("wait returned before the latest glide finished")
+	}
+
+	glides.finish(second)
+	glides.finish(second)
+
+	err = glides.wait(context.Background())
+	if err != nil {
+		t.Fatalf("wait after finish = %v, want nil", err)
+	}
+}
+
+func TestGlideDurationMs(t *testing.T) {
+	t.Parallel()
+
+	origin := image.Point{}
+
+	tests := []struct {
+		name string
+		to   image.Point
+		want int
+	}{
+		{name: "scales with distance", to: image.Point{X: 300, Y: 400}, want: 50},
+		{name: "capped at max duration", to: image.Point{X: 3000, Y: 4000}, want: 200},
+		{name: "floored for short hops", to: image.Point{X: 3, Y: 4}, want: glideMinDuration},
+	}
+
+	for _, tt := range tests {
+		t.Run(tt.name, func(t *testing.T) {
+			t.Parallel()
+
+			if got := glideDurationMs(origin, tt.to, 200, 0.1); got != tt.want {
+				t.Fatalf("glideDurationMs = %d, want %d", got, tt.want)
+			}
+		})
+	}
+}
+
+func TestSmoothScrollDurationMs(t *testing.T) {
+	t.Parallel()
+
+	enabled := config.SmoothScrollConfig{Enabled: true, MaxDuration: 180, DurationPerPixel: 1}
+	disabled := config.SmoothScrollConfig{MaxDuration: 180, DurationPerPixel: 1}
+
+	tests := []struct {
+		name   string
+		cfg    config.SmoothScrollConfig
+		dx, dy int
+		want   int
+	}{
+		{name: "scales with distance", cfg: enabled, dy: -120, want: 120},
+		{name: "capped at max duration", cfg: enabled, dx: 1_000_000, want: 180},
+		{name: "disabled scrolls at once", cfg: disabled, dy: 50},
+		{name: "zero delta scrolls at once", cfg: enabled},
+	}
+
+	for _, tt := range tests {
+		t.Run(tt.name, func(t *testing.T) {
+			t.Parallel()
+
+			if got := smoothScrollDurationMs(tt.cfg, tt.dx, tt.dy); got != tt.want {
+				t.Fatalf("smoothScrollDurationMs = %d, want %d", got, tt.want)
+			}
+		})
+	}
+}
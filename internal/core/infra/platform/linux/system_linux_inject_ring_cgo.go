@@ -0,0 +1,132 @@
+//go:build linux && cgo
+
+package linux
+
+/*
+#include "inject_ring.h"
+*/
+import "C"
+
+// Go views of the inject ring (inject_ring.h) and of the frame rules the
+// wlroots writer applies to it, so their behaviour can be tested without a
+// compositor.
+
+type injectKind int
+
+const (
+	injectMotionAbs      injectKind = C.NERU_INJECT_MOTION_ABS
+	injectMotionRel      injectKind = C.NERU_INJECT_MOTION_REL
+	injectButton         injectKind = C.NERU_INJECT_BUTTON
+	injectAxis           injectKind = C.NERU_INJECT_AXIS
+	injectAxisContinuous injectKind = C.NERU_INJECT_AXIS_CONTINUOUS
+	injectKey            injectKind = C.NERU_INJECT_KEY
+	injectModifier       injectKind = C.NERU_INJECT_MODIFIER
+)
+
+// injectRingClosed is what drain returns once the ring is closed and empty.
+const injectRingClosed = -1
+
+type injectCmd struct {
+	kind    injectKind
+	a, b, c int
+}
+
+func (cmd injectCmd) toC() C.NeruInjectCmd {
+	return C.NeruInjectCmd{
+		kind: C.NeruInjectKind(cmd.kind),
+		a:    C.int(cmd.a),
+		b:    C.int(cmd.b),
+		c:    C.int(cmd.c),
+	}
+}
+
+func injectCmdFromC(cmd *C.NeruInjectCmd) injectCmd {
+	return injectCmd{kind: injectKind(cmd.kind), a: int(cmd.a), b: int(cmd.b), c: int(cmd.c)}
+}
+
+type injectRing struct {
+	raw *C.NeruInjectRing
+}
+
+func newInjectRing(capacity int) *injectRing {
+	raw := C.neru_inject_ring_new(C.int(capacity)) //nolint:nlreturn
+	if raw == nil {
+		return nil
+	}
+
+	return &injectRing{raw: raw}
+}
+
+func (r *injectRing) push(cmd injectCmd) bool {
+	cCmd := cmd.toC()
+
+	return C.neru_inject_ring_push(r.raw, &cCmd) != 0
+}
+
+// drain returns up to limit queued commands and their count, or
+// injectRingClosed as the count once the ring is closed and empty.
+func (r *injectRing) drain(limit int) ([]injectCmd, int) {
+	out := make([]C.NeruInjectCmd, limit)
+
+	n := int(C.neru_inject_ring_drain(r.raw, &out[0], C.int(limit))) //nolint:nlreturn
+	if n <= 0 {
+		return nil, n
+	}
+
+	cmds := make([]injectCmd, n)
+	for i := range cmds {
+		cmds[i] = injectCmdFromC(&out[i])
+	}
+
+	return cmds, n
+}
+
+func (r *injectRing) wakeFd() int {
+	return int(C.neru_inject_ring_wake_fd(r.raw))
+}
+
+func (r *injectRing) close() {
+	C.neru_inject_ring_close(r.raw)
+}
+
+func (r *injectRing) free() {
+	C.neru_inject_ring_free(r.raw)
+}
+
+func (r *injectRing) stats() C.NeruInjectRingStats {
+	var stats C.NeruInjectRingStats
+	C.neru_inject_ring_stats(r.raw, &stats)
+
+	return stats
+}
+
+// injectFrameBreaks reports whether next would close a frame holding frame.
+func injectFrameBreaks(frame []injectCmd, next injectCmd) bool {
+	var cFrame C.NeruInjectFrame
+
+	for _, cmd := range frame {
+		cCmd := cmd.toC()
+		C.neru_inject_frame_add(&cFrame, &cCmd)
+	}
+
+	cNext := next.toC()
+
+	return C.neru_inject_frame_breaks(&cFrame, &cNext) != 0
+}
+
+// injectCoalesceMotion collapses the motion run starting at cmds[i] and
+// returns it with the index of the last command taken.
+func injectCoalesceMotion(cmds []injectCmd, i int) (injectCmd, int) {
+	cCmds := make([]C.NeruInjectCmd, len(cmds))
+	for j, cmd := range cmds {
+		cCmds[j] = cmd.toC()
+	}
+
+	var out C.NeruInjectCmd
+
+	last := int(
+		C.neru_inject_coalesce_motion(&cCmds[0], C.int(len(cCmds)), C.int(i), &out),
+	) //nolint:nlreturn
+
+	return injectCmdFromC(&out), last
+}
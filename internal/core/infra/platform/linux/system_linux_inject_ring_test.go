@@ -0,0 +1,168 @@
+//go:build linux && cgo
+
+//nolint:testpackage // These tests exercise the unexported inject ring wrappers directly.
+package linux
+
+import (
+	"testing"
+
+	"golang.org/x/sys/unix"
+)
+
+const btnLeft, btnRight = 0x110, 0x111
+
+func TestInjectRingPushDrainClose(t *testing.T) {
+	t.Parallel()
+
+	ring := newInjectRing(4)
+	if ring == nil {
+		t.Fatal("newInjectRing returned nil")
+	}
+	defer ring.free()
+
+	for i := range 4 {
+		if !ring.push(injectCmd{kind: injectKey, a: i, b: 1}) {
+			t.Fatalf("push %d into a ring with room failed", i)
+		}
+	}
+
+	if ring.push(injectCmd{kind: injectKey, a: 4, b: 1}) {
+		t.Fatal("push into a full ring succeeded")
+	}
+
+	cmds, n := ring.drain(3)
+	if n != 3 || cmds[0].a != 0 || cmds[2].a != 2 {
+		t.Fatalf("drain(3) = %v, %d; want keys 0..2 in push order", cmds, n)
+	}
+
+	ring.close()
+
+	if ring.push(injectCmd{kind: injectKey, a: 5}) {
+		t.Fatal("push into a closed ring succeeded")
+	}
+
+	// The writer must be woken until it has seen the close, even after it
+	// took the last commands in a short batch.
+	cmds, n = ring.drain(3)
+	if n != 1 || cmds[0].a != 3 {
+		t.Fatalf("drain after close = %v, %d; want the last queued key", cmds, n)
+	}
+
+	fds := []unix.PollFd{{Fd: int32(ring.wakeFd()), Events: unix.POLLIN}}
+
+	ready, err := unix.Poll(fds, 0)
+	if err != nil || ready != 1 {
+		t.Fatalf("wake fd readable after close = %d, %v; want 1", ready, err)
+	}
+
+	if _, n = ring.drain(3); n != injectRingClosed {
+		t.Fatalf("drain of a closed, empty ring = %d, want %d", n, injectRingClosed)
+	}
+
+	stats := ring.stats()
+	if stats.produced != 5 || stats.consumed != 4 || stats.dropped != 1 || stats.high_water != 4 {
+		t.Fatalf("stats = %+v; want 5 produced, 4 consumed, 1 dropped, high water 4", stats)
+	}
+}
+
+func TestInjectFrameBreaks(t *testing.T) {
+	t.Parallel()
+
+	press := func(button int) injectCmd { return injectCmd{kind: injectButton, a: button, b: 1} }
+	release := func(button int) injectCmd { return injectCmd{kind: injectButton, a: button} }
+	wheel := func(axis int) injectCmd { return injectCmd{kind: injectAxis, a: axis, b: 15, c: 1} }
+
+	tests := []struct {
+		name  string
+		frame []injectCmd
+		next  injectCmd
+		want  bool
+	}{
+		{name: "empty frame", next: injectCmd{kind: injectMotionAbs}, want: false},
+		{
+			name:  "click shares a frame",
+			frame: []injectCmd{press(btnLeft)},
+			next:  release(btnLeft),
+			want:  false,
+		},
+		{
+			name:  "two buttons share a frame",
+			frame: []injectCmd{press(btnLeft)},
+			next:  press(btnRight),
+			want:  false,
+		},
+		{
+			name:  "press after click",
+			frame: []injectCmd{press(btnLeft), release(btnLeft)},
+			next:  press(btnLeft),
+			want:  true,
+		},
+		{name: "second press", frame: []injectCmd{press(btnLeft)}, next: press(btnLeft), want: true},
+		{
+			name:  "button outside BTN_MOUSE",
+			frame: []injectCmd{press(btnLeft)},
+			next:  press(0x14a),
+			want:  true,
+		},
+		{name: "both axes", frame: []injectCmd{wheel(0)}, next: wheel(1), want: false},
+		{name: "same axis twice", frame: []injectCmd{wheel(0)}, next: wheel(0), want: true},
+		{
+			name:  "other axis source",
+			frame: []injectCmd{wheel(0)},
+			next:  injectCmd{kind: injectAxisContinuous, a: 1, b: 256},
+			want:  true,
+		},
+		{name: "button then axis", frame: []injectCmd{press(btnLeft)}, next: wheel(0), want: false},
+		{
+			name:  "motion",
+			frame: []injectCmd{press(btnLeft)},
+			next:  injectCmd{kind: injectMotionRel},
+			want:  true,
+		},
+		{
+			name:  "key",
+			frame: []injectCmd{wheel(0)},
+			next:  injectCmd{kind: injectKey, a: 30, b: 1},
+			want:  true,
+		},
+		{
+			name:  "modifier",
+			frame: []injectCmd{wheel(0)},
+			next:  injectCmd{kind: injectModifier, a: 1},
+			want:  true,
+		},
+	}
+
+	for _, tt := range tests {
+		t.Run(tt.name, func(t *testing.T) {
+			t.Parallel()
+
+			if got := injectFrameBreaks(tt.frame, tt.next); got != tt.want {
+				t.Fatalf("injectFrameBreaks(%v, %v) = %v, want %v", tt.frame, tt.next, got, tt.want)
+			}
+		})
+	}
+}
+
+func TestInjectCoalesceMotion(t *testing.T) {
+	t.Parallel()
+
+	cmds := []injectCmd{
+		{kind: injectMotionAbs, a: 10, b: 10},
+		{kind: injectMotionAbs, a: 20, b: 30},
+		{kind: injectMotionRel, a: 1, b: 2},
+		{kind: injectMotionRel, a: 3, b: -4},
+		{kind: injectMotionRel, a: 5, b: 6},
+		{kind: injectButton, a: btnLeft, b: 1},
+	}
+
+	got, last := injectCoalesceMotion(cmds, 0)
+	if last != 1 || got.kind != injectMotionAbs || got.a != 20 || got.b != 30 {
+		t.Fatalf("absolute run = %v ending at %d; want the last position (20, 30) at 1", got, last)
+	}
+
+	got, last = injectCoalesceMotion(cmds, 2)
+	if last != 4 || got.kind != injectMotionRel || got.a != 9 || got.b != 4 {
+		t.Fatalf("relative run = %v ending at %d; want the summed delta (9, 4) at 4", got, last)
+	}
+}
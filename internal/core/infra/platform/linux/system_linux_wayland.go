@@ -45,13 +45,18 @@ func WaylandScroll(axis, delta, discrete int) error {
 	return waylandScroll(axis, delta, discrete)
 }
 
-// WlrootsScrollBatch sends multiple scroll events in a single flush.
-// deltas and discretes must have the same length. Routes through the
-// waylandScrollBatch seam so KDE (libei, no virtual pointer) emits one
-// libeiScroll event per delta instead of taking the wlroots-only batch path
-// (which fails on KWin with "failed to perform wlroots batch scroll").
-func WlrootsScrollBatch(axis int, deltas, discretes []int) error {
-	return waylandScrollBatch(axis, deltas, discretes)
+// WaylandScrollBy scrolls by (dx120, dy120) value120 units (120 per wheel
+// notch, positive = down/right) spread over durationMs at the refresh rate of
+// the output under the cursor; durationMs <= 0 scrolls at once. It returns
+// without waiting for the scroll to finish.
+func WaylandScrollBy(dx120, dy120, durationMs int) error {
+	return waylandScrollBy(dx120, dy120, durationMs)
+}
+
+// WaylandRefreshMhz returns the refresh rate in mHz of the output under the
+// cursor, or 0 when no output reported one.
+func WaylandRefreshMhz() int {
+	return waylandRefreshMhz()
 }
 
 // WaylandModifierEvent presses or releases a modifier key.
@@ -148,6 +148,48 @@ func waylandMoveCursorToPoint(point image.Point) error {
 	return wlrootsSetCursor(point)
 }
 
+// waylandGlideCursorToPoint starts a smooth move to point on either backend
+// and returns without waiting for it; WaitForCursorIdle blocks until it lands.
+// The glide is paced to the refresh rate of the output under point. On libei
+// the wlroots cursor cache cannot follow each frame, so it is set to the
+// target up front, matching where the pointer is about to settle.
+func waylandGlideCursorToPoint(point image.Point, maxDuration int, durationPerPixel float64) error {
+	from, err := wlrootsCursorPosition()
+	if err != nil {
+		return err
+	}
+
+	hasVirtualPointer, err := wlrootsHasVirtualPointer()
+	if err != nil {
+		return err
+	}
+
+	durationMs := glideDurationMs(from, point, maxDuration, durationPerPixel)
+	token := globalPointerGlides.begin()
+
+	if hasVirtualPointer {
+		err = wlrootsGlideCursorToPoint(point, durationMs, token)
+		if err != nil {
+			globalPointerGlides.finish(token)
+		}
+
+		return err
+	}
+
+	refreshMhz, err := wlrootsRefreshMhz(point)
+	if err == nil {
+		err = libeiGlideTo(from, point, durationMs, refreshMhz, token)
+	}
+
+	if err != nil {
+		globalPointerGlides.finish(token)
+
+		return err
+	}
+
+	return wlrootsSetCursor(point)
+}
+
 func waylandCursorPosition() (image.Point, error) {
 	// The cursor cache lives in the wlroots client for both backends; libei
 	// moves are mirrored into it by waylandMoveCursorToPoint.
@@ -229,36 +271,37 @@ func waylandScroll(axis, delta, discrete int) error {
 	return libeiScroll(axis, delta)
 }
 
-// waylandScrollBatch routes a batched scroll through the same backend choice as
-// waylandScroll. wlroots compositors flush every event in one wlrootsScrollBatch
-// call; KWin/KDE has no virtual pointer and libei has no batch API, so it emits
-// one libeiScroll event per delta (mirroring the working single-event
-// WaylandScroll path). discretes is honored only on the wlroots path; libei
-// scrolls by continuous delta, not discrete steps.
-func waylandScrollBatch(axis int, deltas, discretes []int) error {
+// waylandScrollBy scrolls by (dx120, dy120) value120 units (positive =
+// down/right) over durationMs, paced to the output under the cursor. Both
+// backends carry fractions of a notch: wlroots as sub-pixel continuous axis
+// events, libei as high-resolution discrete scroll.
+func waylandScrollBy(dx120, dy120, durationMs int) error {
 	hasVirtualPointer, err := wlrootsHasVirtualPointer()
 	if err != nil {
 		return err
 	}
 
 	if hasVirtualPointer {
-		return wlrootsScrollBatch(axis, deltas, discretes)
+		return wlrootsScrollBy(dx120, dy120, durationMs)
 	}
 
-	// Attempt every delta even if one fails: a transient libei hiccup (device
-	// pause/resume) mid-batch would otherwise drop the remaining deltas and
-	// strand the user at a partial scroll position. The first error is still
-	// reported to the caller.
-	var firstErr error
+	return libeiScrollBy(dx120, dy120, durationMs, waylandRefreshMhz())
+}
 
-	for _, d := range deltas {
-		err = libeiScroll(axis, d)
-		if err != nil && firstErr == nil {
-			firstErr = err
-		}
+// waylandRefreshMhz returns the refresh rate of the output under the cursor,
+// or 0 (the glide engine's default) when it is unknown.
+func waylandRefreshMhz() int {
+	cursor, err := wlrootsCursorPosition()
+	if err != nil {
+		return 0
+	}
+
+	refreshMhz, err := wlrootsRefreshMhz(cursor)
+	if err != nil {
+		return 0
 	}
 
-	return firstErr
+	return refreshMhz
 }
 
 func waylandModifierEvent(modifier string, isDown bool) error {
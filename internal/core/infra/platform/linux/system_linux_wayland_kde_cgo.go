@@ -6,13 +6,17 @@ package linux
 #cgo linux pkg-config: libei-1.0 liboeffis-1.0
 #include <stdlib.h>
 #include "libei_client.h"
+
+extern void neruPointerGlideDone(uint64_t token, int completed);
 */
 import "C"
 
 import (
+	"image"
 	"sync"
 
 	derrors "github.com/y3owk1n/neru/internal/core/errors"
+	"github.com/y3owk1n/neru/internal/core/ports"
 )
 
 // This file is the KDE Plasma Wayland input slot (compositor sub-slot "kde",
@@ -138,6 +142,39 @@ func libeiMoveAbs(posX, posY int) error {
 	return nil
 }
 
+// libeiGlideTo glides the libei pointer from from to to over durationMs at
+// refreshMhz. It returns once the glide has started; token is finished in
+// globalPointerGlides when the glide ends.
+func libeiGlideTo(from, to image.Point, durationMs, refreshMhz int, token uint64) error {
+	err := globalLibeiState.tryAcquire()
+	if err != nil {
+		return err
+	}
+	defer globalLibeiState.mu.Unlock()
+
+	client := globalLibeiState.client
+
+	if C.neru_ei_glide_to(
+		client,
+		C.int(from.X),
+		C.int(from.Y),
+		C.int(to.X),
+		C.int(to.Y),
+		C.int(durationMs),
+		C.int(refreshMhz),
+		C.NeruGlideDoneFn(C.neruPointerGlideDone),
+		C.uint64_t(token),
+	) == 0 { //nolint:nlreturn
+		return derrors.Newf(
+			derrors.CodeActionFailed,
+			"libei failed to glide pointer to (%d, %d)",
+			to.X, to.Y,
+		)
+	}
+
+	return nil
+}
+
 func libeiButton(button int, pressed bool) error {
 	err := globalLibeiState.tryAcquire()
 	if err != nil {
@@ -175,6 +212,30 @@ func libeiScroll(axis, delta int) error {
 	return nil
 }
 
+// libeiScrollBy scrolls the libei pointer by (dx120, dy120) value120 units
+// (positive = down/right) over durationMs at refreshMhz.
+func libeiScrollBy(dx120, dy120, durationMs, refreshMhz int) error {
+	err := globalLibeiState.tryAcquire()
+	if err != nil {
+		return err
+	}
+	defer globalLibeiState.mu.Unlock()
+
+	client := globalLibeiState.client
+
+	if C.neru_ei_scroll_by(
+		client,
+		C.int(dx120),
+		C.int(dy120),
+		C.int(durationMs),
+		C.int(refreshMhz),
+	) == 0 { //nolint:nlreturn
+		return derrors.New(derrors.CodeActionFailed, "libei failed to emit smooth scroll")
+	}
+
+	return nil
+}
+
 func libeiKey(keycode int, pressed bool) error {
 	err := globalLibeiState.tryAcquire()
 	if err != nil {
@@ -225,6 +286,45 @@ func libeiHasKeyboard() (bool, bool) {
 	return C.neru_ei_has_keyboard(globalLibeiState.client) != 0, false //nolint:nlreturn
 }
 
+const nsPerUs = 1000
+
+// libeiInjectStats reports the counters of the libei event thread's input
+// queue. Like libeiHasKeyboard it never connects or waits behind warm-up: ok
+// is false while the lock is busy or before the session exists.
+func libeiInjectStats() (ports.EventQueueStats, bool) {
+	if !globalLibeiState.mu.TryLock() {
+		return ports.EventQueueStats{}, false
+	}
+
+	defer globalLibeiState.mu.Unlock()
+
+	if !globalLibeiState.ready {
+		return ports.EventQueueStats{}, false
+	}
+
+	var stats C.NeruEiStats
+	if C.neru_ei_stats(globalLibeiState.client, &stats) == 0 { //nolint:nlreturn
+		return ports.EventQueueStats{}, false
+	}
+
+	result := ports.EventQueueStats{
+		Capacity:     int(stats.ring.capacity),
+		Produced:     uint64(stats.ring.produced),
+		Consumed:     uint64(stats.ring.consumed),
+		Dropped:      uint64(stats.ring.dropped),
+		HighWater:    uint64(stats.ring.high_water),
+		Batches:      uint64(stats.batches),
+		Coalesced:    uint64(stats.coalesced),
+		Frames:       uint64(stats.frames),
+		LatencyMaxUs: uint64(stats.latency_max_ns) / nsPerUs,
+	}
+	if stats.latency_count > 0 {
+		result.LatencyAvgUs = uint64(stats.latency_total_ns/stats.latency_count) / nsPerUs
+	}
+
+	return result, true
+}
+
 // LibeiReset tears down the libei/RemoteDesktop portal session. The next input
 // operation re-establishes the session via tryAcquire. Call after sleep/wake and
 // after a detected evdev failure so that stale portal connections don't silently
@@ -2,7 +2,12 @@
 
 package linux
 
-import derrors "github.com/y3owk1n/neru/internal/core/errors"
+import (
+	"image"
+
+	derrors "github.com/y3owk1n/neru/internal/core/errors"
+	"github.com/y3owk1n/neru/internal/core/ports"
+)
 
 // KDE Plasma Wayland input slot (non-CGO stub). libei input injection requires
 // CGO; these stubs keep the Wayland input dispatcher buildable in the
@@ -24,6 +29,15 @@ func libeiMoveAbs(x, y int) error {
 	)
 }
 
+func libeiGlideTo(from, to image.Point, durationMs, refreshMhz int, token uint64) error {
+	_, _, _, _, _ = from, to, durationMs, refreshMhz, token
+
+	return derrors.New(
+		derrors.CodeNotSupported,
+		"libei backend requires CGO-enabled Linux builds",
+	)
+}
+
 func libeiButton(button int, pressed bool) error {
 	_, _ = button, pressed
 
@@ -42,6 +56,15 @@ func libeiScroll(axis, delta int) error {
 	)
 }
 
+func libeiScrollBy(dx120, dy120, durationMs, refreshMhz int) error {
+	_, _, _, _ = dx120, dy120, durationMs, refreshMhz
+
+	return derrors.New(
+		derrors.CodeNotSupported,
+		"libei backend requires CGO-enabled Linux builds",
+	)
+}
+
 func libeiKey(keycode int, pressed bool) error {
 	_, _ = keycode, pressed
 
@@ -55,4 +78,8 @@ func libeiHasKeyboard() (bool, bool) {
 	return false, false
 }
 
+func libeiInjectStats() (ports.EventQueueStats, bool) {
+	return ports.EventQueueStats{}, false
+}
+
 func LibeiReset() {}
@@ -7,6 +7,8 @@ package linux
 #cgo linux CFLAGS: -DWLR_CPLUSPLUS
 #include <stdlib.h>
 #include "wlroots_client.h"
+
+extern void neruPointerGlideDone(uint64_t token, int completed);
 */
 import "C"
 
@@ -19,6 +21,7 @@ import (
 	"unsafe"
 
 	derrors "github.com/y3owk1n/neru/internal/core/errors"
+	"github.com/y3owk1n/neru/internal/core/ports"
 	// Blank-import to link the wayland-scanner generated protocol objects.
 	_ "github.com/y3owk1n/neru/internal/core/infra/platform/linux/wlr_protocol"
 )
@@ -299,6 +302,57 @@ func wlrootsMoveCursorToPoint(point image.Point) error {
 	return nil
 }
 
+// wlrootsGlideCursorToPoint glides the virtual pointer from the cached cursor
+// position to point over durationMs, one frame per refresh of the output under
+// point. It returns once the glide has started; token is finished in
+// globalPointerGlides when the glide ends.
+func wlrootsGlideCursorToPoint(point image.Point, durationMs int, token uint64) error {
+	err := ensureWlrootsState()
+	if err != nil {
+		return err
+	}
+
+	globalWlrootsState.mu.Lock()
+	defer globalWlrootsState.mu.Unlock()
+
+	client := globalWlrootsState.client
+
+	if C.neru_wlr_glide_to(
+		client,
+		C.int(point.X),
+		C.int(point.Y),
+		C.int(durationMs),
+		C.NeruGlideDoneFn(C.neruPointerGlideDone),
+		C.uint64_t(token),
+	) == 0 { //nolint:nlreturn
+		return derrors.Newf(
+			derrors.CodeActionFailed,
+			"failed to glide wlroots virtual pointer to (%d, %d)",
+			point.X,
+			point.Y,
+		)
+	}
+
+	return nil
+}
+
+// wlrootsRefreshMhz returns the refresh rate in mHz of the output containing
+// point, or 0 when no output reported one.
+func wlrootsRefreshMhz(point image.Point) (int, error) {
+	err := ensureWlrootsState()
+	if err != nil {
+		return 0, err
+	}
+
+	globalWlrootsState.mu.RLock()
+	defer globalWlrootsState.mu.RUnlock()
+
+	client := globalWlrootsState.client
+	refresh := C.neru_wlr_refresh_mhz(client, C.int(point.X), C.int(point.Y)) //nolint:nlreturn
+
+	return int(refresh), nil
+}
+
 func wlrootsMoveCursorBy(delta image.Point) error {
 	err := ensureWlrootsState()
 	if err != nil {
@@ -441,38 +495,29 @@ func wlrootsScroll(axis, delta, discrete int) error {
 	return nil
 }
 
-func wlrootsScrollBatch(axis int, deltas, discretes []int) error {
-	if len(deltas) == 0 {
-		return nil
-	}
-
+// wlrootsScrollBy scrolls the virtual pointer by (dx120, dy120) value120 units
+// (positive = down/right) over durationMs, one frame per refresh of the output
+// under the cursor. It returns once the scroll has been queued or started.
+func wlrootsScrollBy(dx120, dy120, durationMs int) error {
 	err := ensureWlrootsState()
 	if err != nil {
 		return err
 	}
 
 	globalWlrootsState.mu.Lock()
-	client := globalWlrootsState.client
 	defer globalWlrootsState.mu.Unlock()
 
-	cDeltas := make([]C.int, len(deltas))
-	cDiscretes := make([]C.int, len(discretes))
-	for i := range deltas {
-		cDeltas[i] = C.int(deltas[i])
-		cDiscretes[i] = C.int(discretes[i])
-	}
+	client := globalWlrootsState.client
 
-	res := C.neru_wlr_scroll_batch(
+	if C.neru_wlr_scroll_by(
 		client,
-		C.int(axis),
-		&cDeltas[0],
-		&cDiscretes[0],
-		C.int(len(deltas)), //nolint:nlreturn
-	)
-	if res == 0 {
+		C.int(dx120),
+		C.int(dy120),
+		C.int(durationMs),
+	) == 0 { //nolint:nlreturn
 		return derrors.New(
 			derrors.CodeActionFailed,
-			"failed to perform wlroots batch scroll",
+			"failed to perform wlroots smooth scroll",
 		)
 	}
 
@@ -555,3 +600,31 @@ const (
 	WlrBtnRight  = 0x111
 	WlrBtnMiddle = 0x112
 )
+
+// wlrootsInjectStats reports the counters of the client's injection queue.
+// It never connects: ok is false until some other call has established the
+// client, or when the compositor offers neither virtual device.
+func wlrootsInjectStats() (ports.EventQueueStats, bool) {
+	globalWlrootsState.mu.RLock()
+	defer globalWlrootsState.mu.RUnlock()
+
+	if !globalWlrootsState.ready {
+		return ports.EventQueueStats{}, false
+	}
+
+	var stats C.NeruWlrInjectStats
+	if C.neru_wlr_inject_stats(globalWlrootsState.client, &stats) == 0 { //nolint:nlreturn
+		return ports.EventQueueStats{}, false
+	}
+
+	return ports.EventQueueStats{
+		Capacity:  int(stats.ring.capacity),
+		Produced:  uint64(stats.ring.produced),
+		Consumed:  uint64(stats.ring.consumed),
+		Dropped:   uint64(stats.ring.dropped),
+		HighWater: uint64(stats.ring.high_water),
+		Batches:   uint64(stats.batches),
+		Coalesced: uint64(stats.coalesced),
+		Frames:    uint64(stats.frames),
+	}, true
+}
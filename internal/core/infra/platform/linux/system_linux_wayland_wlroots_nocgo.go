@@ -6,6 +6,7 @@ import (
 	"image"
 
 	derrors "github.com/y3owk1n/neru/internal/core/errors"
+	"github.com/y3owk1n/neru/internal/core/ports"
 )
 
 func wlrootsScreenBounds() (image.Rectangle, error) {
@@ -47,6 +48,24 @@ func wlrootsMoveCursorToPoint(point image.Point) error {
 	)
 }
 
+func wlrootsGlideCursorToPoint(point image.Point, durationMs int, token uint64) error {
+	_, _, _ = point, durationMs, token
+
+	return derrors.New(
+		derrors.CodeNotSupported,
+		"wlroots backend requires CGO-enabled Linux builds",
+	)
+}
+
+func wlrootsRefreshMhz(point image.Point) (int, error) {
+	_ = point
+
+	return 0, derrors.New(
+		derrors.CodeNotSupported,
+		"wlroots backend requires CGO-enabled Linux builds",
+	)
+}
+
 func wlrootsMoveCursorBy(delta image.Point) error {
 	_ = delta
 
@@ -92,8 +111,8 @@ func wlrootsScroll(axis, delta, discrete int) error {
 	)
 }
 
-func wlrootsScrollBatch(axis int, deltas, discretes []int) error {
-	_, _, _ = axis, deltas, discretes
+func wlrootsScrollBy(dx120, dy120, durationMs int) error {
+	_, _, _ = dx120, dy120, durationMs
 
 	return derrors.New(
 		derrors.CodeNotSupported,
@@ -148,3 +167,7 @@ const (
 	WlrBtnRight  = 0x111
 	WlrBtnMiddle = 0x112
 )
+
+func wlrootsInjectStats() (ports.EventQueueStats, bool) {
+	return ports.EventQueueStats{}, false
+}
@@ -15,6 +15,7 @@ import (
 	"path/filepath"
 	"strconv"
 	"strings"
+	"sync"
 	"unsafe"
 
 	derrors "github.com/y3owk1n/neru/internal/core/errors"
@@ -26,6 +27,19 @@ type x11Monitor struct {
 	Primary bool
 }
 
+var x11InitThreadsOnce sync.Once
+
+// x11InitThreads makes Xlib safe to use from several threads. The injection
+// connection is shared by every goroutine that clicks or types, and Xlib only
+// honours XInitThreads when it runs before any other Xlib call, so this runs
+// once when the X11 backend comes up, before the first XOpenDisplay, rather
+// than on first injection.
+func x11InitThreads() {
+	x11InitThreadsOnce.Do(func() {
+		C.neru_x11_init_threads()
+	})
+}
+
 func x11OpenDisplay() (*C.Display, error) {
 	if os.Getenv("DISPLAY") == "" {
 		return nil, derrors.New(
@@ -45,13 +59,25 @@ func x11OpenDisplay() (*C.Display, error) {
 	return display, nil
 }
 
+func x11CloseDisplay(display *C.Display) {
+	C.neru_x11_close_display(display)
+}
+
 func x11CursorPosition() (image.Point, error) {
-	display, err := x11OpenDisplay()
-	if err != nil {
-		return image.Point{}, err
-	}
-	defer C.neru_x11_close_display(display) //nolint:nlreturn
+	var point image.Point
+
+	err := sharedX11Conn().do(func(display *C.Display) error {
+		var queryErr error
+
+		point, queryErr = x11QueryPointer(display)
+
+		return queryErr
+	})
+
+	return point, err
+}
 
+func x11QueryPointer(display *C.Display) (image.Point, error) {
 	var posX, posY C.int
 	if C.neru_x11_query_pointer(display, &posX, &posY) == 0 { //nolint:nlreturn
 		return image.Point{}, derrors.New(
@@ -64,49 +90,47 @@ func x11CursorPosition() (image.Point, error) {
 }
 
 func x11MoveCursorToPoint(point image.Point) error {
-	display, err := x11OpenDisplay()
-	if err != nil {
-		return err
-	}
-	defer C.neru_x11_close_display(display) //nolint:nlreturn
-
-	if C.neru_x11_move_pointer(display, C.int(point.X), C.int(point.Y)) == 0 { //nolint:nlreturn
-		return derrors.Newf(
-			derrors.CodeActionFailed,
-			"failed to move X11 pointer to (%d, %d)",
-			point.X,
-			point.Y,
-		)
-	}
+	return sharedX11Conn().do(func(display *C.Display) error {
+		if C.neru_x11_move_pointer(display, C.int(point.X), C.int(point.Y)) == 0 { //nolint:nlreturn
+			return derrors.Newf(
+				derrors.CodeActionFailed,
+				"failed to move X11 pointer to (%d, %d)",
+				point.X,
+				point.Y,
+			)
+		}
 
-	return nil
+		return nil
+	})
 }
 
 func x11FocusedApplicationPID() (int, error) {
-	display, err := x11OpenDisplay()
-	if err != nil {
-		return 0, err
-	}
-	defer C.neru_x11_close_display(display) //nolint:nlreturn
+	var pid int
+
+	err := sharedX11Conn().do(func(display *C.Display) error {
+		var window C.Window
+		if C.neru_x11_get_active_window(display, &window) == 0 { //nolint:nlreturn
+			return derrors.New(
+				derrors.CodeActionFailed,
+				"failed to query _NET_ACTIVE_WINDOW on X11",
+			)
+		}
 
-	var window C.Window
-	if C.neru_x11_get_active_window(display, &window) == 0 { //nolint:nlreturn
-		return 0, derrors.New(
-			derrors.CodeActionFailed,
-			"failed to query _NET_ACTIVE_WINDOW on X11",
-		)
-	}
+		var ok C.int
+		rawPID := C.neru_x11_get_window_pid(display, window, &ok) //nolint:nlreturn
+		if ok == 0 {
+			return derrors.New(
+				derrors.CodeActionFailed,
+				"failed to query _NET_WM_PID for active X11 window",
+			)
+		}
 
-	var ok C.int
-	pid := C.neru_x11_get_window_pid(display, window, &ok) //nolint:nlreturn
-	if ok == 0 {
-		return 0, derrors.New(
-			derrors.CodeActionFailed,
-			"failed to query _NET_WM_PID for active X11 window",
-		)
-	}
+		pid = int(rawPID)
 
-	return int(pid), nil
+		return nil
+	})
+
+	return pid, err
 }
 
 func linuxApplicationNameByPID(pid int) (string, error) {
@@ -143,12 +167,20 @@ func linuxApplicationBundleIDByPID(pid int) (string, error) {
 }
 
 func x11Monitors() ([]x11Monitor, error) {
-	display, err := x11OpenDisplay()
-	if err != nil {
-		return nil, err
-	}
-	defer C.neru_x11_close_display(display) //nolint:nlreturn
+	var monitors []x11Monitor
+
+	err := sharedX11Conn().do(func(display *C.Display) error {
+		var queryErr error
 
+		monitors, queryErr = x11QueryMonitors(display)
+
+		return queryErr
+	})
+
+	return monitors, err
+}
+
+func x11QueryMonitors(display *C.Display) ([]x11Monitor, error) {
 	var count C.int
 	raw := C.neru_x11_get_monitors(display, &count) //nolint:nlreturn
 	if raw == nil || count == 0 {
@@ -186,12 +218,24 @@ func x11Monitors() ([]x11Monitor, error) {
 }
 
 func x11ActiveScreenBounds() (image.Rectangle, error) {
-	monitors, err := x11Monitors()
-	if err != nil {
-		return image.Rectangle{}, err
-	}
+	var (
+		monitors []x11Monitor
+		cursor   image.Point
+	)
+
+	// Both queries ride one round of the connection thread.
+	err := sharedX11Conn().do(func(display *C.Display) error {
+		var queryErr error
+
+		monitors, queryErr = x11QueryMonitors(display)
+		if queryErr != nil {
+			return queryErr
+		}
+
+		cursor, queryErr = x11QueryPointer(display)
 
-	cursor, err := x11CursorPosition()
+		return queryErr
+	})
 	if err != nil {
 		return image.Rectangle{}, err
 	}
@@ -0,0 +1,122 @@
+//go:build linux && cgo
+
+package linux
+
+/*
+#include "x11_system.h"
+*/
+import "C"
+
+import (
+	"runtime"
+	"sync"
+)
+
+const (
+	// x11RequestQueueSize bounds how many callers can wait for the connection
+	// thread before submitters block.
+	x11RequestQueueSize = 32
+	// x11MaxBatch caps how many queued requests run back-to-back before the
+	// connection is flushed.
+	x11MaxBatch = 16
+)
+
+// x11Conn owns one long-lived Xlib connection for system queries (cursor
+// position, monitors, focused window). Opening a display costs a full
+// connection handshake, which used to be paid on every 16 ms indicator tick
+// and every click.
+//
+// Xlib is not thread-safe without XInitThreads, so the display is only ever
+// touched by one goroutine locked to its OS thread. Callers submit requests
+// on a queue; the thread drains whatever is queued, runs it back-to-back on
+// the same connection and flushes once. The connection is opened lazily and
+// reopened after the server goes away.
+type x11Conn struct {
+	requests chan x11Request
+}
+
+type x11Request struct {
+	run   func(display *C.Display) error
+	reply chan error
+}
+
+var (
+	x11ConnOnce sync.Once
+	x11ConnInst *x11Conn
+
+	x11ReplyPool = sync.Pool{New: func() any { return make(chan error, 1) }}
+)
+
+// sharedX11Conn returns the process-wide connection, starting its thread on
+// first use.
+func sharedX11Conn() *x11Conn {
+	x11ConnOnce.Do(func() {
+		x11ConnInst = &x11Conn{requests: make(chan x11Request, x11RequestQueueSize)}
+		go x11ConnInst.loop()
+	})
+
+	return x11ConnInst
+}
+
+// do runs fn on the connection thread and returns its error, or the error
+// from opening the display. fn must not retain display.
+func (c *x11Conn) do(fn func(display *C.Display) error) error {
+	reply := x11ReplyPool.Get().(chan error) //nolint:forcetypeassert
+
+	c.requests <- x11Request{run: fn, reply: reply}
+	err := <-reply
+
+	x11ReplyPool.Put(reply)
+
+	return err
+}
+
+func (c *x11Conn) loop() {
+	// The display stays bound to this thread for the life of the process.
+	runtime.LockOSThread()
+
+	var (
+		display *C.Display
+		batch   = make([]x11Request, 0, x11MaxBatch)
+	)
+
+	for req := range c.requests {
+		batch = append(batch[:0], req)
+
+	drain:
+		for len(batch) < x11MaxBatch {
+			select {
+			case next := <-c.requests:
+				batch = append(batch, next)
+			default:
+				break drain
+			}
+		}
+
+		// Closing a dead connection would itself trip Xlib's fatal I/O
+		// error handler, so a connection whose server went away is
+		// abandoned instead.
+		if display != nil && C.neru_x11_connection_alive(display) == 0 {
+			display = nil
+		}
+
+		if display == nil {
+			opened, err := x11OpenDisplay()
+			if err != nil {
+				for _, r := range batch {
+					r.reply <- err
+				}
+
+				continue
+			}
+
+			display = opened
+		}
+
+		for _, r := range batch {
+			r.reply <- r.run(display)
+		}
+
+		C.XFlush(display)
+	}
+}
@@ -0,0 +1,48 @@
+//go:build linux && cgo
+
+//nolint:testpackage // These benchmarks compare unexported X11 query paths directly.
+package linux
+
+import (
+	"os"
+	"testing"
+)
+
+// BenchmarkX11CursorPosition compares opening a display per query, as the
+// system queries used to, with the shared connection thread. It needs a
+// running X server.
+func BenchmarkX11CursorPosition(b *testing.B) {
+	if os.Getenv("DISPLAY") == "" {
+		b.Skip("DISPLAY not set")
+	}
+
+	b.Run("reconnect-per-call", func(b *testing.B) {
+		for range b.N {
+			display, err := x11OpenDisplay()
+			if err != nil {
+				b.Fatalf("x11OpenDisplay failed: %v", err)
+			}
+
+			_, err = x11QueryPointer(display)
+
+			x11CloseDisplay(display)
+
+			if err != nil {
+				b.Fatalf("x11QueryPointer failed: %v", err)
+			}
+		}
+
+		b.ReportMetric(float64(b.N)/b.Elapsed().Seconds(), "calls/s")
+	})
+
+	b.Run("persistent", func(b *testing.B) {
+		for range b.N {
+			_, err := x11CursorPosition()
+			if err != nil {
+				b.Fatalf("x11CursorPosition failed: %v", err)
+			}
+		}
+
+		b.ReportMetric(float64(b.N)/b.Elapsed().Seconds(), "calls/s")
+	})
+}
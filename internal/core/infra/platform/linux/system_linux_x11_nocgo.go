@@ -8,6 +8,8 @@ import (
 	derrors "github.com/y3owk1n/neru/internal/core/errors"
 )
 
+func x11InitThreads() {}
+
 func x11CursorPosition() (image.Point, error) {
 	return image.Point{}, derrors.New(
 		derrors.CodeNotSupported,
@@ -0,0 +1,307 @@
+#include "wayland_conn.h"
+
+#include "wlr_protocol/fractional-scale-v1.h"
+#include "wlr_protocol/layer-shell.h"
+#include "wlr_protocol/presentation-time.h"
+#include "wlr_protocol/relative-pointer-unstable-v1.h"
+#include "wlr_protocol/viewporter.h"
+#include "wlr_protocol/virtual-keyboard.h"
+#include "wlr_protocol/virtual-pointer.h"
+#include "wlr_protocol/xdg-output.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static pthread_mutex_t neru_wayland_conn_lock = PTHREAD_MUTEX_INITIALIZER;
+static NeruWaylandConn *neru_wayland_conn_shared;
+
+static int64_t neru_wayland_conn_now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// ---------- Output listeners ----------
+
+static void neru_conn_xdg_output_logical_position(
+    void *data, struct zxdg_output_v1 *xdg_output, int32_t x, int32_t y) {
+	NeruWaylandOutput *out = data;
+	out->x = x;
+	out->y = y;
+	out->conn->generation++;
+}
+
+static void neru_conn_xdg_output_logical_size(void *data, struct zxdg_output_v1 *xdg_output, int32_t w, int32_t h) {
+	NeruWaylandOutput *out = data;
+	out->width = w;
+	out->height = h;
+	out->conn->generation++;
+}
+
+static void neru_conn_xdg_output_done(void *data, struct zxdg_output_v1 *xdg_output) {}
+
+static void neru_conn_xdg_output_name(void *data, struct zxdg_output_v1 *xdg_output, const char *name) {
+	NeruWaylandOutput *out = data;
+	if (name) {
+		strncpy(out->name, name, sizeof(out->name) - 1);
+		out->name[sizeof(out->name) - 1] = '\0';
+	}
+	out->conn->generation++;
+}
+
+static void neru_conn_xdg_output_description(void *data, struct zxdg_output_v1 *xdg_output, const char *description) {
+}
+
+static const struct zxdg_output_v1_listener neru_conn_xdg_output_listener = {
+    .logical_position = neru_conn_xdg_output_logical_position,
+    .logical_size = neru_conn_xdg_output_logical_size,
+    .done = neru_conn_xdg_output_done,
+    .name = neru_conn_xdg_output_name,
+    .description = neru_conn_xdg_output_description,
+};
+
+// Positions come from xdg_output in logical pixels.
+static void neru_conn_wl_output_geometry(
+    void *data, struct wl_output *wl_output, int32_t x, int32_t y, int32_t physical_width, int32_t physical_height,
+    int32_t subpixel, const char *make, const char *model, int32_t transform) {}
+
+static void neru_conn_wl_output_mode(
+    void *data, struct wl_output *wl_output, uint32_t flags, int32_t width, int32_t height, int32_t refresh) {
+	NeruWaylandOutput *out = data;
+	if (flags & WL_OUTPUT_MODE_CURRENT) {
+		out->refresh_mhz = refresh;
+		out->conn->generation++;
+	}
+}
+
+static void neru_conn_wl_output_done(void *data, struct wl_output *wl_output) {}
+
+static void neru_conn_wl_output_scale(void *data, struct wl_output *wl_output, int32_t factor) {
+	NeruWaylandOutput *out = data;
+	out->scale = factor;
+	out->conn->generation++;
+}
+
+// Bound at version <= 3, so name and description are never sent.
+static const struct wl_output_listener neru_conn_wl_output_listener = {
+    .geometry = neru_conn_wl_output_geometry,
+    .mode = neru_conn_wl_output_mode,
+    .done = neru_conn_wl_output_done,
+    .scale = neru_conn_wl_output_scale,
+};
+
+static void neru_conn_watch_output(NeruWaylandConn *conn, NeruWaylandOutput *out) {
+	if (out->xdg_output || !conn->xdg_output_mgr)
+		return;
+	out->xdg_output = zxdg_output_manager_v1_get_xdg_output(conn->xdg_output_mgr, out->wl_output);
+	zxdg_output_v1_add_listener(out->xdg_output, &neru_conn_xdg_output_listener, out);
+}
+
+// ---------- Seat and presentation listeners ----------
+
+static void neru_conn_seat_capabilities(void *data, struct wl_seat *seat, uint32_t capabilities) {
+	NeruWaylandConn *conn = data;
+	conn->seat_capabilities = capabilities;
+}
+
+static void neru_conn_seat_name(void *data, struct wl_seat *seat, const char *name) {}
+
+static const struct wl_seat_listener neru_conn_seat_listener = {
+    .capabilities = neru_conn_seat_capabilities,
+    .name = neru_conn_seat_name,
+};
+
+static void neru_conn_presentation_clock_id(void *data, struct wp_presentation *presentation, uint32_t clk_id) {
+	NeruWaylandConn *conn = data;
+	conn->presentation_clock = (int)clk_id;
+}
+
+static const struct wp_presentation_listener neru_conn_presentation_listener = {
+    .clock_id = neru_conn_presentation_clock_id,
+};
+
+// ---------- Registry listener ----------
+
+static void neru_conn_registry_global(
+    void *data, struct wl_registry *registry, uint32_t name, const char *interface, uint32_t version) {
+	NeruWaylandConn *conn = data;
+
+	if (strcmp(interface, "wl_compositor") == 0) {
+		conn->compositor = wl_registry_bind(registry, name, &wl_compositor_interface, 4);
+	} else if (strcmp(interface, "wl_subcompositor") == 0) {
+		conn->subcompositor = wl_registry_bind(registry, name, &wl_subcompositor_interface, 1);
+	} else if (strcmp(interface, "wl_shm") == 0) {
+		conn->shm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
+	} else if (strcmp(interface, "zwlr_layer_shell_v1") == 0) {
+		conn->layer_shell = wl_registry_bind(registry, name, &zwlr_layer_shell_v1_interface, 1);
+	} else if (strcmp(interface, "wl_output") == 0) {
+		if (conn->nr_outputs < NERU_MAX_OUTPUTS) {
+			NeruWaylandOutput *out = &conn->outputs[conn->nr_outputs];
+			memset(out, 0, sizeof(*out));
+			out->scale = 1;
+			out->conn = conn;
+			out->wl_output = wl_registry_bind(registry, name, &wl_output_interface, 3 < version ? 3 : version);
+			wl_output_add_listener(out->wl_output, &neru_conn_wl_output_listener, out);
+			// During startup the manager may not be bound yet; acquire
+			// watches every output after the first roundtrip.
+			neru_conn_watch_output(conn, out);
+			conn->nr_outputs++;
+			conn->generation++;
+		}
+	} else if (strcmp(interface, "zxdg_output_manager_v1") == 0) {
+		conn->xdg_output_mgr =
+		    wl_registry_bind(registry, name, &zxdg_output_manager_v1_interface, 3 < version ? 3 : version);
+	} else if (strcmp(interface, "wl_seat") == 0) {
+		if (!conn->seat) {
+			conn->seat = wl_registry_bind(registry, name, &wl_seat_interface, 7 < version ? 7 : version);
+			wl_seat_add_listener(conn->seat, &neru_conn_seat_listener, conn);
+		}
+	} else if (strcmp(interface, "wp_presentation") == 0) {
+		conn->presentation = wl_registry_bind(registry, name, &wp_presentation_interface, 1);
+		wp_presentation_add_listener(conn->presentation, &neru_conn_presentation_listener, conn);
+	} else if (strcmp(interface, "wp_fractional_scale_manager_v1") == 0) {
+		conn->fractional_scale_mgr = wl_registry_bind(registry, name, &wp_fractional_scale_manager_v1_interface, 1);
+	} else if (strcmp(interface, "wp_viewporter") == 0) {
+		conn->viewporter = wl_registry_bind(registry, name, &wp_viewporter_interface, 1);
+	} else if (strcmp(interface, "zwlr_virtual_pointer_manager_v1") == 0) {
+		conn->vptr_mgr = wl_registry_bind(registry, name, &zwlr_virtual_pointer_manager_v1_interface, 1);
+	} else if (strcmp(interface, "zwp_virtual_keyboard_manager_v1") == 0) {
+		conn->vkeyboard_mgr = wl_registry_bind(registry, name, &zwp_virtual_keyboard_manager_v1_interface, 1);
+	} else if (strcmp(interface, "zwp_relative_pointer_manager_v1") == 0) {
+		conn->rel_ptr_mgr = wl_registry_bind(registry, name, &zwp_relative_pointer_manager_v1_interface, 1);
+	}
+}
+
+static void neru_conn_registry_global_remove(void *data, struct wl_registry *registry, uint32_t name) {
+	// Outputs are never dropped from the table: both consumers keep
+	// per-output state at the same index. The overlay releases a surface
+	// whose output went away when the compositor closes it.
+}
+
+static const struct wl_registry_listener neru_conn_registry_listener = {
+    .global = neru_conn_registry_global,
+    .global_remove = neru_conn_registry_global_remove,
+};
+
+// ---------- Lifecycle ----------
+
+static void neru_conn_destroy(NeruWaylandConn *conn) {
+	for (int i = 0; i < conn->nr_outputs; i++) {
+		if (conn->outputs[i].xdg_output)
+			zxdg_output_v1_destroy(conn->outputs[i].xdg_output);
+	}
+	if (conn->xdg_output_mgr)
+		zxdg_output_manager_v1_destroy(conn->xdg_output_mgr);
+	if (conn->layer_shell)
+		zwlr_layer_shell_v1_destroy(conn->layer_shell);
+	if (conn->presentation)
+		wp_presentation_destroy(conn->presentation);
+	if (conn->fractional_scale_mgr)
+		wp_fractional_scale_manager_v1_destroy(conn->fractional_scale_mgr);
+	if (conn->viewporter)
+		wp_viewporter_destroy(conn->viewporter);
+	if (conn->subcompositor)
+		wl_subcompositor_destroy(conn->subcompositor);
+	if (conn->registry)
+		wl_registry_destroy(conn->registry);
+	wl_display_disconnect(conn->display);
+	pthread_mutex_destroy(&conn->mutex);
+	free(conn);
+}
+
+static NeruWaylandConn *neru_conn_open(void) {
+	int64_t start = neru_wayland_conn_now_ns();
+
+	NeruWaylandConn *conn = calloc(1, sizeof(*conn));
+	if (!conn)
+		return NULL;
+
+	conn->display = wl_display_connect(NULL);
+	if (!conn->display) {
+		free(conn);
+		return NULL;
+	}
+	pthread_mutex_init(&conn->mutex, NULL);
+	conn->presentation_clock = CLOCK_MONOTONIC;
+	conn->generation = 1;
+
+	conn->registry = wl_display_get_registry(conn->display);
+	wl_registry_add_listener(conn->registry, &neru_conn_registry_listener, conn);
+
+	// First roundtrip binds the globals. The second delivers everything they
+	// send on bind (output geometry, modes and scales, seat capabilities,
+	// presentation clock) in one go.
+	wl_display_roundtrip(conn->display);
+	conn->stats.roundtrips++;
+
+	for (int i = 0; i < conn->nr_outputs; i++)
+		neru_conn_watch_output(conn, &conn->outputs[i]);
+	if (conn->nr_outputs > 0 || conn->seat || conn->presentation) {
+		wl_display_roundtrip(conn->display);
+		conn->stats.roundtrips++;
+	}
+
+	conn->stats.connect_ns = neru_wayland_conn_now_ns() - start;
+	return conn;
+}
+
+NeruWaylandConn *neru_wayland_conn_acquire(void) {
+	pthread_mutex_lock(&neru_wayland_conn_lock);
+	if (!neru_wayland_conn_shared)
+		neru_wayland_conn_shared = neru_conn_open();
+	NeruWaylandConn *conn = neru_wayland_conn_shared;
+	if (conn)
+		conn->refs++;
+	pthread_mutex_unlock(&neru_wayland_conn_lock);
+	return conn;
+}
+
+void neru_wayland_conn_release(NeruWaylandConn *conn) {
+	if (!conn)
+		return;
+
+	pthread_mutex_lock(&neru_wayland_conn_lock);
+	if (--conn->refs == 0) {
+		neru_conn_destroy(conn);
+		neru_wayland_conn_shared = NULL;
+	}
+	pthread_mutex_unlock(&neru_wayland_conn_lock);
+}
+
+void *neru_wayland_conn_wrap(void *global, struct wl_event_queue *queue) {
+	if (!global)
+		return NULL;
+	void *wrapper = wl_proxy_create_wrapper(global);
+	if (wrapper)
+		wl_proxy_set_queue((struct wl_proxy *)wrapper, queue);
+	return wrapper;
+}
+
+int neru_wayland_conn_dispatch(NeruWaylandConn *conn) {
+	pthread_mutex_lock(&conn->mutex);
+	int ret = wl_display_dispatch_pending(conn->display);
+	pthread_mutex_unlock(&conn->mutex);
+	return ret;
+}
+
+int neru_wayland_conn_outputs(NeruWaylandConn *conn, NeruWaylandOutput *out, uint64_t *generation) {
+	pthread_mutex_lock(&conn->mutex);
+	int n = -1;
+	if (conn->generation != *generation) {
+		n = conn->nr_outputs;
+		memcpy(out, conn->outputs, (size_t)n * sizeof(*out));
+		*generation = conn->generation;
+	}
+	pthread_mutex_unlock(&conn->mutex);
+	return n;
+}
+
+uint32_t neru_wayland_conn_seat_capabilities(NeruWaylandConn *conn) {
+	pthread_mutex_lock(&conn->mutex);
+	uint32_t capabilities = conn->seat_capabilities;
+	pthread_mutex_unlock(&conn->mutex);
+	return capabilities;
+}
+
+void neru_wayland_conn_stats(NeruWaylandConn *conn, NeruWaylandConnStats *out) { *out = conn->stats; }
@@ -0,0 +1,90 @@
+#ifndef WAYLAND_CONN_H
+#define WAYLAND_CONN_H
+
+#include "common_defs.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <wayland-client.h>
+
+struct NeruWaylandConn;
+
+// One output as last described by the compositor: logical geometry and name
+// from xdg_output, scale and refresh rate from wl_output.
+typedef struct {
+	struct wl_output *wl_output;
+	struct zxdg_output_v1 *xdg_output;
+	int x, y, width, height;
+	int scale;
+	int refresh_mhz;  // current mode, 0 until wl_output.mode reports it
+	char name[128];
+	struct NeruWaylandConn *conn;
+} NeruWaylandOutput;
+
+// What bringing the connection up cost, for the startup log.
+typedef struct {
+	int64_t connect_ns;  // wl_display_connect through the last startup roundtrip
+	int roundtrips;
+} NeruWaylandConnStats;
+
+// The process-wide Wayland connection shared by the overlay (overlay_wayland.c)
+// and the input client (wlroots_client.c). The registry is read once, every
+// global either of them needs is bound once, and one set of wl_output and
+// xdg_output listeners keeps the output table below current for both.
+//
+// The globals and outputs live on the default event queue. Each consumer
+// creates its own objects on a private queue through neru_wayland_conn_wrap
+// and only dispatches that queue, so the overlay never runs the input
+// thread's callbacks and vice versa. Whichever consumer reads the socket then
+// calls neru_wayland_conn_dispatch for the shared objects' events.
+typedef struct NeruWaylandConn {
+	struct wl_display *display;
+	struct wl_registry *registry;
+
+	struct wl_compositor *compositor;
+	struct wl_subcompositor *subcompositor;
+	struct wl_shm *shm;
+	struct zwlr_layer_shell_v1 *layer_shell;
+	struct zxdg_output_manager_v1 *xdg_output_mgr;
+	struct wl_seat *seat;
+	struct wp_presentation *presentation;
+	struct wp_fractional_scale_manager_v1 *fractional_scale_mgr;
+	struct wp_viewporter *viewporter;
+	struct zwlr_virtual_pointer_manager_v1 *vptr_mgr;
+	struct zwp_virtual_keyboard_manager_v1 *vkeyboard_mgr;
+	struct zwp_relative_pointer_manager_v1 *rel_ptr_mgr;
+
+	// Guards dispatching the default queue and everything its listeners
+	// write below.
+	pthread_mutex_t mutex;
+	uint32_t seat_capabilities;
+	int presentation_clock;
+	NeruWaylandOutput outputs[NERU_MAX_OUTPUTS];
+	int nr_outputs;
+	// Bumped whenever an output appears or any of its fields changes.
+	uint64_t generation;
+
+	int refs;  // guarded by the lock in wayland_conn.c
+	NeruWaylandConnStats stats;
+} NeruWaylandConn;
+
+// Returns the shared connection, connecting on first use, or NULL when no
+// compositor is reachable. Pair every call with neru_wayland_conn_release.
+NeruWaylandConn *neru_wayland_conn_acquire(void);
+// Disconnects once the last consumer let go. A consumer must destroy its
+// objects and event queue before releasing.
+void neru_wayland_conn_release(NeruWaylandConn *conn);
+// Wrapper of global whose new objects are created on queue, or NULL when the
+// global is missing. Free it with wl_proxy_wrapper_destroy.
+void *neru_wayland_conn_wrap(void *global, struct wl_event_queue *queue);
+// Dispatches the shared objects' events that were already read. Returns -1
+// when the connection failed.
+int neru_wayland_conn_dispatch(NeruWaylandConn *conn);
+// Copies all outputs into out (NERU_MAX_OUTPUTS entries) if they changed
+// since *generation and updates it. Returns the output count, or -1 when
+// nothing changed.
+int neru_wayland_conn_outputs(NeruWaylandConn *conn, NeruWaylandOutput *out, uint64_t *generation);
+uint32_t neru_wayland_conn_seat_capabilities(NeruWaylandConn *conn);
+void neru_wayland_conn_stats(NeruWaylandConn *conn, NeruWaylandConnStats *out);
+
+#endif /* WAYLAND_CONN_H */
@@ -2,6 +2,7 @@
 #include <fcntl.h>
 #include <poll.h>
 #include <pthread.h>
+#include <sched.h>
 #include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
@@ -15,7 +16,6 @@
 #include "wlr_protocol/relative-pointer-unstable-v1.h"
 #include "wlr_protocol/virtual-keyboard.h"
 #include "wlr_protocol/virtual-pointer.h"
-#include "wlr_protocol/xdg-output.h"
 #include "wlr_protocol/xdg-shell.h"
 #include "wlroots_client.h"
 
@@ -208,91 +208,30 @@ static int neru_wlr_setup_virtual_keyboard(NeruWlrootsClient *c) {
 	return 1;
 }
 
-// ---------- xdg_output listener ----------
+// ---------- Outputs ----------
 
-static void neru_xdg_output_logical_position(void *data, struct zxdg_output_v1 *xdg_output, int32_t x, int32_t y) {
-	NeruWaylandScreen *scr = (NeruWaylandScreen *)data;
-	scr->x = x;
-	scr->y = y;
-	scr->state |= 1;
-}
-
-static void neru_xdg_output_logical_size(void *data, struct zxdg_output_v1 *xdg_output, int32_t w, int32_t h) {
-	NeruWaylandScreen *scr = (NeruWaylandScreen *)data;
-	scr->w = w;
-	scr->h = h;
-	scr->state |= 2;
-}
-
-static void neru_xdg_output_done(void *data, struct zxdg_output_v1 *xdg_output) {
-	// No-op for v3+.
-}
-
-static void neru_xdg_output_name(void *data, struct zxdg_output_v1 *xdg_output, const char *name) {
-	NeruWaylandScreen *scr = (NeruWaylandScreen *)data;
-	if (name) {
-		strncpy(scr->name, name, sizeof(scr->name) - 1);
-		scr->name[sizeof(scr->name) - 1] = '\0';
-	}
-	scr->state |= 4;
-}
-
-static void neru_xdg_output_description(void *data, struct zxdg_output_v1 *xdg_output, const char *description) {
-	// No-op.
-}
-
-static const struct zxdg_output_v1_listener neru_xdg_output_listener = {
-    .logical_position = neru_xdg_output_logical_position,
-    .logical_size = neru_xdg_output_logical_size,
-    .done = neru_xdg_output_done,
-    .name = neru_xdg_output_name,
-    .description = neru_xdg_output_description,
-};
-
-// ---------- Registry listener ----------
-
-static void neru_wlr_registry_global(
-    void *data, struct wl_registry *registry, uint32_t name, const char *interface, uint32_t version) {
-	NeruWlrootsClient *c = (NeruWlrootsClient *)data;
+// Picks up output changes published by the shared connection. Must be called
+// with display_mutex held.
+static void neru_wlr_sync_outputs(NeruWlrootsClient *c) {
+	NeruWaylandOutput outputs[NERU_MAX_OUTPUTS];
+	int n = neru_wayland_conn_outputs(c->conn, outputs, &c->outputs_generation);
+	if (n < 0)
+		return;
 
-	if (strcmp(interface, "zwlr_virtual_pointer_manager_v1") == 0) {
-		c->vptr_mgr = wl_registry_bind(registry, name, &zwlr_virtual_pointer_manager_v1_interface, 1);
-	} else if (strcmp(interface, "zwp_virtual_keyboard_manager_v1") == 0) {
-		c->vkeyboard_mgr = wl_registry_bind(registry, name, &zwp_virtual_keyboard_manager_v1_interface, 1);
-	} else if (strcmp(interface, "wl_compositor") == 0) {
-		c->compositor = wl_registry_bind(registry, name, &wl_compositor_interface, 4);
-	} else if (strcmp(interface, "zwlr_layer_shell_v1") == 0) {
-		c->layer_shell = wl_registry_bind(registry, name, &zwlr_layer_shell_v1_interface, 1);
-	} else if (strcmp(interface, "wl_shm") == 0) {
-		c->shm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
-	} else if (strcmp(interface, "zwp_relative_pointer_manager_v1") == 0) {
-		c->rel_ptr_mgr = wl_registry_bind(registry, name, &zwp_relative_pointer_manager_v1_interface, 1);
-	} else if (strcmp(interface, "wl_seat") == 0) {
-		c->seat = wl_registry_bind(registry, name, &wl_seat_interface, 7 < version ? 7 : version);
-		c->pointer = wl_seat_get_pointer(c->seat);
-		wl_pointer_add_listener(c->pointer, &neru_wlr_pointer_listener, c);
-	} else if (strcmp(interface, "wl_output") == 0) {
-		if (c->nr_screens < NERU_MAX_OUTPUTS) {
-			NeruWaylandScreen *scr = &c->screens[c->nr_screens];
-			memset(scr, 0, sizeof(*scr));
-			scr->wl_output = wl_registry_bind(registry, name, &wl_output_interface, 3 < version ? 3 : version);
-			c->nr_screens++;
-		}
-	} else if (strcmp(interface, "zxdg_output_manager_v1") == 0) {
-		c->xdg_output_mgr =
-		    wl_registry_bind(registry, name, &zxdg_output_manager_v1_interface, 3 < version ? 3 : version);
+	for (int i = 0; i < n; i++) {
+		NeruWaylandScreen *scr = &c->screens[i];
+		scr->wl_output = outputs[i].wl_output;
+		scr->x = outputs[i].x;
+		scr->y = outputs[i].y;
+		scr->w = outputs[i].width;
+		scr->h = outputs[i].height;
+		scr->refresh_mhz = outputs[i].refresh_mhz;
+		memcpy(scr->name, outputs[i].name, sizeof(scr->name));
 	}
+	c->nr_screens = n;
+	c->extent_valid = 0;
 }
 
-static void neru_wlr_registry_global_remove(void *data, struct wl_registry *registry, uint32_t name) {
-	// TODO: handle hotplug.
-}
-
-static const struct wl_registry_listener neru_wlr_registry_listener = {
-    .global = neru_wlr_registry_global,
-    .global_remove = neru_wlr_registry_global_remove,
-};
-
 // ---------- Dispatch thread ----------
 
 static void *neru_wlr_dispatch_loop(void *arg) {
@@ -300,8 +239,8 @@ static void *neru_wlr_dispatch_loop(void *arg) {
 	while (c->dispatch_running) {
 		// Non-blocking prepare-read under lock
 		pthread_mutex_lock(&c->display_mutex);
-		if (wl_display_prepare_read(c->display) < 0) {
-			wl_display_dispatch_pending(c->display);
+		if (wl_display_prepare_read_queue(c->display, c->queue) < 0) {
+			wl_display_dispatch_queue_pending(c->display, c->queue);
 			pthread_mutex_unlock(&c->display_mutex);
 			continue;
 		}
@@ -331,7 +270,10 @@ static void *neru_wlr_dispatch_loop(void *arg) {
 				pthread_mutex_unlock(&c->display_mutex);
 				break;
 			}
-			wl_display_dispatch_pending(c->display);
+			// The read may have queued overlay and shared-object events too;
+			// the shared ones are dispatched here, the overlay's by the overlay.
+			wl_display_dispatch_queue_pending(c->display, c->queue);
+			neru_wayland_conn_dispatch(c->conn);
 		} else {
 			wl_display_cancel_read(c->display);
 		}
@@ -351,6 +293,215 @@ int neru_wlr_start_dispatch(NeruWlrootsClient *c) {
 	return 1;
 }
 
+// ---------- Absolute motion ----------
+
+// Recomputes the bounding box of all screens when an output changed since
+// the last motion. Must be called with display_mutex held.
+static void neru_wlr_update_extent(NeruWlrootsClient *c) {
+	neru_wlr_sync_outputs(c);
+	if (c->extent_valid)
+		return;
+
+	int minx = 0, miny = 0, maxx = 0, maxy = 0;
+	for (int i = 0; i < c->nr_screens; i++) {
+		NeruWaylandScreen *scr = &c->screens[i];
+		if (i == 0 || scr->x < minx)
+			minx = scr->x;
+		if (i == 0 || scr->y < miny)
+			miny = scr->y;
+		int right = scr->x + scr->w;
+		int bottom = scr->y + scr->h;
+		if (i == 0 || right > maxx)
+			maxx = right;
+		if (i == 0 || bottom > maxy)
+			maxy = bottom;
+	}
+
+	c->extent_x = minx;
+	c->extent_y = miny;
+	c->extent_w = maxx - minx;
+	c->extent_h = maxy - miny;
+	c->extent_valid = 1;
+}
+
+// ---------- Injection writer ----------
+
+// Button codes for linux/input-event-codes.h
+#define NERU_BTN_LEFT 0x110
+#define NERU_BTN_RIGHT 0x111
+#define NERU_BTN_MIDDLE 0x112
+
+#define NERU_WLR_INJECT_CAPACITY 512
+#define NERU_WLR_INJECT_BATCH 64
+
+// Logical pixels one wheel notch scrolls; the scroll service's pixel deltas
+// use the same scale.
+#define NERU_WLR_SCROLL_PX_PER_NOTCH 30
+
+static void neru_wlr_frame_close(NeruWlrootsClient *c, NeruInjectFrame *f, uint64_t *frames) {
+	if (!f->open)
+		return;
+	zwlr_virtual_pointer_v1_frame(c->vptr);
+	(*frames)++;
+	*f = (NeruInjectFrame){0};
+}
+
+// Sends one batch under a single display_mutex hold and flushes it once.
+// Runs of motions collapse: only the last absolute position is visible to
+// clients anyway, and relative deltas add up. Frames follow the rules of
+// NeruInjectFrame.
+static void neru_wlr_write_batch(NeruWlrootsClient *c, const NeruInjectCmd *cmds, int n) {
+	NeruInjectFrame f = {0};
+	uint64_t frames = 0;
+	uint64_t coalesced = 0;
+
+	pthread_mutex_lock(&c->display_mutex);
+	for (int i = 0; i < n; i++) {
+		const NeruInjectCmd *cmd = &cmds[i];
+		if (neru_inject_frame_breaks(&f, cmd))
+			neru_wlr_frame_close(c, &f, &frames);
+
+		switch (cmd->kind) {
+		case NERU_INJECT_MOTION_ABS:
+		case NERU_INJECT_MOTION_REL: {
+			NeruInjectCmd motion;
+			int last = neru_inject_coalesce_motion(cmds, n, i, &motion);
+			coalesced += (uint64_t)(last - i);
+			i = last;
+			if (motion.kind == NERU_INJECT_MOTION_ABS) {
+				neru_wlr_update_extent(c);
+				zwlr_virtual_pointer_v1_motion_absolute(
+				    c->vptr, 0, wl_fixed_from_int(motion.a - c->extent_x),
+				    wl_fixed_from_int(motion.b - c->extent_y), wl_fixed_from_int(c->extent_w),
+				    wl_fixed_from_int(c->extent_h));
+				c->cursor_x_frac = 0;
+				c->cursor_y_frac = 0;
+			} else {
+				zwlr_virtual_pointer_v1_motion(c->vptr, 0, wl_fixed_from_int(motion.a), wl_fixed_from_int(motion.b));
+			}
+			neru_inject_frame_add(&f, &motion);
+			neru_wlr_frame_close(c, &f, &frames);
+			break;
+		}
+		case NERU_INJECT_BUTTON:
+			zwlr_virtual_pointer_v1_button(c->vptr, 0, (uint32_t)cmd->a, cmd->b ? 1 : 0);
+			neru_inject_frame_add(&f, cmd);
+			break;
+		case NERU_INJECT_AXIS:
+		case NERU_INJECT_AXIS_CONTINUOUS: {
+			if (f.axes == 0) {
+				zwlr_virtual_pointer_v1_axis_source(
+				    c->vptr, cmd->kind == NERU_INJECT_AXIS ? WL_POINTER_AXIS_SOURCE_WHEEL
+				                                           : WL_POINTER_AXIS_SOURCE_CONTINUOUS);
+			}
+			if (cmd->kind == NERU_INJECT_AXIS_CONTINUOUS) {
+				zwlr_virtual_pointer_v1_axis(c->vptr, 0, (uint32_t)cmd->a, (wl_fixed_t)cmd->b);
+			} else if (cmd->c != 0) {
+				zwlr_virtual_pointer_v1_axis_discrete(
+				    c->vptr, 0, (uint32_t)cmd->a, wl_fixed_from_int(cmd->b), cmd->c);
+			} else {
+				zwlr_virtual_pointer_v1_axis(c->vptr, 0, (uint32_t)cmd->a, wl_fixed_from_int(cmd->b));
+			}
+			neru_inject_frame_add(&f, cmd);
+			if (cmd->kind == NERU_INJECT_AXIS_CONTINUOUS && cmd->c) {
+				// wlroots turns axis_stop into a zero delta on that axis of the
+				// pending frame, so it gets a frame of its own after the last delta.
+				neru_wlr_frame_close(c, &f, &frames);
+				zwlr_virtual_pointer_v1_axis_source(c->vptr, WL_POINTER_AXIS_SOURCE_CONTINUOUS);
+				zwlr_virtual_pointer_v1_axis_stop(c->vptr, 0, (uint32_t)cmd->a);
+				neru_inject_frame_add(&f, cmd);
+			}
+			break;
+		}
+		case NERU_INJECT_KEY:
+			zwp_virtual_keyboard_v1_key(c->vkeyboard, cmd->time, (uint32_t)cmd->a, cmd->b ? 1 : 0);
+			break;
+		case NERU_INJECT_MODIFIER:
+			if (cmd->b) {
+				c->depressed_mods |= (uint32_t)cmd->a;
+			} else {
+				c->depressed_mods &= ~(uint32_t)cmd->a;
+			}
+			zwp_virtual_keyboard_v1_modifiers(c->vkeyboard, c->depressed_mods, 0, 0, 0);
+			break;
+		}
+	}
+	neru_wlr_frame_close(c, &f, &frames);
+	// Ignore the flush result: on EAGAIN the requests stay in the client
+	// buffer and the dispatch loop flushes them before it next polls.
+	wl_display_flush(c->display);
+	pthread_mutex_unlock(&c->display_mutex);
+
+	atomic_fetch_add(&c->inject_batches, 1);
+	atomic_fetch_add(&c->inject_coalesced, coalesced);
+	atomic_fetch_add(&c->inject_frames, frames);
+}
+
+static void *neru_wlr_inject_loop(void *arg) {
+	NeruWlrootsClient *c = (NeruWlrootsClient *)arg;
+	NeruInjectCmd batch[NERU_WLR_INJECT_BATCH];
+	int n;
+	while ((n = neru_inject_ring_wait(c->inject, batch, NERU_WLR_INJECT_BATCH)) > 0)
+		neru_wlr_write_batch(c, batch, n);
+	return NULL;
+}
+
+// Queues a command that must not be dropped, giving the writer a moment to
+// make room when the ring is full.
+static int neru_wlr_push_retry(NeruWlrootsClient *c, const NeruInjectCmd *cmd) {
+	if (neru_inject_ring_push(c->inject, cmd))
+		return 1;
+	for (int attempt = 0; attempt < 100; attempt++) {
+		sched_yield();
+		if (neru_inject_ring_push(c->inject, cmd))
+			return 1;
+	}
+	return 0;
+}
+
+// Queues cmd. A release that finds the ring full would leave its button, key
+// or modifier held in the compositor, so it is retried instead of dropped.
+static int neru_wlr_push(NeruWlrootsClient *c, const NeruInjectCmd *cmd) {
+	if (cmd->b)
+		return neru_inject_ring_push(c->inject, cmd);
+	return neru_wlr_push_retry(c, cmd);
+}
+
+// Queues an absolute motion and updates the cursor cache right away, so
+// callers reading it back see the target even before the writer sends it.
+static int neru_wlr_queue_absolute(NeruWlrootsClient *c, int x, int y) {
+	NeruInjectCmd cmd = {.kind = NERU_INJECT_MOTION_ABS, .a = x, .b = y};
+	if (!neru_inject_ring_push(c->inject, &cmd))
+		return 0;
+
+	atomic_store(&c->cursor_x, x);
+	atomic_store(&c->cursor_y, y);
+	atomic_store(&c->cursor_initialized, 1);
+	return 1;
+}
+
+// The glide engine's per-frame callback.
+static void neru_wlr_glide_emit(void *ctx, int x, int y) { neru_wlr_queue_absolute(ctx, x, y); }
+
+// The scroll glide's per-frame callback. value120 maps exactly onto wl_fixed
+// pixels: 120 units are NERU_WLR_SCROLL_PX_PER_NOTCH pixels. The last delta
+// carries the axis_stop, which like a release must not be lost to a full ring.
+static void neru_wlr_scroll_emit(void *ctx, int axis, int value120, int last) {
+	NeruWlrootsClient *c = ctx;
+	NeruInjectCmd cmd = {
+	    .kind = NERU_INJECT_AXIS_CONTINUOUS,
+	    .a = axis,
+	    .b = (int)((int64_t)value120 * wl_fixed_from_int(NERU_WLR_SCROLL_PX_PER_NOTCH) /
+	               NERU_SCROLL_VALUE120_PER_NOTCH),
+	    .c = last,
+	};
+	if (last) {
+		neru_wlr_push_retry(c, &cmd);
+	} else {
+		neru_inject_ring_push(c->inject, &cmd);
+	}
+}
+
 // ---------- Connect & initialize ----------
 
 NeruWlrootsClient *neru_wlr_connect(void) {
@@ -358,25 +509,41 @@ NeruWlrootsClient *neru_wlr_connect(void) {
 	if (!c)
 		return NULL;
 
-	c->display = wl_display_connect(NULL);
-	if (!c->display) {
+	// Globals and output geometry come from the shared connection, which
+	// costs no roundtrip here when the overlay connected first.
+	c->conn = neru_wayland_conn_acquire();
+	if (!c->conn) {
 		free(c);
 		return NULL;
 	}
+	NeruWaylandConn *conn = c->conn;
+	c->display = conn->display;
+	c->queue = wl_display_create_queue(c->display);
+	c->compositor = neru_wayland_conn_wrap(conn->compositor, c->queue);
+	c->layer_shell = neru_wayland_conn_wrap(conn->layer_shell, c->queue);
+	c->seat = neru_wayland_conn_wrap(conn->seat, c->queue);
+	c->rel_ptr_mgr = neru_wayland_conn_wrap(conn->rel_ptr_mgr, c->queue);
 
-	c->registry = wl_display_get_registry(c->display);
-	wl_registry_add_listener(c->registry, &neru_wlr_registry_listener, c);
+	// Initialize display mutex. Dispatch thread is started later
+	// via neru_wlr_start_dispatch() to avoid reader_count conflicts
+	// with neru_wlr_init_cursor() which also does roundtrips.
+	pthread_mutex_init(&c->display_mutex, NULL);
+	pthread_mutex_lock(&c->display_mutex);
+	neru_wlr_sync_outputs(c);
+	pthread_mutex_unlock(&c->display_mutex);
 
-	// First roundtrip: discover globals.
-	wl_display_roundtrip(c->display);
+	if (c->seat) {
+		c->pointer = wl_seat_get_pointer(c->seat);
+		wl_pointer_add_listener(c->pointer, &neru_wlr_pointer_listener, c);
+	}
 
 	// Create virtual pointer if manager was found.
-	if (c->vptr_mgr) {
-		c->vptr = zwlr_virtual_pointer_manager_v1_create_virtual_pointer(c->vptr_mgr, c->seat);
+	if (conn->vptr_mgr) {
+		c->vptr = zwlr_virtual_pointer_manager_v1_create_virtual_pointer(conn->vptr_mgr, conn->seat);
 	}
 
-	if (c->vkeyboard_mgr && c->seat) {
-		c->vkeyboard = zwp_virtual_keyboard_manager_v1_create_virtual_keyboard(c->vkeyboard_mgr, c->seat);
+	if (conn->vkeyboard_mgr && conn->seat) {
+		c->vkeyboard = zwp_virtual_keyboard_manager_v1_create_virtual_keyboard(conn->vkeyboard_mgr, conn->seat);
 		neru_wlr_setup_virtual_keyboard(c);
 	}
 
@@ -386,41 +553,51 @@ NeruWlrootsClient *neru_wlr_connect(void) {
 		zwp_relative_pointer_v1_add_listener(c->rel_ptr, &neru_wlr_relative_pointer_listener, c);
 	}
 
-	// Initialize xdg_output for each screen.
-	if (c->xdg_output_mgr) {
-		for (int i = 0; i < c->nr_screens; i++) {
-			NeruWaylandScreen *scr = &c->screens[i];
-			scr->xdg_output = zxdg_output_manager_v1_get_xdg_output(c->xdg_output_mgr, scr->wl_output);
-			zxdg_output_v1_add_listener(scr->xdg_output, &neru_xdg_output_listener, scr);
+	if (c->vptr || c->vkeyboard) {
+		c->inject = neru_inject_ring_new(NERU_WLR_INJECT_CAPACITY);
+		if (c->inject && pthread_create(&c->inject_thread, NULL, neru_wlr_inject_loop, c) != 0) {
+			neru_inject_ring_free(c->inject);
+			c->inject = NULL;
 		}
-		// Second roundtrip: receive xdg_output events.
-		wl_display_roundtrip(c->display);
 	}
 
-	// Initialize display mutex. Dispatch thread is started later
-	// via neru_wlr_start_dispatch() to avoid reader_count conflicts
-	// with neru_wlr_init_cursor() which also does roundtrips.
-	pthread_mutex_init(&c->display_mutex, NULL);
+	if (c->vptr && c->inject) {
+		c->glide = neru_glide_new(neru_wlr_glide_emit, c);
+		c->scroll = neru_scroll_glide_new(neru_wlr_scroll_emit, c);
+	}
 
 	c->connected = 1;
 	return c;
 }
 
+static void neru_wlr_unwrap(void *wrapper) {
+	if (wrapper)
+		wl_proxy_wrapper_destroy(wrapper);
+}
+
 void neru_wlr_disconnect(NeruWlrootsClient *c) {
 	if (!c)
 		return;
 
+	// The glide threads queue input; stop them first, then let the writer send
+	// whatever is still queued and exit.
+	neru_glide_free(c->glide);
+	neru_scroll_glide_free(c->scroll);
+	if (c->inject) {
+		neru_inject_ring_close(c->inject);
+		pthread_join(c->inject_thread, NULL);
+		neru_inject_ring_free(c->inject);
+	}
+
 	// Stop the dispatch thread.
 	int had_dispatch = c->dispatch_running;
 	c->dispatch_running = 0;
 	// Wake it up by sending a sync request so it exits the poll.
 	pthread_mutex_lock(&c->display_mutex);
-	if (c->display) {
-		struct wl_callback *cb = wl_display_sync(c->display);
-		wl_display_flush(c->display);
-		if (cb)
-			wl_callback_destroy(cb);
-	}
+	struct wl_callback *cb = wl_display_sync(c->display);
+	wl_display_flush(c->display);
+	if (cb)
+		wl_callback_destroy(cb);
 	pthread_mutex_unlock(&c->display_mutex);
 	if (had_dispatch)
 		pthread_join(c->dispatch_thread, NULL);
@@ -435,20 +612,28 @@ void neru_wlr_disconnect(NeruWlrootsClient *c) {
 	if (c->rel_ptr) {
 		zwp_relative_pointer_v1_destroy(c->rel_ptr);
 	}
+	// The overlay may keep the connection open, so the pointer is released
+	// rather than left sending events to a destroyed queue.
+	if (c->pointer) {
+		if (wl_pointer_get_version(c->pointer) >= WL_POINTER_RELEASE_SINCE_VERSION) {
+			wl_pointer_release(c->pointer);
+		} else {
+			wl_pointer_destroy(c->pointer);
+		}
+	}
 	if (c->xkb_keymap) {
 		xkb_keymap_unref(c->xkb_keymap);
 	}
 	if (c->xkb_ctx) {
 		xkb_context_unref(c->xkb_ctx);
 	}
-	for (int i = 0; i < c->nr_screens; i++) {
-		if (c->screens[i].xdg_output) {
-			zxdg_output_v1_destroy(c->screens[i].xdg_output);
-		}
-	}
-	if (c->display) {
-		wl_display_disconnect(c->display);
-	}
+	neru_wlr_unwrap(c->compositor);
+	neru_wlr_unwrap(c->layer_shell);
+	neru_wlr_unwrap(c->seat);
+	neru_wlr_unwrap(c->rel_ptr_mgr);
+	wl_display_flush(c->display);
+	wl_event_queue_destroy(c->queue);
+	neru_wayland_conn_release(c->conn);
 	free(c);
 }
 
@@ -461,6 +646,10 @@ void neru_wlr_init_cursor(NeruWlrootsClient *c) {
 	if (!c || atomic_load(&c->cursor_initialized))
 		return;
 
+	pthread_mutex_lock(&c->display_mutex);
+	neru_wlr_sync_outputs(c);
+	pthread_mutex_unlock(&c->display_mutex);
+
 	// Use Warpd's cursor discovery trick: create invisible full-screen layer-shell surfaces
 	// across all outputs, wiggle the virtual pointer, and capture the pointer_enter event.
 	if (!c->layer_shell || !c->compositor || !c->pointer || !c->vptr || c->nr_screens == 0) {
@@ -486,7 +675,7 @@ void neru_wlr_init_cursor(NeruWlrootsClient *c) {
 	}
 
 	pthread_mutex_lock(&c->display_mutex);
-	wl_display_roundtrip(c->display);
+	wl_display_roundtrip_queue(c->display, c->queue);
 
 	// Wiggle the virtual pointer to force a pointer enter event
 	zwlr_virtual_pointer_v1_motion(c->vptr, 0, wl_fixed_from_int(1), wl_fixed_from_int(1));
@@ -496,7 +685,7 @@ void neru_wlr_init_cursor(NeruWlrootsClient *c) {
 
 	// Process the enter event synchronously (dispatch thread not started yet).
 	pthread_mutex_lock(&c->display_mutex);
-	wl_display_roundtrip(c->display);
+	wl_display_roundtrip_queue(c->display, c->queue);
 	pthread_mutex_unlock(&c->display_mutex);
 
 	// Destroy discovery surfaces
@@ -526,48 +715,48 @@ int neru_wlr_move_absolute(NeruWlrootsClient *c, int x, int y) {
 	if (!c || !c->vptr)
 		return 0;
 
-	// Compute the bounding box of all screens to get the virtual pointer extent.
-	int minx = 0, miny = 0, maxx = 0, maxy = 0;
+	neru_glide_cancel(c->glide);
+	return neru_wlr_queue_absolute(c, x, y);
+}
+
+int neru_wlr_glide_to(NeruWlrootsClient *c, int x, int y, int duration_ms, NeruGlideDoneFn done, uint64_t token) {
+	if (!c || !c->vptr || !c->glide)
+		return 0;
+
+	return neru_glide_start(
+	    c->glide, atomic_load(&c->cursor_x), atomic_load(&c->cursor_y), x, y, duration_ms,
+	    neru_wlr_refresh_mhz(c, x, y), done, token);
+}
+
+int neru_wlr_refresh_mhz(NeruWlrootsClient *c, int x, int y) {
+	if (!c)
+		return 0;
+
+	int fastest = 0;
+	pthread_mutex_lock(&c->display_mutex);
+	neru_wlr_sync_outputs(c);
 	for (int i = 0; i < c->nr_screens; i++) {
 		NeruWaylandScreen *scr = &c->screens[i];
-		if (i == 0 || scr->x < minx)
-			minx = scr->x;
-		if (i == 0 || scr->y < miny)
-			miny = scr->y;
-		int right = scr->x + scr->w;
-		int bottom = scr->y + scr->h;
-		if (i == 0 || right > maxx)
-			maxx = right;
-		if (i == 0 || bottom > maxy)
-			maxy = bottom;
+		if (x >= scr->x && x < scr->x + scr->w && y >= scr->y && y < scr->y + scr->h && scr->refresh_mhz > 0) {
+			pthread_mutex_unlock(&c->display_mutex);
+			return scr->refresh_mhz;
+		}
+		if (scr->refresh_mhz > fastest)
+			fastest = scr->refresh_mhz;
 	}
-
-	pthread_mutex_lock(&c->display_mutex);
-	zwlr_virtual_pointer_v1_motion_absolute(
-	    c->vptr, 0, wl_fixed_from_int(x - minx), wl_fixed_from_int(y - miny), wl_fixed_from_int(maxx - minx),
-	    wl_fixed_from_int(maxy - miny));
-	zwlr_virtual_pointer_v1_frame(c->vptr);
-	wl_display_flush(c->display);
-	c->cursor_x_frac = 0;
-	c->cursor_y_frac = 0;
 	pthread_mutex_unlock(&c->display_mutex);
-
-	atomic_store(&c->cursor_x, x);
-	atomic_store(&c->cursor_y, y);
-	atomic_store(&c->cursor_initialized, 1);
-
-	return 1;
+	return fastest;
 }
 
 int neru_wlr_move_relative(NeruWlrootsClient *c, int dx, int dy) {
 	if (!c || !c->vptr)
 		return 0;
 
-	pthread_mutex_lock(&c->display_mutex);
-	zwlr_virtual_pointer_v1_motion(c->vptr, 0, wl_fixed_from_int(dx), wl_fixed_from_int(dy));
-	zwlr_virtual_pointer_v1_frame(c->vptr);
-	wl_display_flush(c->display);
-	pthread_mutex_unlock(&c->display_mutex);
+	neru_glide_cancel(c->glide);
+
+	NeruInjectCmd cmd = {.kind = NERU_INJECT_MOTION_REL, .a = dx, .b = dy};
+	if (!neru_inject_ring_push(c->inject, &cmd))
+		return 0;
 
 	// Update cache synchronously — relative-motion events from the compositor
 	// never reach us because this client never owns pointer focus (all our
@@ -580,71 +769,38 @@ int neru_wlr_move_relative(NeruWlrootsClient *c, int dx, int dy) {
 	return 1;
 }
 
-// Button codes for linux/input-event-codes.h
-#define NERU_BTN_LEFT 0x110
-#define NERU_BTN_RIGHT 0x111
-#define NERU_BTN_MIDDLE 0x112
-
 int neru_wlr_button(NeruWlrootsClient *c, int button, int pressed) {
 	if (!c || !c->vptr)
 		return 0;
 
-	pthread_mutex_lock(&c->display_mutex);
-	zwlr_virtual_pointer_v1_button(c->vptr, 0, (uint32_t)button, pressed ? 1 : 0);
-	zwlr_virtual_pointer_v1_frame(c->vptr);
-	wl_display_flush(c->display);
-	pthread_mutex_unlock(&c->display_mutex);
-	return 1;
+	NeruInjectCmd cmd = {.kind = NERU_INJECT_BUTTON, .a = button, .b = pressed ? 1 : 0};
+	return neru_wlr_push(c, &cmd);
 }
 
 int neru_wlr_click(NeruWlrootsClient *c, int button) {
 	if (!c || !c->vptr)
 		return 0;
 
-	pthread_mutex_lock(&c->display_mutex);
-	zwlr_virtual_pointer_v1_button(c->vptr, 0, (uint32_t)button, 1);
-	zwlr_virtual_pointer_v1_button(c->vptr, 0, (uint32_t)button, 0);
-	zwlr_virtual_pointer_v1_frame(c->vptr);
-	wl_display_flush(c->display);
-	pthread_mutex_unlock(&c->display_mutex);
-	return 1;
+	// Queued back to back, the writer normally sends both in one frame.
+	NeruInjectCmd press = {.kind = NERU_INJECT_BUTTON, .a = button, .b = 1};
+	NeruInjectCmd release = {.kind = NERU_INJECT_BUTTON, .a = button, .b = 0};
+	return neru_inject_ring_push(c->inject, &press) && neru_wlr_push(c, &release);
 }
 
 int neru_wlr_scroll(NeruWlrootsClient *c, int axis, int delta, int discrete) {
 	if (!c || !c->vptr)
 		return 0;
 
-	pthread_mutex_lock(&c->display_mutex);
-	zwlr_virtual_pointer_v1_axis_source(c->vptr, 0);
-	if (discrete != 0) {
-		zwlr_virtual_pointer_v1_axis_discrete(c->vptr, 0, (uint32_t)axis, wl_fixed_from_int(delta), discrete);
-	} else {
-		zwlr_virtual_pointer_v1_axis(c->vptr, 0, (uint32_t)axis, wl_fixed_from_int(delta));
-	}
-	zwlr_virtual_pointer_v1_frame(c->vptr);
-	wl_display_flush(c->display);
-	pthread_mutex_unlock(&c->display_mutex);
-	return 1;
+	NeruInjectCmd cmd = {.kind = NERU_INJECT_AXIS, .a = axis, .b = delta, .c = discrete};
+	return neru_inject_ring_push(c->inject, &cmd);
 }
 
-int neru_wlr_scroll_batch(NeruWlrootsClient *c, int axis, int *deltas, int *discretes, int count) {
-	if (!c || !c->vptr || !deltas || !discretes || count <= 0)
+int neru_wlr_scroll_by(NeruWlrootsClient *c, int dx120, int dy120, int duration_ms) {
+	if (!c || !c->vptr || !c->scroll)
 		return 0;
 
-	pthread_mutex_lock(&c->display_mutex);
-	for (int i = 0; i < count; i++) {
-		zwlr_virtual_pointer_v1_axis_source(c->vptr, 0);
-		zwlr_virtual_pointer_v1_axis_discrete(c->vptr, 0, (uint32_t)axis, wl_fixed_from_int(deltas[i]), discretes[i]);
-		zwlr_virtual_pointer_v1_frame(c->vptr);
-	}
-	// Ignore flush return value — the events are queued in the client
-	// output buffer and will be flushed by the dispatch loop.  Returning 0
-	// on EAGAIN (transient buffer-full) is worse than ignoring it:
-	// it would cause the entire batch to be reported as failed even though
-	// delivery is guaranteed.
-	wl_display_flush(c->display);
-	pthread_mutex_unlock(&c->display_mutex);
-	return 1;
+	int refresh_mhz = neru_wlr_refresh_mhz(c, atomic_load(&c->cursor_x), atomic_load(&c->cursor_y));
+	return neru_scroll_glide_by(c->scroll, dx120, dy120, duration_ms, refresh_mhz);
 }
 
 static uint32_t neru_wlr_modifier_mask(NeruWlrootsClient *c, const char *modifier) {
@@ -667,18 +823,10 @@ int neru_wlr_modifier_event(NeruWlrootsClient *c, const char *modifier, int is_d
 	if (mask == 0)
 		return 0;
 
-	if (is_down) {
-		c->depressed_mods |= mask;
-	} else {
-		c->depressed_mods &= ~mask;
-	}
-
-	pthread_mutex_lock(&c->display_mutex);
-	zwp_virtual_keyboard_v1_modifiers(c->vkeyboard, c->depressed_mods, 0, 0, 0);
-	wl_display_flush(c->display);
-	pthread_mutex_unlock(&c->display_mutex);
-
-	return 1;
+	// The writer owns depressed_mods, so concurrent modifier events apply in
+	// queue order instead of racing on the mask.
+	NeruInjectCmd cmd = {.kind = NERU_INJECT_MODIFIER, .a = (int)mask, .b = is_down ? 1 : 0};
+	return neru_wlr_push(c, &cmd);
 }
 
 int neru_wlr_get_cursor(NeruWlrootsClient *c, int *x, int *y) {
@@ -703,12 +851,22 @@ void neru_wlr_set_cursor(NeruWlrootsClient *c, int x, int y) {
 int neru_wlr_screen_count(NeruWlrootsClient *c) {
 	if (!c)
 		return 0;
-	return c->nr_screens;
+	pthread_mutex_lock(&c->display_mutex);
+	neru_wlr_sync_outputs(c);
+	int n = c->nr_screens;
+	pthread_mutex_unlock(&c->display_mutex);
+	return n;
 }
 
 int neru_wlr_screen_info(NeruWlrootsClient *c, int idx, int *x, int *y, int *w, int *h, char *name_out, int name_len) {
-	if (!c || idx < 0 || idx >= c->nr_screens)
+	if (!c)
+		return 0;
+	pthread_mutex_lock(&c->display_mutex);
+	neru_wlr_sync_outputs(c);
+	if (idx < 0 || idx >= c->nr_screens) {
+		pthread_mutex_unlock(&c->display_mutex);
 		return 0;
+	}
 	NeruWaylandScreen *scr = &c->screens[idx];
 	*x = scr->x;
 	*y = scr->y;
@@ -716,6 +874,7 @@ int neru_wlr_screen_info(NeruWlrootsClient *c, int idx, int *x, int *y, int *w,
 	*h = scr->h;
 	strncpy(name_out, scr->name, (size_t)(name_len - 1));
 	name_out[name_len - 1] = '\0';
+	pthread_mutex_unlock(&c->display_mutex);
 	return 1;
 }
 
@@ -731,9 +890,17 @@ int neru_wlr_key(NeruWlrootsClient *c, uint32_t keycode, int pressed) {
 	clock_gettime(CLOCK_MONOTONIC, &ts);
 	uint32_t time = (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
 
-	pthread_mutex_lock(&c->display_mutex);
-	zwp_virtual_keyboard_v1_key(c->vkeyboard, time, keycode, pressed ? 1 : 0);
-	wl_display_flush(c->display);
-	pthread_mutex_unlock(&c->display_mutex);
+	NeruInjectCmd cmd = {.kind = NERU_INJECT_KEY, .a = (int)keycode, .b = pressed ? 1 : 0, .time = time};
+	return neru_wlr_push(c, &cmd);
+}
+
+int neru_wlr_inject_stats(NeruWlrootsClient *c, NeruWlrInjectStats *out) {
+	if (!c || !c->inject)
+		return 0;
+
+	neru_inject_ring_stats(c->inject, &out->ring);
+	out->batches = atomic_load(&c->inject_batches);
+	out->coalesced = atomic_load(&c->inject_coalesced);
+	out->frames = atomic_load(&c->inject_frames);
 	return 1;
 }
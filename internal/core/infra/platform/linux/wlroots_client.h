@@ -2,6 +2,10 @@
 #define WLROOTS_CLIENT_H
 
 #include "common_defs.h"
+#include "inject_ring.h"
+#include "pointer_glide.h"
+#include "scroll_glide.h"
+#include "wayland_conn.h"
 
 #include <pthread.h>
 #include <stdatomic.h>
@@ -14,19 +18,21 @@ typedef struct {
 	int y;
 	int w;
 	int h;
-	int state;
+	int refresh_mhz;  // current mode, 0 until wl_output.mode reports it
 	char name[128];
 	char name_valid;
 	struct wl_output *wl_output;
-	struct zxdg_output_v1 *xdg_output;
 	struct wl_surface *discovery_surface;
 } NeruWaylandScreen;
 
 typedef struct NeruWlrootsClient {
+	// Shared with the overlay; see wayland_conn.h. The pointer, relative
+	// pointer and discovery surfaces live on queue, created through the
+	// wrapped globals below.
+	NeruWaylandConn *conn;
 	struct wl_display *display;
-	struct wl_registry *registry;
+	struct wl_event_queue *queue;
 	struct wl_compositor *compositor;
-	struct wl_shm *shm;
 	struct zwlr_layer_shell_v1 *layer_shell;
 	struct wl_seat *seat;
 	struct wl_pointer *pointer;
@@ -34,12 +40,9 @@ typedef struct NeruWlrootsClient {
 	struct zwp_relative_pointer_manager_v1 *rel_ptr_mgr;
 	struct zwp_relative_pointer_v1 *rel_ptr;
 
-	struct zwlr_virtual_pointer_manager_v1 *vptr_mgr;
 	struct zwlr_virtual_pointer_v1 *vptr;
-	struct zwp_virtual_keyboard_manager_v1 *vkeyboard_mgr;
 	struct zwp_virtual_keyboard_v1 *vkeyboard;
 	int vkeyboard_ready;
-	struct zxdg_output_manager_v1 *xdg_output_mgr;
 
 	struct xkb_context *xkb_ctx;
 	struct xkb_keymap *xkb_keymap;
@@ -47,10 +50,32 @@ typedef struct NeruWlrootsClient {
 	uint32_t mod_ctrl;
 	uint32_t mod_alt;
 	uint32_t mod_logo;
-	uint32_t depressed_mods;
+	uint32_t depressed_mods;  // inject_thread only
 
+	// Copied from the shared connection's output table whenever its
+	// generation moves on. Guarded by display_mutex.
 	NeruWaylandScreen screens[NERU_MAX_OUTPUTS];
 	int nr_screens;
+	uint64_t outputs_generation;
+
+	// Bounding box of all screens, the extent motion_absolute is relative to.
+	// Guarded by display_mutex; output changes clear extent_valid.
+	int extent_valid;
+	int extent_x, extent_y, extent_w, extent_h;
+
+	// Drive neru_wlr_glide_to and neru_wlr_scroll_by; created with the client.
+	NeruPointerGlide *glide;
+	NeruScrollGlide *scroll;
+
+	// Injectors queue commands here instead of sending them. inject_thread is
+	// the only sender of virtual pointer/keyboard requests: it coalesces each
+	// batch and flushes it once. Created with the client when either virtual
+	// device exists.
+	NeruInjectRing *inject;
+	pthread_t inject_thread;
+	_Atomic uint64_t inject_batches;
+	_Atomic uint64_t inject_coalesced;
+	_Atomic uint64_t inject_frames;
 
 	atomic_int cursor_x;
 	atomic_int cursor_y;
@@ -65,16 +90,35 @@ typedef struct NeruWlrootsClient {
 	int connected;
 } NeruWlrootsClient;
 
+typedef struct {
+	NeruInjectRingStats ring;
+	uint64_t batches;    // flushes, one per batch the writer took
+	uint64_t coalesced;  // motions merged into a later one in the same batch
+	uint64_t frames;     // virtual pointer frames sent
+} NeruWlrInjectStats;
+
 NeruWlrootsClient *neru_wlr_connect(void);
 void neru_wlr_disconnect(NeruWlrootsClient *c);
 int neru_wlr_start_dispatch(NeruWlrootsClient *c);
 void neru_wlr_init_cursor(NeruWlrootsClient *c);
 int neru_wlr_move_absolute(NeruWlrootsClient *c, int x, int y);
+// Glides the virtual pointer from the cached cursor position to (x, y) over
+// duration_ms, paced to the refresh rate of the output under the target. done
+// is called with token once the glide ends. A move, relative move or another
+// glide cancels it. Returns 1 when the glide was started.
+int neru_wlr_glide_to(NeruWlrootsClient *c, int x, int y, int duration_ms, NeruGlideDoneFn done, uint64_t token);
+// Refresh rate in mHz of the output containing (x, y), or of the fastest
+// output when none does; 0 when no output reported a mode.
+int neru_wlr_refresh_mhz(NeruWlrootsClient *c, int x, int y);
 int neru_wlr_move_relative(NeruWlrootsClient *c, int dx, int dy);
 int neru_wlr_button(NeruWlrootsClient *c, int button, int pressed);
 int neru_wlr_click(NeruWlrootsClient *c, int button);
 int neru_wlr_scroll(NeruWlrootsClient *c, int axis, int delta, int discrete);
-int neru_wlr_scroll_batch(NeruWlrootsClient *c, int axis, int *deltas, int *discretes, int count);
+// Scrolls by (dx120, dy120) value120 units (positive down/right) over
+// duration_ms, paced to the refresh rate of the output under the cursor. Steps
+// are sent as continuous-source axis events with sub-pixel deltas, since the
+// virtual pointer protocol has no value120 request. See neru_scroll_glide_by.
+int neru_wlr_scroll_by(NeruWlrootsClient *c, int dx120, int dy120, int duration_ms);
 int neru_wlr_modifier_event(NeruWlrootsClient *c, const char *modifier, int is_down);
 int neru_wlr_get_cursor(NeruWlrootsClient *c, int *x, int *y);
 void neru_wlr_set_cursor(NeruWlrootsClient *c, int x, int y);
@@ -83,5 +127,7 @@ int neru_wlr_screen_info(NeruWlrootsClient *c, int idx, int *x, int *y, int *w,
 int neru_wlr_has_virtual_pointer(NeruWlrootsClient *c);
 int neru_wlr_has_virtual_keyboard(NeruWlrootsClient *c);
 int neru_wlr_key(NeruWlrootsClient *c, uint32_t keycode, int pressed);
+// Returns 0 when the client has no injection queue.
+int neru_wlr_inject_stats(NeruWlrootsClient *c, NeruWlrInjectStats *out);
 
 #endif /* WLROOTS_CLIENT_H */
@@ -3,7 +3,6 @@
 #include <X11/Xatom.h>
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
-#include <X11/extensions/XTest.h>
 #include <X11/keysym.h>
 #include <stdlib.h>
 #include <string.h>
@@ -107,30 +106,12 @@ char *neru_ax_window_class(Display *display, Window window) {
 	return class_name;
 }
 
-int neru_ax_move_pointer(Display *display, int x, int y) {
-	int ok = XTestFakeMotionEvent(display, -1, x, y, CurrentTime);
-	XFlush(display);
-	return ok;
+int neru_ax_move_pointer(int x, int y) {
+	NeruX11InjectEvent event = {.type = NERU_X11_INJECT_MOTION, .x = x, .y = y};
+	return neru_x11_inject(&event, 1) == 1;
 }
 
-int neru_ax_button(Display *display, unsigned int button, int pressed) {
-	int ok = XTestFakeButtonEvent(display, button, pressed ? True : False, CurrentTime);
-	XFlush(display);
-	return ok;
-}
-
-void neru_ax_press_modifier(Display *display, KeySym keysym) {
-	KeyCode keycode = XKeysymToKeycode(display, keysym);
-	if (keycode != 0) {
-		XTestFakeKeyEvent(display, keycode, True, CurrentTime);
-		XFlush(display);
-	}
-}
-
-void neru_ax_release_modifier(Display *display, KeySym keysym) {
-	KeyCode keycode = XKeysymToKeycode(display, keysym);
-	if (keycode != 0) {
-		XTestFakeKeyEvent(display, keycode, False, CurrentTime);
-		XFlush(display);
-	}
+int neru_ax_button(unsigned int button, int pressed) {
+	NeruX11InjectEvent event = {.type = NERU_X11_INJECT_BUTTON, .pressed = pressed, .detail = button};
+	return neru_x11_inject(&event, 1) == 1;
 }
@@ -1,6 +1,8 @@
 #ifndef X11_ACCESSIBILITY_H
 #define X11_ACCESSIBILITY_H
 
+#include "x11_inject.h"
+
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/keysym.h>
@@ -11,9 +13,9 @@ int neru_ax_query_pointer(Display *display, int *x, int *y);
 int neru_ax_get_active_window(Display *display, Window *out);
 unsigned long neru_ax_window_pid(Display *display, Window window, int *ok);
 char *neru_ax_window_class(Display *display, Window window);
-int neru_ax_move_pointer(Display *display, int x, int y);
-int neru_ax_button(Display *display, unsigned int button, int pressed);
-void neru_ax_press_modifier(Display *display, KeySym keysym);
-void neru_ax_release_modifier(Display *display, KeySym keysym);
+// Single synthetic events on the shared XTest injection connection; batch
+// through neru_x11_inject when sending several together.
+int neru_ax_move_pointer(int x, int y);
+int neru_ax_button(unsigned int button, int pressed);
 
 #endif /* X11_ACCESSIBILITY_H */
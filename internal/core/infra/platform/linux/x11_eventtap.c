@@ -1,10 +1,9 @@
 #include "x11_eventtap.h"
+#include "x11_inject.h"
 
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
-#include <X11/extensions/XTest.h>
 #include <X11/keysym.h>
-#include <stdlib.h>
 #include <string.h>
 
 Display *neru_eventtap_open(void) { return XOpenDisplay(NULL); }
@@ -48,28 +47,12 @@ static KeySym neru_eventtap_modifier_keysym(const char *modifier) {
 }
 
 int neru_eventtap_post_modifier(const char *modifier, int is_down) {
-	// Open a fresh Display connection per call to ensure thread-safety isolation
-	// from the grab Display used by runX11(). XLib is not thread-safe without
-	// XInitThreads, so we avoid sharing the grab connection for XTest injection.
-	Display *display = neru_eventtap_open();
-	if (display == NULL)
-		return 0;
-
+	// Injected on the shared XTest connection, never on the grab Display used
+	// by runX11().
 	KeySym keysym = neru_eventtap_modifier_keysym(modifier);
-	if (keysym == NoSymbol) {
-		neru_eventtap_close(display);
-		return 0;
-	}
-
-	KeyCode keycode = XKeysymToKeycode(display, keysym);
-	if (keycode == 0) {
-		neru_eventtap_close(display);
+	if (keysym == NoSymbol)
 		return 0;
-	}
-
-	int ok = XTestFakeKeyEvent(display, keycode, is_down ? True : False, CurrentTime);
-	XFlush(display);
-	neru_eventtap_close(display);
 
-	return ok;
+	NeruX11InjectEvent event = {.type = NERU_X11_INJECT_KEY, .pressed = is_down, .detail = keysym};
+	return neru_x11_inject(&event, 1) == 1;
 }
@@ -1,6 +1,9 @@
 #ifndef X11_EVENTTAP_H
 #define X11_EVENTTAP_H
 
+#include "x11_keymap.h"
+#include "x11_wait.h"
+
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/keysym.h>
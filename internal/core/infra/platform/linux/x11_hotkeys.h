@@ -1,6 +1,9 @@
 #ifndef X11_HOTKEYS_H
 #define X11_HOTKEYS_H
 
+#include "x11_keymap.h"
+#include "x11_wait.h"
+
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 
@@ -0,0 +1,82 @@
+#include "x11_inject.h"
+#include "x11_system.h"
+
+#include <X11/Xlib.h>
+#include <X11/extensions/XTest.h>
+#include <pthread.h>
+
+// One XTest connection shared by every synthetic key, button and motion
+// event, kept apart from the eventtap grab connection. It is opened on first
+// use and reopened after the server goes away; the mutex keeps each batch
+// contiguous on the wire.
+static Display *inject_display;
+static pthread_mutex_t inject_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static Display *neru_x11_inject_display_locked(void) {
+	// Closing a dead connection would trip Xlib's fatal I/O error handler;
+	// abandon it instead.
+	if (inject_display != NULL && !neru_x11_connection_alive(inject_display))
+		inject_display = NULL;
+
+	if (inject_display == NULL)
+		inject_display = XOpenDisplay(NULL);
+
+	return inject_display;
+}
+
+static int neru_x11_inject_one(Display *display, const NeruX11InjectEvent *event) {
+	Bool pressed = event->pressed ? True : False;
+
+	switch (event->type) {
+	case NERU_X11_INJECT_KEY: {
+		KeyCode keycode = XKeysymToKeycode(display, (KeySym)event->detail);
+		if (keycode == 0)
+			return 0;
+		return XTestFakeKeyEvent(display, keycode, pressed, CurrentTime);
+	}
+	case NERU_X11_INJECT_BUTTON:
+		return XTestFakeButtonEvent(display, (unsigned int)event->detail, pressed, CurrentTime);
+	case NERU_X11_INJECT_MOTION:
+		return XTestFakeMotionEvent(display, -1, event->x, event->y, CurrentTime);
+	default:
+		return 0;
+	}
+}
+
+int neru_x11_inject(const NeruX11InjectEvent *events, int count) {
+	pthread_mutex_lock(&inject_lock);
+
+	Display *display = neru_x11_inject_display_locked();
+	if (display == NULL) {
+		pthread_mutex_unlock(&inject_lock);
+		return -1;
+	}
+
+	int ok = 1;
+	for (int i = 0; i < count; i++) {
+		if (!neru_x11_inject_one(display, &events[i]))
+			ok = 0;
+	}
+	XFlush(display);
+
+	pthread_mutex_unlock(&inject_lock);
+	return ok;
+}
+
+int neru_x11_inject_query_pointer(int *x, int *y) {
+	pthread_mutex_lock(&inject_lock);
+
+	int ok = 0;
+	Display *display = neru_x11_inject_display_locked();
+	if (display != NULL) {
+		Window root_return, child_return;
+		int win_x, win_y;
+		unsigned int mask_return;
+
+		ok = XQueryPointer(
+		    display, DefaultRootWindow(display), &root_return, &child_return, x, y, &win_x, &win_y, &mask_return);
+	}
+
+	pthread_mutex_unlock(&inject_lock);
+	return ok;
+}
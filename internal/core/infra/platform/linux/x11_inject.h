@@ -0,0 +1,26 @@
+#ifndef X11_INJECT_H
+#define X11_INJECT_H
+
+#include <X11/Xlib.h>
+
+enum {
+	NERU_X11_INJECT_KEY = 0,     // detail is a KeySym
+	NERU_X11_INJECT_BUTTON = 1,  // detail is a pointer button number
+	NERU_X11_INJECT_MOTION = 2,  // absolute move to (x, y) on the root window
+};
+
+typedef struct {
+	int type;  // NERU_X11_INJECT_*
+	int pressed;
+	unsigned long detail;
+	int x;
+	int y;
+} NeruX11InjectEvent;
+
+// Sends events in order over the shared XTest injection connection with a
+// single flush. Returns 1 when every event was accepted, 0 when any was
+// rejected and -1 when the connection could not be opened.
+int neru_x11_inject(const NeruX11InjectEvent *events, int count);
+int neru_x11_inject_query_pointer(int *x, int *y);
+
+#endif /* X11_INJECT_H */
@@ -0,0 +1,192 @@
+#include "x11_keymap.h"
+
+#include <X11/XKBlib.h>
+#include <X11/Xlib.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NERU_X11_KEYMAP_MAX_GROUPS 4
+// Caps the table at 64 states per keycode and group, 64k entries for a full
+// 8-255 keycode range in four groups.
+#define NERU_X11_KEYMAP_MAX_LEVEL_BITS 6
+
+// Bit i of a level is the i-th lowest modifier in mask.
+static unsigned int neru_x11_keymap_mods(unsigned int mask, int level) {
+	unsigned int mods = 0;
+	for (int bit = 0; mask != 0; mask &= mask - 1, bit++) {
+		if (level & (1 << bit))
+			mods |= mask & -mask;
+	}
+	return mods;
+}
+
+static int neru_x11_keymap_level(unsigned int mask, unsigned int state) {
+	int level = 0;
+	for (int bit = 0; mask != 0; mask &= mask - 1, bit++) {
+		if (state & mask & -mask)
+			level |= 1 << bit;
+	}
+	return level;
+}
+
+// The real modifiers behind every key type's level selection; the server
+// already resolved virtual modifiers such as NumLock and LevelThree into
+// mods.mask. Each modifier doubles the table, so past
+// NERU_X11_KEYMAP_MAX_LEVEL_BITS only the ones the most key types select
+// with are kept; the rest are ignored when translating.
+static unsigned int neru_x11_keymap_level_mask(XkbDescPtr xkb) {
+	unsigned int base = ShiftMask | LockMask | ControlMask;
+	int uses[8] = {0};
+	for (int i = 0; i < xkb->map->num_types; i++) {
+		unsigned int mods = xkb->map->types[i].mods.mask & 0xFF & ~base;
+		for (int bit = 0; bit < 8; bit++)
+			uses[bit] += (mods >> bit) & 1;
+	}
+
+	unsigned int mask = base;
+	for (int n = __builtin_popcount(base); n < NERU_X11_KEYMAP_MAX_LEVEL_BITS; n++) {
+		int best = -1;
+		for (int bit = 0; bit < 8; bit++) {
+			if (uses[bit] > 0 && (best < 0 || uses[bit] > uses[best]))
+				best = bit;
+		}
+		if (best < 0)
+			break;
+		mask |= 1u << best;
+		uses[best] = 0;
+	}
+	return mask;
+}
+
+static void neru_x11_keymap_translate(
+    Display *display, XkbDescPtr xkb, KeyCode keycode, unsigned int state, NeruX11KeyInfo *out) {
+	KeySym keysym = NoSymbol;
+	unsigned int consumed = 0;
+
+	memset(out, 0, sizeof(*out));
+	if (!XkbTranslateKeyCode(xkb, keycode, state, &consumed, &keysym) || keysym == NoSymbol)
+		return;
+
+	// Same steps as XLookupString under XKB: the keysym from the key type
+	// level, then text from the modifiers the level did not consume.
+	int extra = 0;
+	int len = XkbTranslateKeySym(display, &keysym, state & ~consumed, out->text, NERU_X11_KEYMAP_TEXT_MAX, &extra);
+	out->keysym = keysym;
+	out->text_len = len > 0 && len <= NERU_X11_KEYMAP_TEXT_MAX ? len : 0;
+}
+
+int neru_x11_keymap_rebuild(NeruX11Keymap *keymap, Display *display) {
+	XkbDescPtr xkb = XkbGetMap(display, XkbKeyTypesMask | XkbKeySymsMask, XkbUseCoreKbd);
+	if (xkb == NULL)
+		return 0;
+
+	int min_keycode = xkb->min_key_code;
+	int max_keycode = xkb->max_key_code;
+	int num_groups = 1;
+	for (int keycode = min_keycode; keycode <= max_keycode; keycode++) {
+		int groups = XkbKeyNumGroups(xkb, keycode);
+		if (groups > num_groups)
+			num_groups = groups;
+	}
+	if (num_groups > NERU_X11_KEYMAP_MAX_GROUPS)
+		num_groups = NERU_X11_KEYMAP_MAX_GROUPS;
+
+	unsigned int level_mask = neru_x11_keymap_level_mask(xkb);
+	int num_states = 1 << __builtin_popcount(level_mask);
+	size_t nkeys = (size_t)(max_keycode - min_keycode + 1) * (size_t)num_groups * (size_t)num_states;
+	NeruX11KeyInfo *keys = calloc(nkeys, sizeof(*keys));
+	if (keys == NULL) {
+		XkbFreeKeyboard(xkb, 0, True);
+		return 0;
+	}
+
+	size_t i = 0;
+	for (int keycode = min_keycode; keycode <= max_keycode; keycode++) {
+		for (int group = 0; group < num_groups; group++) {
+			for (int level = 0; level < num_states; level++) {
+				unsigned int state = XkbBuildCoreState(neru_x11_keymap_mods(level_mask, level), group);
+				neru_x11_keymap_translate(display, xkb, (KeyCode)keycode, state, &keys[i++]);
+			}
+		}
+	}
+	XkbFreeKeyboard(xkb, 0, True);
+
+	free(keymap->keys);
+	keymap->keys = keys;
+	keymap->nkeys = nkeys;
+	keymap->min_keycode = min_keycode;
+	keymap->max_keycode = max_keycode;
+	keymap->num_groups = num_groups;
+	keymap->level_mask = level_mask;
+	keymap->num_states = num_states;
+	return 1;
+}
+
+NeruX11Keymap *neru_x11_keymap_new(Display *display) {
+	int opcode, event_base, error_base;
+	int major = XkbMajorVersion, minor = XkbMinorVersion;
+	if (!XkbQueryExtension(display, &opcode, &event_base, &error_base, &major, &minor))
+		return NULL;
+
+	NeruX11Keymap *keymap = calloc(1, sizeof(*keymap));
+	if (keymap == NULL)
+		return NULL;
+	keymap->xkb_event_base = event_base;
+
+	if (!neru_x11_keymap_rebuild(keymap, display)) {
+		free(keymap);
+		return NULL;
+	}
+
+	unsigned int mask = XkbNewKeyboardNotifyMask | XkbMapNotifyMask;
+	XkbSelectEvents(display, XkbUseCoreKbd, mask, mask);
+	return keymap;
+}
+
+void neru_x11_keymap_free(NeruX11Keymap *keymap) {
+	if (keymap == NULL)
+		return;
+	free(keymap->keys);
+	free(keymap);
+}
+
+int neru_x11_keymap_index(const NeruX11Keymap *keymap, unsigned int keycode, unsigned int state) {
+	if ((int)keycode < keymap->min_keycode || (int)keycode > keymap->max_keycode)
+		return -1;
+
+	// XKB wraps out-of-range groups back into the keymap's groups.
+	int group = (int)XkbGroupForCoreState(state) % keymap->num_groups;
+	return (((int)keycode - keymap->min_keycode) * keymap->num_groups + group) * keymap->num_states +
+	       neru_x11_keymap_level(keymap->level_mask, state);
+}
+
+int neru_x11_keymap_changed(const NeruX11Keymap *keymap, XEvent *ev) {
+	if (ev->type == MappingNotify) {
+		if (ev->xmapping.request == MappingPointer)
+			return 0;
+		XRefreshKeyboardMapping(&ev->xmapping);
+		return 1;
+	}
+
+	if (ev->type != keymap->xkb_event_base)
+		return 0;
+
+	int xkb_type = ((XkbAnyEvent *)ev)->xkb_type;
+	return xkb_type == XkbNewKeyboardNotify || xkb_type == XkbMapNotify;
+}
+
+KeyCode neru_x11_keymap_keycode(const NeruX11Keymap *keymap, KeySym keysym) {
+	size_t stride = (size_t)keymap->num_groups * (size_t)keymap->num_states;
+
+	// Prefer a key that produces keysym unmodified, then any level of group 1.
+	for (int levels = 1; levels <= keymap->num_states; levels *= keymap->num_states) {
+		for (int keycode = keymap->min_keycode; keycode <= keymap->max_keycode; keycode++) {
+			const NeruX11KeyInfo *info = &keymap->keys[(size_t)(keycode - keymap->min_keycode) * stride];
+			for (int level = 0; level < levels; level++) {
+				if (info[level].keysym == keysym)
+					return (KeyCode)keycode;
+			}
+		}
+	}
+	return 0;
+}
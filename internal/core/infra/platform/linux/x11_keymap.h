@@ -0,0 +1,48 @@
+#ifndef X11_KEYMAP_H
+#define X11_KEYMAP_H
+
+#include <X11/XKBlib.h>
+#include <X11/Xlib.h>
+#include <stddef.h>
+
+#define NERU_X11_KEYMAP_TEXT_MAX 8
+
+typedef struct {
+	KeySym keysym;
+	int text_len;
+	char text[NERU_X11_KEYMAP_TEXT_MAX];
+} NeruX11KeyInfo;
+
+// What XLookupString would return for every (keycode, state) pair, built
+// from the XKB map so a key event resolves with one index computation.
+typedef struct {
+	int min_keycode;
+	int max_keycode;
+	int num_groups;
+	// Modifiers that can change the keysym or text of a key: those any key
+	// type selects levels with (Num Lock and level 3 land on whichever ModN
+	// the server maps them to), plus Shift, Lock and Control, which also
+	// affect the text. Every combination of them is precomputed per keycode
+	// and group; at most six are kept, so the table stays bounded.
+	unsigned int level_mask;
+	int num_states;
+	int xkb_event_base;
+	NeruX11KeyInfo *keys;
+	size_t nkeys;
+} NeruX11Keymap;
+
+// Builds the table for the core keyboard and selects the XKB events that
+// announce keymap changes. Returns NULL when the server lacks XKB.
+NeruX11Keymap *neru_x11_keymap_new(Display *display);
+void neru_x11_keymap_free(NeruX11Keymap *keymap);
+int neru_x11_keymap_rebuild(NeruX11Keymap *keymap, Display *display);
+// Index into keymap->keys for a key event, or -1 when keycode is out of range.
+int neru_x11_keymap_index(const NeruX11Keymap *keymap, unsigned int keycode, unsigned int state);
+// Returns 1 when ev announces a keyboard mapping change; the table must then
+// be rebuilt before translating further key events.
+int neru_x11_keymap_changed(const NeruX11Keymap *keymap, XEvent *ev);
+// Keycode producing keysym in group 1, preferring one that needs no
+// modifiers; 0 when no key does.
+KeyCode neru_x11_keymap_keycode(const NeruX11Keymap *keymap, KeySym keysym);
+
+#endif /* X11_KEYMAP_H */
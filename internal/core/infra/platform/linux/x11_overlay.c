@@ -4,10 +4,15 @@
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/extensions/Xfixes.h>
+#include <X11/extensions/XShm.h>
+#include <X11/extensions/Xrandr.h>
 #include <X11/extensions/shape.h>
-#include <cairo/cairo-xlib.h>
 #include <cairo/cairo.h>
+#include <math.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
 
 static Visual *neru_x11_argb_visual(Display *display, int screen) {
 	XVisualInfo vinfo;
@@ -17,24 +22,122 @@ static Visual *neru_x11_argb_visual(Display *display, int screen) {
 	return DefaultVisual(display, screen);
 }
 
-NeruX11Overlay *neru_x11_overlay_new(void) {
-	Display *display = XOpenDisplay(NULL);
-	if (display == NULL) {
-		return NULL;
+static int neru_x11_box_empty(const NeruX11Box *box) { return box->x1 <= box->x0 || box->y1 <= box->y0; }
+
+// Grows box to cover [x0, x1) x [y0, y1), clipped to the output.
+static void neru_x11_box_add(const NeruX11OverlayOutput *out, NeruX11Box *box, int x0, int y0, int x1, int y1) {
+	if (x0 < 0)
+		x0 = 0;
+	if (y0 < 0)
+		y0 = 0;
+	if (x1 > out->width)
+		x1 = out->width;
+	if (y1 > out->height)
+		y1 = out->height;
+	if (x1 <= x0 || y1 <= y0)
+		return;
+
+	if (neru_x11_box_empty(box)) {
+		*box = (NeruX11Box){x0, y0, x1, y1};
+		return;
 	}
+	if (x0 < box->x0)
+		box->x0 = x0;
+	if (y0 < box->y0)
+		box->y0 = y0;
+	if (x1 > box->x1)
+		box->x1 = x1;
+	if (y1 > box->y1)
+		box->y1 = y1;
+}
 
-	NeruX11Overlay *overlay = calloc(1, sizeof(NeruX11Overlay));
-	if (!overlay) {
-		XCloseDisplay(display);
-		return NULL;
+static int neru_x11_shm_failed;
+
+static int neru_x11_shm_error_handler(Display *display, XErrorEvent *ev) {
+	(void)display;
+	(void)ev;
+	neru_x11_shm_failed = 1;
+	return 0;
+}
+
+// Backs out->image with a shared memory segment the server reads directly.
+// Fails on remote displays, which advertise MIT-SHM but cannot attach a
+// local segment; the attach error is trapped instead of reaching the default
+// handler, which would exit.
+static int neru_x11_output_attach_shm(NeruX11Overlay *overlay, NeruX11OverlayOutput *out) {
+	Display *display = overlay->display;
+
+	out->image = XShmCreateImage(
+	    display, overlay->visual, 32, ZPixmap, NULL, &out->shm, (unsigned int)out->width, (unsigned int)out->height);
+	if (out->image == NULL)
+		return 0;
+
+	out->shm.shmid = shmget(IPC_PRIVATE, (size_t)out->image->bytes_per_line * out->height, IPC_CREAT | 0600);
+	if (out->shm.shmid < 0)
+		goto fail_image;
+
+	out->shm.shmaddr = shmat(out->shm.shmid, NULL, 0);
+	if (out->shm.shmaddr == (char *)-1) {
+		shmctl(out->shm.shmid, IPC_RMID, NULL);
+		goto fail_image;
 	}
-	overlay->display = display;
-	overlay->screen = DefaultScreen(display);
-	overlay->root = RootWindow(display, overlay->screen);
-	overlay->visual = neru_x11_argb_visual(display, overlay->screen);
-	overlay->width = DisplayWidth(display, overlay->screen);
-	overlay->height = DisplayHeight(display, overlay->screen);
-	overlay->colormap = XCreateColormap(display, overlay->root, overlay->visual, AllocNone);
+	out->shm.readOnly = True;
+
+	XSync(display, False);
+	neru_x11_shm_failed = 0;
+	XErrorHandler previous = XSetErrorHandler(neru_x11_shm_error_handler);
+	Status attached = XShmAttach(display, &out->shm);
+	XSync(display, False);
+	XSetErrorHandler(previous);
+
+	// Removed now so the segment is released with the last detach, even if
+	// the process dies without cleaning up.
+	shmctl(out->shm.shmid, IPC_RMID, NULL);
+	if (!attached || neru_x11_shm_failed) {
+		shmdt(out->shm.shmaddr);
+		goto fail_image;
+	}
+
+	out->image->data = out->shm.shmaddr;
+	out->use_shm = 1;
+	return 1;
+
+fail_image:
+	XDestroyImage(out->image);
+	out->image = NULL;
+	memset(&out->shm, 0, sizeof(out->shm));
+	return 0;
+}
+
+// Plain client memory, uploaded over the socket with XPutImage.
+static int neru_x11_output_alloc_image(NeruX11Overlay *overlay, NeruX11OverlayOutput *out) {
+	int stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, out->width);
+	char *data = calloc((size_t)out->height, (size_t)stride);
+	if (data == NULL)
+		return 0;
+
+	out->image = XCreateImage(
+	    overlay->display, overlay->visual, 32, ZPixmap, 0, data, (unsigned int)out->width, (unsigned int)out->height,
+	    32, stride);
+	if (out->image == NULL) {
+		free(data);
+		return 0;
+	}
+
+	// cairo writes host-endian pixels; Xlib swaps them for the server.
+	const unsigned int one = 1;
+	out->image->byte_order = *(const unsigned char *)&one ? LSBFirst : MSBFirst;
+	return 1;
+}
+
+static int neru_x11_output_create(NeruX11Overlay *overlay, NeruX11OverlayOutput *out, int x, int y, int w, int h) {
+	Display *display = overlay->display;
+
+	memset(out, 0, sizeof(*out));
+	out->x = x;
+	out->y = y;
+	out->width = w;
+	out->height = h;
 
 	XSetWindowAttributes attrs;
 	attrs.override_redirect = True;
@@ -43,25 +146,154 @@ NeruX11Overlay *neru_x11_overlay_new(void) {
 	attrs.border_pixel = 0;
 	attrs.event_mask = ExposureMask;
 
-	overlay->window = XCreateWindow(
-	    display, overlay->root, 0, 0, overlay->width, overlay->height, 0, 32, InputOutput, overlay->visual,
+	out->window = XCreateWindow(
+	    display, overlay->root, x, y, (unsigned int)w, (unsigned int)h, 0, 32, InputOutput, overlay->visual,
 	    CWOverrideRedirect | CWColormap | CWBackPixel | CWBorderPixel | CWEventMask, &attrs);
+	if (out->window == 0)
+		return 0;
 
 	Atom dock = XInternAtom(display, "_NET_WM_WINDOW_TYPE_DOCK", False);
 	Atom window_type = XInternAtom(display, "_NET_WM_WINDOW_TYPE", False);
-	XChangeProperty(display, overlay->window, window_type, XA_ATOM, 32, PropModeReplace, (unsigned char *)&dock, 1);
+	XChangeProperty(display, out->window, window_type, XA_ATOM, 32, PropModeReplace, (unsigned char *)&dock, 1);
 
 	Atom state = XInternAtom(display, "_NET_WM_STATE", False);
 	Atom above = XInternAtom(display, "_NET_WM_STATE_ABOVE", False);
-	XChangeProperty(display, overlay->window, state, XA_ATOM, 32, PropModeReplace, (unsigned char *)&above, 1);
+	XChangeProperty(display, out->window, state, XA_ATOM, 32, PropModeReplace, (unsigned char *)&above, 1);
 
 	XserverRegion region = XFixesCreateRegion(display, NULL, 0);
-	XFixesSetWindowShapeRegion(display, overlay->window, ShapeInput, 0, 0, region);
+	XFixesSetWindowShapeRegion(display, out->window, ShapeInput, 0, 0, region);
 	XFixesDestroyRegion(display, region);
 
-	overlay->surface =
-	    cairo_xlib_surface_create(display, overlay->window, overlay->visual, overlay->width, overlay->height);
-	overlay->cr = cairo_create(overlay->surface);
+	out->gc = XCreateGC(display, out->window, 0, NULL);
+
+	if (!overlay->shm_available || !neru_x11_output_attach_shm(overlay, out)) {
+		overlay->shm_available = 0;
+		if (!neru_x11_output_alloc_image(overlay, out))
+			return 0;
+	}
+
+	out->surface = cairo_image_surface_create_for_data(
+	    (unsigned char *)out->image->data, CAIRO_FORMAT_ARGB32, w, h, out->image->bytes_per_line);
+	out->cr = cairo_create(out->surface);
+	// Draw commands arrive in root coordinates.
+	cairo_translate(out->cr, -x, -y);
+	return 1;
+}
+
+static void neru_x11_output_destroy(NeruX11Overlay *overlay, NeruX11OverlayOutput *out) {
+	if (out->cr != NULL)
+		cairo_destroy(out->cr);
+	if (out->surface != NULL)
+		cairo_surface_destroy(out->surface);
+	if (out->image != NULL) {
+		if (out->use_shm) {
+			XShmDetach(overlay->display, &out->shm);
+			shmdt(out->shm.shmaddr);
+			out->image->data = NULL;
+		}
+		XDestroyImage(out->image);
+	}
+	if (out->gc != NULL)
+		XFreeGC(overlay->display, out->gc);
+	if (out->window != 0)
+		XDestroyWindow(overlay->display, out->window);
+	memset(out, 0, sizeof(*out));
+}
+
+typedef struct {
+	int x, y, width, height;
+} NeruX11MonitorRect;
+
+// Active monitor rectangles from XRandR, deduplicated so mirrored CRTCs share
+// a window. Falls back to the whole root window.
+static int neru_x11_overlay_monitors(NeruX11Overlay *overlay, NeruX11MonitorRect *rects) {
+	int n = 0;
+
+	if (overlay->randr_event_base >= 0) {
+		int count = 0;
+		XRRMonitorInfo *monitors = XRRGetMonitors(overlay->display, overlay->root, True, &count);
+		for (int i = 0; monitors != NULL && i < count && n < NERU_MAX_OUTPUTS; i++) {
+			NeruX11MonitorRect rect = {monitors[i].x, monitors[i].y, monitors[i].width, monitors[i].height};
+			if (rect.width <= 0 || rect.height <= 0)
+				continue;
+
+			int duplicate = 0;
+			for (int j = 0; j < n; j++) {
+				if (memcmp(&rects[j], &rect, sizeof(rect)) == 0)
+					duplicate = 1;
+			}
+			if (!duplicate)
+				rects[n++] = rect;
+		}
+		if (monitors != NULL)
+			XRRFreeMonitors(monitors);
+	}
+
+	if (n == 0) {
+		rects[0] = (NeruX11MonitorRect){0, 0, overlay->width, overlay->height};
+		n = 1;
+	}
+	return n;
+}
+
+// Blocks until the server has consumed every XShmPutImage issued so far, so
+// the shared buffers may be drawn into (or detached) again. Deferred to the
+// start of the next frame so the upload overlaps the caller's idle time.
+static void neru_x11_overlay_wait_uploads(NeruX11Overlay *overlay) {
+	if (!overlay->shm_pending)
+		return;
+	XSync(overlay->display, False);
+	overlay->shm_pending = 0;
+}
+
+static void neru_x11_overlay_build_outputs(NeruX11Overlay *overlay, const NeruX11MonitorRect *rects, int n) {
+	neru_x11_overlay_wait_uploads(overlay);
+	for (int i = 0; i < overlay->nr_outputs; i++)
+		neru_x11_output_destroy(overlay, &overlay->outputs[i]);
+	overlay->nr_outputs = 0;
+
+	for (int i = 0; i < n; i++) {
+		NeruX11OverlayOutput *out = &overlay->outputs[overlay->nr_outputs];
+		if (neru_x11_output_create(overlay, out, rects[i].x, rects[i].y, rects[i].width, rects[i].height))
+			overlay->nr_outputs++;
+		else
+			neru_x11_output_destroy(overlay, out);
+	}
+}
+
+NeruX11Overlay *neru_x11_overlay_new(void) {
+	Display *display = XOpenDisplay(NULL);
+	if (display == NULL) {
+		return NULL;
+	}
+
+	NeruX11Overlay *overlay = calloc(1, sizeof(NeruX11Overlay));
+	if (!overlay) {
+		XCloseDisplay(display);
+		return NULL;
+	}
+	overlay->display = display;
+	overlay->screen = DefaultScreen(display);
+	overlay->root = RootWindow(display, overlay->screen);
+	overlay->visual = neru_x11_argb_visual(display, overlay->screen);
+	overlay->width = DisplayWidth(display, overlay->screen);
+	overlay->height = DisplayHeight(display, overlay->screen);
+	overlay->colormap = XCreateColormap(display, overlay->root, overlay->visual, AllocNone);
+
+	int randr_error_base;
+	overlay->randr_event_base = -1;
+	if (XRRQueryExtension(display, &overlay->randr_event_base, &randr_error_base)) {
+		XRRSelectInput(display, overlay->root, RRScreenChangeNotifyMask);
+	} else {
+		overlay->randr_event_base = -1;
+	}
+
+	overlay->shm_available = XShmQueryExtension(display);
+
+	NeruX11MonitorRect rects[NERU_MAX_OUTPUTS];
+	neru_x11_overlay_build_outputs(overlay, rects, neru_x11_overlay_monitors(overlay, rects));
+
+	overlay->label_cache = neru_label_cache_new(NERU_LABEL_CACHE_CAPACITY);
 	XFlush(display);
 
 	return overlay;
@@ -71,14 +303,9 @@ void neru_x11_overlay_destroy(NeruX11Overlay *overlay) {
 	if (overlay == NULL) {
 		return;
 	}
-	if (overlay->cr != NULL) {
-		cairo_destroy(overlay->cr);
-	}
-	if (overlay->surface != NULL) {
-		cairo_surface_destroy(overlay->surface);
-	}
-	if (overlay->window != 0) {
-		XDestroyWindow(overlay->display, overlay->window);
+	neru_x11_overlay_wait_uploads(overlay);
+	for (int i = 0; i < overlay->nr_outputs; i++) {
+		neru_x11_output_destroy(overlay, &overlay->outputs[i]);
 	}
 	if (overlay->colormap != 0) {
 		XFreeColormap(overlay->display, overlay->colormap);
@@ -86,34 +313,129 @@ void neru_x11_overlay_destroy(NeruX11Overlay *overlay) {
 	if (overlay->display != NULL) {
 		XCloseDisplay(overlay->display);
 	}
+	neru_label_cache_destroy(overlay->label_cache);
 	free(overlay);
 }
 
-void neru_x11_overlay_show(NeruX11Overlay *overlay) {
-	XMapRaised(overlay->display, overlay->window);
+static NeruX11OverlayOutput *neru_x11_overlay_output_for(NeruX11Overlay *overlay, Window window) {
+	for (int i = 0; i < overlay->nr_outputs; i++) {
+		if (overlay->outputs[i].window == window)
+			return &overlay->outputs[i];
+	}
+	return NULL;
+}
+
+// Handles RRScreenChangeNotify and Expose without blocking. Exposed areas
+// are re-uploaded from the client buffer with the next present.
+static void neru_x11_overlay_dispatch(NeruX11Overlay *overlay) {
+	int screen_changed = 0;
+
+	while (XPending(overlay->display) > 0) {
+		XEvent ev;
+		XNextEvent(overlay->display, &ev);
+		if (overlay->randr_event_base >= 0 && ev.type == overlay->randr_event_base + RRScreenChangeNotify) {
+			XRRUpdateConfiguration(&ev);
+			screen_changed = 1;
+		} else if (ev.type == Expose) {
+			NeruX11OverlayOutput *out = neru_x11_overlay_output_for(overlay, ev.xexpose.window);
+			if (out != NULL) {
+				neru_x11_box_add(
+				    out, &out->damage, ev.xexpose.x, ev.xexpose.y, ev.xexpose.x + ev.xexpose.width,
+				    ev.xexpose.y + ev.xexpose.height);
+			}
+		}
+	}
+
+	if (screen_changed)
+		neru_x11_overlay_resize(overlay);
+}
+
+// Maps outputs that hold content and unmaps the rest while visible. A newly
+// mapped window starts out transparent, so its content is re-damaged.
+static void neru_x11_overlay_sync_mapping(NeruX11Overlay *overlay) {
+	for (int i = 0; i < overlay->nr_outputs; i++) {
+		NeruX11OverlayOutput *out = &overlay->outputs[i];
+		int want = overlay->visible && !neru_x11_box_empty(&out->content);
+		if (want && !out->mapped) {
+			XMapRaised(overlay->display, out->window);
+			neru_x11_box_add(out, &out->damage, out->content.x0, out->content.y0, out->content.x1, out->content.y1);
+		} else if (!want && out->mapped) {
+			XUnmapWindow(overlay->display, out->window);
+		}
+		out->mapped = want;
+	}
+}
+
+// Uploads the damaged box of every mapped output. Unmapped outputs just drop
+// their damage; mapping them re-damages their content.
+static void neru_x11_overlay_present(NeruX11Overlay *overlay) {
+	neru_x11_overlay_sync_mapping(overlay);
+
+	for (int i = 0; i < overlay->nr_outputs; i++) {
+		NeruX11OverlayOutput *out = &overlay->outputs[i];
+		NeruX11Box d = out->damage;
+		out->damage = (NeruX11Box){0, 0, 0, 0};
+		if (!out->mapped || neru_x11_box_empty(&d))
+			continue;
+
+		cairo_surface_flush(out->surface);
+		unsigned int w = (unsigned int)(d.x1 - d.x0);
+		unsigned int h = (unsigned int)(d.y1 - d.y0);
+		if (out->use_shm) {
+			XShmPutImage(overlay->display, out->window, out->gc, out->image, d.x0, d.y0, d.x0, d.y0, w, h, False);
+			overlay->shm_pending = 1;
+		} else {
+			XPutImage(overlay->display, out->window, out->gc, out->image, d.x0, d.y0, d.x0, d.y0, w, h);
+		}
+	}
 	XFlush(overlay->display);
 }
 
+void neru_x11_overlay_show(NeruX11Overlay *overlay) {
+	neru_x11_overlay_dispatch(overlay);
+	overlay->visible = 1;
+	neru_x11_overlay_present(overlay);
+}
+
 void neru_x11_overlay_hide(NeruX11Overlay *overlay) {
-	XUnmapWindow(overlay->display, overlay->window);
+	overlay->visible = 0;
+	neru_x11_overlay_sync_mapping(overlay);
 	XFlush(overlay->display);
 }
 
+// Clears only what was drawn since the last clear and damages it, so an
+// emptied output costs one small upload rather than a full-window clear.
+static void neru_x11_output_clear(NeruX11OverlayOutput *out) {
+	NeruX11Box c = out->content;
+	if (neru_x11_box_empty(&c))
+		return;
+
+	cairo_save(out->cr);
+	cairo_identity_matrix(out->cr);
+	cairo_set_operator(out->cr, CAIRO_OPERATOR_CLEAR);
+	cairo_rectangle(out->cr, c.x0, c.y0, c.x1 - c.x0, c.y1 - c.y0);
+	cairo_fill(out->cr);
+	cairo_restore(out->cr);
+
+	neru_x11_box_add(out, &out->damage, c.x0, c.y0, c.x1, c.y1);
+	out->content = (NeruX11Box){0, 0, 0, 0};
+}
+
+// Only wipes the back buffers and records damage. Mapping and upload wait for
+// the next flush, so clear-then-redraw keeps the windows mapped and never
+// shows the empty frame in between.
 void neru_x11_overlay_clear(NeruX11Overlay *overlay) {
-	cairo_save(overlay->cr);
-	cairo_set_operator(overlay->cr, CAIRO_OPERATOR_CLEAR);
-	cairo_paint(overlay->cr);
-	cairo_restore(overlay->cr);
-	cairo_surface_flush(overlay->surface);
-	XClearWindow(overlay->display, overlay->window);
-	XFlush(overlay->display);
+	neru_x11_overlay_wait_uploads(overlay);
+	neru_x11_overlay_clear_buffered(overlay);
 }
 
 void neru_x11_overlay_clear_buffered(NeruX11Overlay *overlay) {
-	cairo_save(overlay->cr);
-	cairo_set_operator(overlay->cr, CAIRO_OPERATOR_CLEAR);
-	cairo_paint(overlay->cr);
-	cairo_restore(overlay->cr);
+	for (int i = 0; i < overlay->nr_outputs; i++)
+		neru_x11_output_clear(&overlay->outputs[i]);
+}
+
+static int neru_x11_output_hit(const NeruX11OverlayOutput *out, double x, double y, double width, double height) {
+	return x < out->x + out->width && x + width > out->x && y < out->y + out->height && y + height > out->y;
 }
 
 void neru_x11_overlay_clear_rect(NeruX11Overlay *overlay, int x, int y, int width, int height) {
@@ -121,26 +443,37 @@ void neru_x11_overlay_clear_rect(NeruX11Overlay *overlay, int x, int y, int widt
 		return;
 	}
 
-	cairo_save(overlay->cr);
-	cairo_set_operator(overlay->cr, CAIRO_OPERATOR_CLEAR);
-	cairo_rectangle(overlay->cr, x, y, width, height);
-	cairo_fill(overlay->cr);
-	cairo_restore(overlay->cr);
-	cairo_surface_flush(overlay->surface);
-	XClearArea(overlay->display, overlay->window, x, y, (unsigned int)width, (unsigned int)height, False);
-	XFlush(overlay->display);
+	for (int i = 0; i < overlay->nr_outputs; i++) {
+		NeruX11OverlayOutput *out = &overlay->outputs[i];
+		if (neru_x11_box_empty(&out->content) || !neru_x11_output_hit(out, x, y, width, height))
+			continue;
+
+		cairo_save(out->cr);
+		cairo_set_operator(out->cr, CAIRO_OPERATOR_CLEAR);
+		cairo_rectangle(out->cr, x, y, width, height);
+		cairo_fill(out->cr);
+		cairo_restore(out->cr);
+		neru_x11_box_add(out, &out->damage, x - out->x, y - out->y, x - out->x + width, y - out->y + height);
+	}
 }
 
 void neru_x11_overlay_resize(NeruX11Overlay *overlay) {
-	int width = DisplayWidth(overlay->display, overlay->screen);
-	int height = DisplayHeight(overlay->display, overlay->screen);
-	if (width == overlay->width && height == overlay->height) {
-		return;
+	overlay->width = DisplayWidth(overlay->display, overlay->screen);
+	overlay->height = DisplayHeight(overlay->display, overlay->screen);
+
+	NeruX11MonitorRect rects[NERU_MAX_OUTPUTS];
+	int n = neru_x11_overlay_monitors(overlay, rects);
+
+	int unchanged = n == overlay->nr_outputs;
+	for (int i = 0; unchanged && i < n; i++) {
+		const NeruX11OverlayOutput *out = &overlay->outputs[i];
+		unchanged = out->x == rects[i].x && out->y == rects[i].y && out->width == rects[i].width &&
+		            out->height == rects[i].height;
 	}
-	overlay->width = width;
-	overlay->height = height;
-	XResizeWindow(overlay->display, overlay->window, width, height);
-	cairo_xlib_surface_set_size(overlay->surface, width, height);
+	if (unchanged)
+		return;
+
+	neru_x11_overlay_build_outputs(overlay, rects, n);
 	XFlush(overlay->display);
 }
 
@@ -152,18 +485,41 @@ static void neru_x11_overlay_color(cairo_t *cr, unsigned int color) {
 	cairo_set_source_rgba(cr, r, g, b, a);
 }
 
+// Reports whether a primitive with the given root-coordinate bounds lands on
+// out. If so its pixels (plus a pixel of antialiasing) are recorded as both
+// content and damage.
+static int neru_x11_output_touch(NeruX11OverlayOutput *out, double x, double y, double width, double height) {
+	if (!neru_x11_output_hit(out, x, y, width, height))
+		return 0;
+
+	int x0 = (int)floor(x) - out->x - 1;
+	int y0 = (int)floor(y) - out->y - 1;
+	int x1 = (int)ceil(x + width) - out->x + 1;
+	int y1 = (int)ceil(y + height) - out->y + 1;
+	neru_x11_box_add(out, &out->content, x0, y0, x1, y1);
+	neru_x11_box_add(out, &out->damage, x0, y0, x1, y1);
+	return 1;
+}
+
 void neru_x11_overlay_rect(
     NeruX11Overlay *overlay, double x, double y, double width, double height, unsigned int fill, unsigned int stroke,
     double stroke_width) {
-	cairo_t *cr = overlay->cr;
-	cairo_save(cr);
-	cairo_rectangle(cr, x, y, width, height);
-	neru_x11_overlay_color(cr, fill);
-	cairo_fill_preserve(cr);
-	neru_x11_overlay_color(cr, stroke);
-	cairo_set_line_width(cr, stroke_width);
-	cairo_stroke(cr);
-	cairo_restore(cr);
+	double m = stroke_width / 2.0;
+	for (int i = 0; i < overlay->nr_outputs; i++) {
+		NeruX11OverlayOutput *out = &overlay->outputs[i];
+		if (!neru_x11_output_touch(out, x - m, y - m, width + 2 * m, height + 2 * m))
+			continue;
+
+		cairo_t *cr = out->cr;
+		cairo_save(cr);
+		cairo_rectangle(cr, x, y, width, height);
+		neru_x11_overlay_color(cr, fill);
+		cairo_fill_preserve(cr);
+		neru_x11_overlay_color(cr, stroke);
+		cairo_set_line_width(cr, stroke_width);
+		cairo_stroke(cr);
+		cairo_restore(cr);
+	}
 }
 
 static void neru_x11_overlay_rounded_path(cairo_t *cr, double x, double y, double width, double height, double radius) {
@@ -187,33 +543,114 @@ static void neru_x11_overlay_rounded_path(cairo_t *cr, double x, double y, doubl
 void neru_x11_overlay_rounded_rect(
     NeruX11Overlay *overlay, double x, double y, double width, double height, double radius, unsigned int fill,
     unsigned int stroke, double stroke_width) {
-	cairo_t *cr = overlay->cr;
-	cairo_save(cr);
-	neru_x11_overlay_rounded_path(cr, x, y, width, height, radius);
-	neru_x11_overlay_color(cr, fill);
-	cairo_fill_preserve(cr);
-	neru_x11_overlay_color(cr, stroke);
-	cairo_set_line_width(cr, stroke_width);
-	cairo_stroke(cr);
-	cairo_restore(cr);
+	double m = stroke_width / 2.0;
+	for (int i = 0; i < overlay->nr_outputs; i++) {
+		NeruX11OverlayOutput *out = &overlay->outputs[i];
+		if (!neru_x11_output_touch(out, x - m, y - m, width + 2 * m, height + 2 * m))
+			continue;
+
+		cairo_t *cr = out->cr;
+		cairo_save(cr);
+		neru_x11_overlay_rounded_path(cr, x, y, width, height, radius);
+		neru_x11_overlay_color(cr, fill);
+		cairo_fill_preserve(cr);
+		neru_x11_overlay_color(cr, stroke);
+		cairo_set_line_width(cr, stroke_width);
+		cairo_stroke(cr);
+		cairo_restore(cr);
+	}
 }
 
 void neru_x11_overlay_text(
     NeruX11Overlay *overlay, const char *text, const char *font_family, double x, double y, double font_size,
     unsigned int color) {
-	cairo_t *cr = overlay->cr;
-	cairo_text_extents_t extents;
-	cairo_save(cr);
-	cairo_select_font_face(cr, font_family, CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
-	cairo_set_font_size(cr, font_size);
-	cairo_text_extents(cr, text, &extents);
-	neru_x11_overlay_color(cr, color);
-	cairo_move_to(cr, x - (extents.width / 2.0) - extents.x_bearing, y - (extents.height / 2.0) - extents.y_bearing);
-	cairo_show_text(cr, text);
-	cairo_restore(cr);
-}
-
-void neru_x11_overlay_flush(NeruX11Overlay *overlay) {
-	cairo_surface_flush(overlay->surface);
-	XFlush(overlay->display);
+	// Text is centered on (x, y); bound it generously by its byte length so
+	// a label straddling two monitors is drawn on both.
+	double half_w = font_size * ((double)strlen(text) + 1.0);
+	double half_h = font_size;
+	for (int i = 0; i < overlay->nr_outputs; i++) {
+		NeruX11OverlayOutput *out = &overlay->outputs[i];
+		if (!neru_x11_output_touch(out, x - half_w, y - half_h, 2 * half_w, 2 * half_h))
+			continue;
+
+		cairo_t *cr = out->cr;
+		double lx, ly, lw, lh;
+		if (neru_label_cache_draw(
+		        overlay->label_cache, cr, text, font_family, x, y, font_size, color, 1.0, &lx, &ly, &lw, &lh)) {
+			continue;
+		}
+
+		cairo_text_extents_t extents;
+		cairo_save(cr);
+		cairo_select_font_face(cr, font_family, CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
+		cairo_set_font_size(cr, font_size);
+		cairo_text_extents(cr, text, &extents);
+		neru_x11_overlay_color(cr, color);
+		cairo_move_to(
+		    cr, x - (extents.width / 2.0) - extents.x_bearing, y - (extents.height / 2.0) - extents.y_bearing);
+		cairo_show_text(cr, text);
+		cairo_restore(cr);
+	}
+}
+
+static void neru_x11_target_clear(void *ctx) { neru_x11_overlay_clear_buffered((NeruX11Overlay *)ctx); }
+
+static void neru_x11_target_clear_rect(void *ctx, double x, double y, double width, double height) {
+	neru_x11_overlay_clear_rect((NeruX11Overlay *)ctx, (int)x, (int)y, (int)width, (int)height);
+}
+
+static void neru_x11_target_rect(
+    void *ctx, double x, double y, double width, double height, unsigned int fill, unsigned int stroke,
+    double stroke_width) {
+	neru_x11_overlay_rect((NeruX11Overlay *)ctx, x, y, width, height, fill, stroke, stroke_width);
+}
+
+static void neru_x11_target_rounded_rect(
+    void *ctx, double x, double y, double width, double height, double radius, unsigned int fill, unsigned int stroke,
+    double stroke_width) {
+	neru_x11_overlay_rounded_rect((NeruX11Overlay *)ctx, x, y, width, height, radius, fill, stroke, stroke_width);
+}
+
+static void neru_x11_target_text(
+    void *ctx, const char *text, const char *font_family, double x, double y, double font_size, unsigned int color) {
+	neru_x11_overlay_text((NeruX11Overlay *)ctx, text, font_family, x, y, font_size, color);
+}
+
+static const NeruDrawTarget neru_x11_draw_target = {
+    .clear = neru_x11_target_clear,
+    .clear_rect = neru_x11_target_clear_rect,
+    .rect = neru_x11_target_rect,
+    .rounded_rect = neru_x11_target_rounded_rect,
+    .text = neru_x11_target_text,
+};
+
+int neru_x11_overlay_submit(
+    NeruX11Overlay *overlay, unsigned int version, const NeruDrawCmd *cmds, int n, const char *strings,
+    size_t strings_len) {
+	if (overlay == NULL) {
+		return -1;
+	}
+	neru_x11_overlay_wait_uploads(overlay);
+	neru_x11_overlay_dispatch(overlay);
+	return neru_draw_cmds_replay(&neru_x11_draw_target, overlay, version, cmds, n, strings, strings_len);
+}
+
+void neru_x11_overlay_flush(NeruX11Overlay *overlay) { neru_x11_overlay_present(overlay); }
+
+int neru_x11_overlay_mapped_outputs(NeruX11Overlay *overlay) {
+	int mapped = 0;
+	for (int i = 0; overlay != NULL && i < overlay->nr_outputs; i++)
+		mapped += overlay->outputs[i].mapped;
+	return mapped;
+}
+
+void neru_x11_overlay_invalidate_label_cache(NeruX11Overlay *overlay) {
+	if (overlay == NULL) {
+		return;
+	}
+	neru_label_cache_invalidate(overlay->label_cache);
+}
+
+void neru_x11_overlay_label_cache_stats(NeruX11Overlay *overlay, NeruLabelCacheStats *stats) {
+	neru_label_cache_stats(overlay != NULL ? overlay->label_cache : NULL, stats);
 }
@@ -1,20 +1,58 @@
 #ifndef X11_OVERLAY_H
 #define X11_OVERLAY_H
 
+#include "common_defs.h"
+#include "label_cache.h"
+#include "overlay_cmds.h"
+
 #include <X11/Xlib.h>
+#include <X11/extensions/XShm.h>
 #include <cairo/cairo.h>
 
+// Half-open pixel box in output window coordinates; empty when x1 <= x0.
+typedef struct {
+	int x0, y0, x1, y1;
+} NeruX11Box;
+
+// One override-redirect ARGB window covering a single monitor. Frames are
+// composed in a client-side image surface and only the damaged box is
+// uploaded, so drawing costs no protocol requests until the frame is
+// presented. The cairo context is translated so draw calls use root
+// coordinates.
+typedef struct {
+	int x, y, width, height;
+	Window window;
+	GC gc;
+	XImage *image;        // wraps the pixels cairo draws into
+	XShmSegmentInfo shm;  // valid when use_shm
+	int use_shm;          // uploads go through MIT-SHM instead of the socket
+	cairo_surface_t *surface;
+	cairo_t *cr;
+	NeruX11Box content;  // drawn since the last clear; empty means nothing to show
+	NeruX11Box damage;   // changed since the last present
+	int mapped;          // window is currently mapped
+} NeruX11OverlayOutput;
+
 typedef struct {
 	Display *display;
 	int screen;
 	Window root;
-	Window window;
 	Visual *visual;
 	Colormap colormap;
-	cairo_surface_t *surface;
-	cairo_t *cr;
-	int width;
+	int width;  // root window size the outputs were enumerated for
 	int height;
+	int randr_event_base;  // -1 without XRandR
+	int shm_available;     // server supports MIT-SHM
+	int shm_pending;       // an XShmPutImage may still be reading the buffers
+
+	// One window per XRandR monitor. Only outputs with content are mapped,
+	// so clears and uploads scale with the monitors a mode draws on rather
+	// than the whole virtual screen.
+	NeruX11OverlayOutput outputs[NERU_MAX_OUTPUTS];
+	int nr_outputs;
+	int visible;
+
+	NeruLabelCache *label_cache;
 } NeruX11Overlay;
 
 NeruX11Overlay *neru_x11_overlay_new(void);
@@ -24,6 +62,8 @@ void neru_x11_overlay_hide(NeruX11Overlay *overlay);
 void neru_x11_overlay_clear(NeruX11Overlay *overlay);
 void neru_x11_overlay_clear_buffered(NeruX11Overlay *overlay);
 void neru_x11_overlay_clear_rect(NeruX11Overlay *overlay, int x, int y, int width, int height);
+// Re-enumerates monitors and rebuilds the output windows when the layout
+// changed. Output contents are lost; callers redraw afterwards.
 void neru_x11_overlay_resize(NeruX11Overlay *overlay);
 void neru_x11_overlay_rect(
     NeruX11Overlay *overlay, double x, double y, double width, double height, unsigned int fill, unsigned int stroke,
@@ -34,6 +74,12 @@ void neru_x11_overlay_rounded_rect(
 void neru_x11_overlay_text(
     NeruX11Overlay *overlay, const char *text, const char *font_family, double x, double y, double font_size,
     unsigned int color);
+int neru_x11_overlay_submit(
+    NeruX11Overlay *overlay, unsigned int version, const NeruDrawCmd *cmds, int n, const char *strings,
+    size_t strings_len);
 void neru_x11_overlay_flush(NeruX11Overlay *overlay);
+int neru_x11_overlay_mapped_outputs(NeruX11Overlay *overlay);
+void neru_x11_overlay_invalidate_label_cache(NeruX11Overlay *overlay);
+void neru_x11_overlay_label_cache_stats(NeruX11Overlay *overlay, NeruLabelCacheStats *stats);
 
 #endif /* X11_OVERLAY_H */
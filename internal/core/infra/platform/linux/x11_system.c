@@ -5,9 +5,12 @@
 #include <X11/Xutil.h>
 #include <X11/extensions/XTest.h>
 #include <X11/extensions/Xrandr.h>
+#include <poll.h>
 #include <stdlib.h>
 #include <string.h>
 
+void neru_x11_init_threads(void) { XInitThreads(); }
+
 Display *neru_x11_open_display(void) { return XOpenDisplay(NULL); }
 
 void neru_x11_close_display(Display *display) {
@@ -16,6 +19,16 @@ void neru_x11_close_display(Display *display) {
 	}
 }
 
+// Reports whether the server side of a long-lived connection is still there,
+// without issuing a request: a request on a dead connection would run Xlib's
+// fatal I/O error handler.
+int neru_x11_connection_alive(Display *display) {
+	struct pollfd pfd = {.fd = ConnectionNumber(display), .events = 0, .revents = 0};
+	if (poll(&pfd, 1, 0) < 0)
+		return 1;
+	return (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) == 0;
+}
+
 static Window neru_x11_root_window(Display *display) { return RootWindow(display, DefaultScreen(display)); }
 
 int neru_x11_query_pointer(Display *display, int *x, int *y) {
@@ -13,8 +13,10 @@ typedef struct {
 	char *name;
 } NeruX11Monitor;
 
+void neru_x11_init_threads(void);
 Display *neru_x11_open_display(void);
 void neru_x11_close_display(Display *display);
+int neru_x11_connection_alive(Display *display);
 int neru_x11_query_pointer(Display *display, int *x, int *y);
 int neru_x11_move_pointer(Display *display, int x, int y);
 int neru_x11_get_active_window(Display *display, Window *out);
@@ -0,0 +1,56 @@
+#include "x11_wait.h"
+
+#include <X11/Xlib.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+int neru_x11_waker_open(void) { return eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK); }
+
+void neru_x11_waker_close(int wake_fd) {
+	if (wake_fd >= 0)
+		close(wake_fd);
+}
+
+void neru_x11_waker_wake(int wake_fd) {
+	if (wake_fd < 0)
+		return;
+	uint64_t one = 1;
+	ssize_t written = write(wake_fd, &one, sizeof(one));
+	(void)written;
+}
+
+int neru_x11_wait(Display *display, int wake_fd, int timeout_ms) {
+	// XPending flushes our output and reads whatever already arrived, so
+	// events buffered by Xlib are never left waiting on a quiet socket.
+	if (XPending(display) > 0)
+		return 1;
+
+	struct pollfd pfds[2] = {
+	    {.fd = ConnectionNumber(display), .events = POLLIN, .revents = 0},
+	    {.fd = wake_fd, .events = POLLIN, .revents = 0},
+	};
+	int nfds = wake_fd >= 0 ? 2 : 1;
+
+	int ret;
+	do {
+		ret = poll(pfds, nfds, timeout_ms);
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret < 0)
+		return -1;
+
+	if (nfds > 1 && (pfds[1].revents & POLLIN)) {
+		uint64_t count;
+		while (read(wake_fd, &count, sizeof(count)) > 0) {
+		}
+		return 0;
+	}
+
+	if (pfds[0].revents & (POLLERR | POLLHUP | POLLNVAL))
+		return -1;
+
+	return ret > 0 ? 1 : 0;
+}
@@ -0,0 +1,15 @@
+#ifndef X11_WAIT_H
+#define X11_WAIT_H
+
+#include <X11/Xlib.h>
+
+// Wakeup eventfd for loops blocked in neru_x11_wait; -1 on failure.
+int neru_x11_waker_open(void);
+void neru_x11_waker_close(int wake_fd);
+void neru_x11_waker_wake(int wake_fd);
+// Blocks until the display has queued events (1), wake_fd was signalled or
+// the timeout expired (0), or the connection failed (-1). A negative
+// timeout_ms waits indefinitely.
+int neru_x11_wait(Display *display, int wake_fd, int timeout_ms);
+
+#endif /* X11_WAIT_H */
@@ -50,6 +50,36 @@ type EventTapPort interface {
 	Destroy()
 }
 
+// EventQueueStats counts the traffic through one bounded queue of an input
+// pipeline since it was created.
+type EventQueueStats struct {
+	Capacity  int    `json:"capacity"`
+	Produced  uint64 `json:"produced"`
+	Consumed  uint64 `json:"consumed"`
+	Dropped   uint64 `json:"dropped"`
+	HighWater uint64 `json:"highWater"`
+
+	// Batches, Coalesced and Frames are only set by queues whose consumer
+	// writes in batches: how many batches it took, how many items it merged
+	// into a later one, and how many protocol frames it sent.
+	Batches   uint64 `json:"batches,omitempty"`
+	Coalesced uint64 `json:"coalesced,omitempty"`
+	Frames    uint64 `json:"frames,omitempty"`
+
+	// LatencyAvgUs and LatencyMaxUs are only set by queues that time their
+	// items: mean and worst microseconds from submission until sent.
+	LatencyAvgUs uint64 `json:"latencyAvgUs,omitempty"`
+	LatencyMaxUs uint64 `json:"latencyMaxUs,omitempty"`
+}
+
+// EventQueueStatsProvider is optionally implemented by an EventTapPort or
+// SystemPort whose pipeline hands input between threads through bounded
+// queues.
+type EventQueueStatsProvider interface {
+	// EventQueueStats returns the counters of each queue, keyed by stage.
+	EventQueueStats() map[string]EventQueueStats
+}
+
 // HotkeyPort defines the interface for global hotkey registration.
 // Implementations handle platform-specific hotkey APIs.
 type HotkeyPort interface {
@@ -8,6 +8,7 @@ import (
 	"strconv"
 	"strings"
 	"sync"
+	"time"
 	"unsafe"
 
 	"go.uber.org/zap"
@@ -61,6 +62,15 @@ const (
 	initialSubscriberCapacity                             = 4
 )
 
+// badgeSlot identifies a cursor-following badge that the wlroots backend can
+// place on its own subsurface.
+type badgeSlot int
+
+const (
+	badgeSlotModeIndicator badgeSlot = iota
+	badgeSlotStickyModifiers
+)
+
 // Manager manages overlay rendering on Linux.
 type Manager struct {
 	logger *zap.Logger
@@ -225,6 +235,9 @@ func (m *Manager) Clear() {
 		m.x11.Clear()
 	} else if m.wlroots != nil {
 		m.wlroots.Clear()
+		// Badge subsurfaces sit outside the cleared buffer.
+		m.wlroots.HideBadgeSurface(badgeSlotModeIndicator)
+		m.wlroots.HideBadgeSurface(badgeSlotStickyModifiers)
 	}
 
 	m.stickyBadgeVisible = false
@@ -237,6 +250,33 @@ func (m *Manager) Clear() {
 // cross-mode cache state.
 func (m *Manager) ClearCache() {}
 
+// InvalidateLabelCache drops the backend's pre-rasterized label bitmaps. Call
+// it after a theme or font configuration change; unlike ClearCache it is not
+// tied to mode exits, so labels stay cached across overlay sessions.
+func (m *Manager) InvalidateLabelCache() {
+	m.renderMu.Lock()
+	defer m.renderMu.Unlock()
+
+	if m.x11 != nil {
+		m.x11.invalidateLabelCache()
+	} else if m.wlroots != nil {
+		m.wlroots.invalidateLabelCache()
+	}
+}
+
+// ConfigureOverlayStandby controls whether Hide keeps the Wayland layer
+// surfaces and SHM buffers warm for the next activation, how long they may sit
+// idle, and how much buffer memory may stay mapped while hidden. X11 keeps a
+// single mapped-on-demand window and ignores these settings.
+func (m *Manager) ConfigureOverlayStandby(enabled bool, idleTimeout time.Duration, maxBytes uint64) {
+	m.renderMu.Lock()
+	defer m.renderMu.Unlock()
+
+	if m.wlroots != nil {
+		m.wlroots.configureStandby(enabled, idleTimeout, maxBytes)
+	}
+}
+
 // ResizeToActiveScreen resizes the overlay to the active screen.
 func (m *Manager) ResizeToActiveScreen() {
 	m.renderMu.Lock()
@@ -480,6 +520,11 @@ func (m *Manager) DrawModeIndicator(posX, posY int) {
 
 	m.clearModeIndicatorBadgeLocked()
 
+	if m.wlroots != nil &&
+		m.wlroots.DrawBadgeSurface(badgeSlotModeIndicator, posX, posY, label, colors, style) {
+		return
+	}
+
 	rect := badgeBounds(posX, posY, label, style)
 	m.modeIndicatorBadgeRect = expandRect(rect, stickyBadgeClearPadding)
 	m.modeIndicatorBadgeVisible = true
@@ -503,6 +548,10 @@ func (m *Manager) DrawStickyModifiersIndicator(posX, posY int, symbols string) {
 	if symbols == "" {
 		m.clearStickyBadgeLocked()
 
+		if m.wlroots != nil {
+			m.wlroots.HideBadgeSurface(badgeSlotStickyModifiers)
+		}
+
 		return
 	}
 
@@ -512,6 +561,12 @@ func (m *Manager) DrawStickyModifiersIndicator(posX, posY int, symbols string) {
 	}
 
 	m.clearStickyBadgeLocked()
+
+	if m.wlroots != nil &&
+		m.wlroots.DrawBadgeSurface(badgeSlotStickyModifiers, posX, posY, symbols, colors, style) {
+		return
+	}
+
 	m.stickyBadgeRect = expandRect(
 		badgeBounds(posX, posY, symbols, style),
 		stickyBadgeClearPadding,
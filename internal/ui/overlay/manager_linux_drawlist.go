@@ -0,0 +1,133 @@
+//go:build linux && cgo
+
+package overlay
+
+/*
+#include "../../core/infra/platform/linux/overlay_cmds.h"
+*/
+import "C"
+
+import (
+	"image"
+	"unsafe"
+)
+
+const drawListInitialCapacity = 256
+
+// drawList accumulates overlay primitives for one frame so the whole frame
+// crosses the cgo boundary in a single submit call instead of one call per
+// rect or label. Both the X11 and wlroots backends replay the same packed
+// NeruDrawCmd layout on the C side.
+type drawList struct {
+	cmds    []C.NeruDrawCmd
+	strings []byte
+	offsets map[string]C.uint32_t
+}
+
+func newDrawList() *drawList {
+	return &drawList{
+		cmds:    make([]C.NeruDrawCmd, 0, drawListInitialCapacity),
+		offsets: make(map[string]C.uint32_t),
+	}
+}
+
+func (l *drawList) empty() bool {
+	return len(l.cmds) == 0
+}
+
+func (l *drawList) reset() {
+	l.cmds = l.cmds[:0]
+	l.strings = l.strings[:0]
+	clear(l.offsets)
+}
+
+// raw returns C views of the command list and string table. The pointers are
+// only valid until the next mutation of the list.
+func (l *drawList) raw() (*C.NeruDrawCmd, C.int, *C.char, C.size_t) {
+	if len(l.cmds) == 0 {
+		return nil, 0, nil, 0
+	}
+
+	var strs *C.char
+	if len(l.strings) > 0 {
+		strs = (*C.char)(unsafe.Pointer(&l.strings[0]))
+	}
+
+	return &l.cmds[0], C.int(len(l.cmds)), strs, C.size_t(len(l.strings))
+}
+
+func (l *drawList) clear() {
+	l.cmds = append(l.cmds, C.NeruDrawCmd{op: C.NERU_DRAW_OP_CLEAR})
+}
+
+func (l *drawList) clearRect(bounds image.Rectangle) {
+	l.cmds = append(l.cmds, C.NeruDrawCmd{
+		op:     C.NERU_DRAW_OP_CLEAR_RECT,
+		x:      C.double(bounds.Min.X),
+		y:      C.double(bounds.Min.Y),
+		width:  C.double(bounds.Dx()),
+		height: C.double(bounds.Dy()),
+	})
+}
+
+func (l *drawList) rect(bounds image.Rectangle, fill, border uint32, lineWidth float64) {
+	l.cmds = append(l.cmds, C.NeruDrawCmd{
+		op:           C.NERU_DRAW_OP_RECT,
+		x:            C.double(bounds.Min.X),
+		y:            C.double(bounds.Min.Y),
+		width:        C.double(bounds.Dx()),
+		height:       C.double(bounds.Dy()),
+		fill:         C.uint32_t(fill),
+		stroke:       C.uint32_t(border),
+		stroke_width: C.double(lineWidth),
+	})
+}
+
+func (l *drawList) roundedRect(
+	bounds image.Rectangle,
+	radius float64,
+	fill, border uint32,
+	lineWidth float64,
+) {
+	l.cmds = append(l.cmds, C.NeruDrawCmd{
+		op:           C.NERU_DRAW_OP_ROUNDED_RECT,
+		x:            C.double(bounds.Min.X),
+		y:            C.double(bounds.Min.Y),
+		width:        C.double(bounds.Dx()),
+		height:       C.double(bounds.Dy()),
+		radius:       C.double(radius),
+		fill:         C.uint32_t(fill),
+		stroke:       C.uint32_t(border),
+		stroke_width: C.double(lineWidth),
+	})
+}
+
+func (l *drawList) textCentered(
+	text string, bounds image.Rectangle,
+	fontFamily string, fontSize float64, color uint32,
+) {
+	l.cmds = append(l.cmds, C.NeruDrawCmd{
+		op:        C.NERU_DRAW_OP_TEXT,
+		x:         C.double(bounds.Min.X + bounds.Dx()/centeredRectDivisor),
+		y:         C.double(bounds.Min.Y + bounds.Dy()/centeredRectDivisor),
+		font_size: C.double(fontSize),
+		fill:      C.uint32_t(color),
+		text:      l.intern(text),
+		font:      l.intern(fontFamily),
+	})
+}
+
+// intern stores s once per frame in the NUL-separated string table. Labels
+// and font names repeat heavily across a frame, so this keeps the table small.
+func (l *drawList) intern(s string) C.uint32_t {
+	if off, ok := l.offsets[s]; ok {
+		return off
+	}
+
+	off := C.uint32_t(len(l.strings))
+	l.strings = append(l.strings, s...)
+	l.strings = append(l.strings, 0)
+	l.offsets[s] = off
+
+	return off
+}
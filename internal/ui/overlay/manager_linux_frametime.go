@@ -0,0 +1,79 @@
+//go:build linux && cgo
+
+package overlay
+
+import (
+	"time"
+
+	"go.uber.org/zap"
+)
+
+// frameTimeReportInterval is how many frames are summarized per debug log.
+const frameTimeReportInterval = 120
+
+// frameTimeBounds are the histogram bucket upper bounds. They bracket the
+// 60 Hz and 30 Hz frame budgets; slower frames land in a final overflow
+// bucket.
+var frameTimeBounds = []time.Duration{
+	1 * time.Millisecond,
+	2 * time.Millisecond,
+	4 * time.Millisecond,
+	8 * time.Millisecond,
+	16 * time.Millisecond,
+	33 * time.Millisecond,
+}
+
+// frameTimeHistogram buckets submit-to-present times so grid animation
+// stalls show up in debug logs without a log line per frame.
+type frameTimeHistogram struct {
+	counts []int
+	frames int
+	total  time.Duration
+	max    time.Duration
+}
+
+func newFrameTimeHistogram() *frameTimeHistogram {
+	return &frameTimeHistogram{counts: make([]int, len(frameTimeBounds)+1)}
+}
+
+// observe records one frame and reports whether a summary is due.
+func (h *frameTimeHistogram) observe(elapsed time.Duration) bool {
+	bucket := len(frameTimeBounds)
+	for i, bound := range frameTimeBounds {
+		if elapsed <= bound {
+			bucket = i
+
+			break
+		}
+	}
+
+	h.counts[bucket]++
+	h.frames++
+	h.total += elapsed
+	h.max = max(h.max, elapsed)
+
+	return h.frames >= frameTimeReportInterval
+}
+
+// fields summarizes the frames observed since the last call and resets the
+// histogram.
+func (h *frameTimeHistogram) fields() []zap.Field {
+	if h.frames == 0 {
+		return nil
+	}
+
+	fields := []zap.Field{
+		zap.Int("frames", h.frames),
+		zap.Duration("mean_frame_time", h.total/time.Duration(h.frames)),
+		zap.Duration("max_frame_time", h.max),
+		zap.Durations("frame_time_bounds", frameTimeBounds),
+		zap.Ints("frame_time_counts", append([]int(nil), h.counts...)),
+	}
+
+	clear(h.counts)
+	h.frames = 0
+	h.total = 0
+	h.max = 0
+
+	return fields
+}
@@ -0,0 +1,62 @@
+//go:build linux && cgo
+
+package overlay //nolint:testpackage // tests exercise the unexported frame-time histogram directly
+
+import (
+	"testing"
+	"time"
+)
+
+func TestFrameTimeHistogramBuckets(t *testing.T) {
+	t.Parallel()
+
+	histogram := newFrameTimeHistogram()
+	for _, elapsed := range []time.Duration{
+		500 * time.Microsecond,
+		time.Millisecond, // bounds are inclusive
+		3 * time.Millisecond,
+		20 * time.Millisecond,
+		50 * time.Millisecond,
+	} {
+		if histogram.observe(elapsed) {
+			t.Fatalf("observe reported a summary after %d frames", histogram.frames)
+		}
+	}
+
+	want := []int{2, 0, 1, 0, 0, 1, 1}
+	for i, count := range histogram.counts {
+		if count != want[i] {
+			t.Fatalf("counts = %v, want %v", histogram.counts, want)
+		}
+	}
+
+	if histogram.max != 50*time.Millisecond {
+		t.Fatalf("max = %v, want 50ms", histogram.max)
+	}
+}
+
+func TestFrameTimeHistogramReportResets(t *testing.T) {
+	t.Parallel()
+
+	histogram := newFrameTimeHistogram()
+	if histogram.fields() != nil {
+		t.Fatal("fields of an empty histogram should be nil")
+	}
+
+	due := false
+	for range frameTimeReportInterval {
+		due = histogram.observe(2 * time.Millisecond)
+	}
+
+	if !due {
+		t.Fatalf("observe did not report a summary after %d frames", frameTimeReportInterval)
+	}
+
+	if got := len(histogram.fields()); got == 0 {
+		t.Fatal("fields returned no summary")
+	}
+
+	if histogram.frames != 0 || histogram.max != 0 || histogram.counts[1] != 0 {
+		t.Fatalf("histogram not reset: %+v", histogram)
+	}
+}
@@ -9,6 +9,7 @@ package overlay
 import (
 	"image"
 	"sync"
+	"time"
 	"unsafe"
 
 	"go.uber.org/zap"
@@ -81,7 +82,17 @@ func (o *wlrootsOverlay) Flush() {}
 
 func (o *wlrootsOverlay) DrawBadge(int, int, string, overlayColors, overlayBadgeStyle) {}
 
-func (o *wlrootsOverlay) cancelAnimation()               {}
-func (o *wlrootsOverlay) setDisplayMu(_ *sync.Mutex)     {}
-func (o *wlrootsOverlay) setKeyboardCaptureEnabled(bool) {}
-func (o *wlrootsOverlay) startPoller()                   {}
+func (o *wlrootsOverlay) DrawBadgeSurface(
+	badgeSlot, int, int, string, overlayColors, overlayBadgeStyle,
+) bool {
+	return false
+}
+
+func (o *wlrootsOverlay) HideBadgeSurface(badgeSlot) {}
+
+func (o *wlrootsOverlay) cancelAnimation()                             {}
+func (o *wlrootsOverlay) setDisplayMu(_ *sync.Mutex)                   {}
+func (o *wlrootsOverlay) setKeyboardCaptureEnabled(bool)               {}
+func (o *wlrootsOverlay) startPoller()                                 {}
+func (o *wlrootsOverlay) invalidateLabelCache()                        {}
+func (o *wlrootsOverlay) configureStandby(bool, time.Duration, uint64) {}
@@ -40,9 +40,23 @@ type wlrootsOverlay struct {
 
 	displayMu *sync.Mutex
 
+	// draw holds the primitives of the frame being built; it is replayed in
+	// one neru_wayland_overlay_submit call before each commit.
+	draw *drawList
+
 	stopCh chan struct{}
 	doneCh chan struct{}
 
+	// Warm standby: Hide keeps the layer surfaces and SHM pools mapped and
+	// standbyTimer releases them after standbyIdle without a new activation.
+	// All fields are guarded by displayMu.
+	standbyIdle     time.Duration
+	standbyTimer    *time.Timer
+	standbyGen      uint64
+	destroyed       bool
+	activationStart time.Time
+	activationWarm  bool
+
 	cancelMu         sync.Mutex
 	animStop         chan struct{}
 	animDone         chan struct{}
@@ -55,6 +69,10 @@ type wlrootsOverlay struct {
 	currentAnimRects []image.Rectangle
 }
 
+// frameCallbackTimeoutMs bounds how long rendering waits for a frame
+// callback or buffer release before drawing anyway.
+const frameCallbackTimeoutMs = 50
+
 func init() {
 	wlrootsKeyboardCh = make(chan string, keyboardChanBuffer)
 }
@@ -65,10 +83,19 @@ func newWlrootsOverlay(logger *zap.Logger) *wlrootsOverlay {
 		return nil
 	}
 
+	// The connection is shared with the input backend; whichever came up
+	// first paid for it.
+	var connStats C.NeruWaylandConnStats
+	C.neru_wayland_overlay_conn_stats(raw, &connStats)
+	logger.Debug("Wayland connection startup",
+		zap.Duration("duration", time.Duration(connStats.connect_ns)),
+		zap.Int("roundtrips", int(connStats.roundtrips)))
+
 	C.neru_wayland_overlay_setup_buffers(raw)
 	overlay := &wlrootsOverlay{
 		raw:    raw,
 		logger: logger,
+		draw:   newDrawList(),
 		stopCh: make(chan struct{}),
 		doneCh: make(chan struct{}),
 	}
@@ -90,15 +117,20 @@ func (o *wlrootsOverlay) WindowPtr() unsafe.Pointer {
 
 func (o *wlrootsOverlay) Show() {
 	if o != nil && o.raw != nil {
-		C.neru_wayland_overlay_setup_buffers(o.raw)
+		o.ensureBuffers()
+		o.submitDrawList()
 		C.neru_wayland_overlay_show(o.raw)
+		o.logFirstFrame()
 	}
 }
 
 func (o *wlrootsOverlay) Hide() {
 	if o != nil && o.raw != nil {
 		o.cancelAnimation()
+		o.draw.reset()
 		C.neru_wayland_overlay_hide(o.raw)
+		o.activationStart = time.Time{}
+		o.scheduleStandbyRelease()
 	}
 }
 
@@ -106,19 +138,13 @@ func (o *wlrootsOverlay) Clear() {
 	if o != nil && o.raw != nil {
 		o.cancelAnimation()
 		o.hasLast = false
-		C.neru_wayland_overlay_clear(o.raw)
+		o.draw.clear()
 	}
 }
 
 func (o *wlrootsOverlay) ClearRect(rect image.Rectangle) {
 	if o != nil && o.raw != nil && !rect.Empty() {
-		C.neru_wayland_overlay_clear_rect(
-			o.raw,
-			C.double(rect.Min.X),
-			C.double(rect.Min.Y),
-			C.double(rect.Dx()),
-			C.double(rect.Dy()),
-		)
+		o.draw.clearRect(rect)
 	}
 }
 
@@ -132,7 +158,23 @@ func (o *wlrootsOverlay) Destroy() {
 	}
 
 	o.cancelAnimation()
+
+	// Keep a standby release that is already waiting on displayMu from
+	// touching the overlay once it is freed.
+	if o.displayMu != nil {
+		o.displayMu.Lock()
+	}
+	o.destroyed = true
+	if o.standbyTimer != nil {
+		o.standbyTimer.Stop()
+		o.standbyTimer = nil
+	}
+	if o.displayMu != nil {
+		o.displayMu.Unlock()
+	}
+
 	close(o.stopCh)
+	C.neru_wayland_overlay_wake(o.raw)
 	<-o.doneCh
 
 	C.neru_wayland_overlay_destroy(o.raw)
@@ -150,13 +192,13 @@ func (o *wlrootsOverlay) ShowSubgrid(cell *domainGrid.Cell, _ gridcomponent.Styl
 	}
 
 	o.currentSubgrid = cell
-	C.neru_wayland_overlay_setup_buffers(o.raw)
+	o.ensureBuffers()
 	o.Clear()
 	if !o.selectAvailableBuffer() {
 		return
 	}
 	o.drawSubgrid(cell.Bounds(), o.cachedStyle)
-	C.neru_wayland_overlay_flush(o.raw)
+	o.flushFrame()
 }
 
 func (o *wlrootsOverlay) SetHideUnmatched(hide bool) {
@@ -215,7 +257,7 @@ func (o *wlrootsOverlay) DrawRecursiveGridWithSubKeyPreview(
 		return
 	}
 
-	C.neru_wayland_overlay_setup_buffers(o.raw)
+	o.ensureBuffers()
 	shouldAnimate := animEnabled && o.hasLast && depth != o.lastDepth &&
 		!o.lastBounds.Empty()
 	cellRects := recursivegrid.ComputeGridCells(bounds, gridCols, gridRows)
@@ -269,7 +311,7 @@ func (o *wlrootsOverlay) DrawBadge(
 		return
 	}
 
-	C.neru_wayland_overlay_setup_buffers(o.raw)
+	o.ensureBuffers()
 	fontSize := style.fontSize
 	if fontSize <= 0 {
 		fontSize = 14
@@ -280,11 +322,64 @@ func (o *wlrootsOverlay) DrawBadge(
 	o.drawTextCentered(text, rect, style.fontFamily, fontSize, colors.text)
 }
 
+// DrawBadgeSurface shows a badge on its own small subsurface so following the
+// cursor only moves it instead of redrawing the full-output buffer. It
+// returns false when the compositor lacks wl_subcompositor or no mapped
+// output lies under the badge; the caller then falls back to DrawBadge.
+func (o *wlrootsOverlay) DrawBadgeSurface(
+	slot badgeSlot,
+	posX, posY int,
+	text string,
+	colors overlayColors,
+	style overlayBadgeStyle,
+) bool {
+	if o == nil || o.raw == nil || text == "" {
+		return false
+	}
+
+	o.ensureBuffers()
+	fontSize := style.fontSize
+	if fontSize <= 0 {
+		fontSize = 14
+	}
+	rect := badgeBounds(posX, posY, text, style)
+
+	cText := C.CString(text)
+	defer C.free(unsafe.Pointer(cText))
+	cFont := C.CString(style.fontFamily)
+	defer C.free(unsafe.Pointer(cFont))
+
+	shown := C.neru_wayland_overlay_badge_draw(
+		o.raw, C.int(slot),
+		C.int(rect.Min.X), C.int(rect.Min.Y), C.int(rect.Dx()), C.int(rect.Dy()),
+		cText, cFont, C.double(fontSize),
+		C.uint(colors.background), C.uint(colors.border),
+		C.double(max(style.borderWidth, 1)), C.uint(colors.text),
+	)
+	if shown == 0 {
+		C.neru_wayland_overlay_badge_hide(o.raw, C.int(slot))
+
+		return false
+	}
+
+	return true
+}
+
+// HideBadgeSurface unmaps the badge subsurface of slot, keeping its buffer
+// for the next DrawBadgeSurface.
+func (o *wlrootsOverlay) HideBadgeSurface(slot badgeSlot) {
+	if o == nil || o.raw == nil {
+		return
+	}
+
+	C.neru_wayland_overlay_badge_hide(o.raw, C.int(slot))
+}
+
 func (o *wlrootsOverlay) Flush() {
 	if o == nil || o.raw == nil {
 		return
 	}
-	C.neru_wayland_overlay_flush(o.raw)
+	o.flushFrame()
 }
 
 func (o *wlrootsOverlay) DrawHints(
@@ -295,13 +390,13 @@ func (o *wlrootsOverlay) DrawHints(
 		return
 	}
 
-	C.neru_wayland_overlay_setup_buffers(o.raw)
+	o.ensureBuffers()
 	o.cancelAnimation()
 	o.hasLast = false
 	if !o.selectAvailableBuffer() {
 		return
 	}
-	C.neru_wayland_overlay_clear(o.raw)
+	o.draw.clear()
 	fontSize := float64(max(style.FontSize(), 1))
 	for _, hint := range hintsSlice {
 		if style.BoundaryHighlightEnabled() {
@@ -373,7 +468,7 @@ func (o *wlrootsOverlay) DrawHints(
 		)
 	}
 
-	C.neru_wayland_overlay_flush(o.raw)
+	o.flushFrame()
 }
 
 // selectAvailableBuffer picks a buffer that the compositor has released.
@@ -382,10 +477,15 @@ func (o *wlrootsOverlay) selectAvailableBuffer() bool {
 	if o == nil || o.raw == nil {
 		return false
 	}
+	// Pending primitives belong to the current buffer; replay them before
+	// switching away from it.
+	o.submitDrawList()
 	C.neru_wayland_overlay_dispatch_pending(o.raw)
 	bufIdx := C.neru_wayland_overlay_available_buffer(o.raw) //nolint:nlreturn
 	if bufIdx < 0 {
-		C.neru_wayland_overlay_sync(o.raw)
+		// Wait only until the compositor releases a buffer rather than a
+		// full roundtrip.
+		C.neru_wayland_overlay_wait_buffer(o.raw, frameCallbackTimeoutMs)
 		bufIdx = C.neru_wayland_overlay_available_buffer(o.raw) //nolint:nlreturn
 	}
 	if bufIdx < 0 {
@@ -396,6 +496,164 @@ func (o *wlrootsOverlay) selectAvailableBuffer() bool {
 	return true
 }
 
+// submitDrawList replays the pending frame primitives on the C side in a
+// single cgo call and resets the list.
+func (o *wlrootsOverlay) submitDrawList() {
+	if o.draw.empty() {
+		return
+	}
+
+	debugPerf := o.logger.Core().Enabled(zap.DebugLevel)
+
+	var start time.Time
+	if debugPerf {
+		start = time.Now()
+	}
+
+	cmds, count, strs, strsLen := o.draw.raw()
+	if C.neru_wayland_overlay_submit(o.raw, C.NERU_DRAW_CMD_VERSION, cmds, count, strs, strsLen) < 0 {
+		o.logger.Warn("Wayland overlay rejected draw command list")
+	}
+
+	if debugPerf {
+		o.logFrameStats(int(count), time.Since(start))
+	}
+
+	o.draw.reset()
+}
+
+// logFrameStats reports how many primitives each output rasterized after
+// culling, alongside the submit time.
+func (o *wlrootsOverlay) logFrameStats(commands int, elapsed time.Duration) {
+	var counts [C.NERU_MAX_OUTPUTS]C.int
+
+	outputs := int(C.neru_wayland_overlay_frame_stats(o.raw, &counts[0], C.NERU_MAX_OUTPUTS))
+	perOutput := make([]int, outputs)
+	for i := range outputs {
+		perOutput[i] = int(counts[i])
+	}
+
+	var labels C.NeruLabelCacheStats
+	C.neru_wayland_overlay_label_cache_stats(o.raw, &labels)
+
+	o.logger.Debug("Wayland overlay frame submitted",
+		zap.Int("commands", commands),
+		zap.Ints("primitives_per_output", perOutput),
+		zap.Uint64("label_cache_hits", uint64(labels.hits)),
+		zap.Uint64("label_cache_misses", uint64(labels.misses)),
+		zap.Uint64("label_cache_evictions", uint64(labels.evictions)),
+		zap.Duration("duration", elapsed))
+}
+
+// invalidateLabelCache drops every pre-rasterized label so the next frame
+// picks up changed fonts or theme colors.
+func (o *wlrootsOverlay) invalidateLabelCache() {
+	C.neru_wayland_overlay_invalidate_label_cache(o.raw)
+}
+
+// flushFrame submits the pending primitives and commits the current buffer.
+func (o *wlrootsOverlay) flushFrame() {
+	o.submitDrawList()
+	C.neru_wayland_overlay_flush(o.raw)
+	o.logFirstFrame()
+}
+
+// ensureBuffers creates (or reuses from warm standby) the layer surfaces and
+// SHM pools before drawing. The first call after a hide starts the
+// time-to-first-frame measurement.
+func (o *wlrootsOverlay) ensureBuffers() {
+	if o.standbyTimer != nil {
+		o.standbyTimer.Stop()
+		o.standbyTimer = nil
+	}
+
+	if o.activationStart.IsZero() && C.neru_wayland_overlay_is_visible(o.raw) == 0 {
+		o.activationStart = time.Now()
+		o.activationWarm = C.neru_wayland_overlay_is_warm(o.raw) != 0
+	}
+
+	C.neru_wayland_overlay_setup_buffers(o.raw)
+}
+
+// logFirstFrame reports the time from activation to the first committed
+// frame, split by whether the standby pool was reused.
+func (o *wlrootsOverlay) logFirstFrame() {
+	if o.activationStart.IsZero() {
+		return
+	}
+
+	elapsed := time.Since(o.activationStart)
+	o.activationStart = time.Time{}
+
+	o.logger.Debug("Wayland overlay time to first frame",
+		zap.Duration("duration", elapsed),
+		zap.Bool("warm", o.activationWarm))
+}
+
+// configureStandby applies the warm standby settings. Callers hold displayMu.
+func (o *wlrootsOverlay) configureStandby(enabled bool, idle time.Duration, maxBytes uint64) {
+	if o == nil || o.raw == nil {
+		return
+	}
+
+	o.standbyIdle = idle
+
+	var enabledInt C.int
+	if enabled {
+		enabledInt = 1
+	}
+
+	C.neru_wayland_overlay_set_standby(o.raw, enabledInt, C.size_t(maxBytes))
+
+	if !enabled {
+		if o.standbyTimer != nil {
+			o.standbyTimer.Stop()
+			o.standbyTimer = nil
+		}
+
+		C.neru_wayland_overlay_release_standby(o.raw)
+	}
+}
+
+// scheduleStandbyRelease arms the idle timer after a hide that kept the
+// surfaces warm. An idle timeout of zero keeps them until the next config
+// change or shutdown.
+func (o *wlrootsOverlay) scheduleStandbyRelease() {
+	if o.standbyTimer != nil {
+		o.standbyTimer.Stop()
+		o.standbyTimer = nil
+	}
+
+	if o.standbyIdle <= 0 || C.neru_wayland_overlay_is_warm(o.raw) == 0 {
+		return
+	}
+
+	o.standbyGen++
+	gen := o.standbyGen
+	o.standbyTimer = time.AfterFunc(o.standbyIdle, func() { o.releaseStandby(gen) })
+}
+
+// releaseStandby runs on the idle timer. gen identifies the hide that armed
+// it, so a timer that fired while a newer activation held displayMu is a no-op.
+func (o *wlrootsOverlay) releaseStandby(gen uint64) {
+	if o.displayMu != nil {
+		o.displayMu.Lock()
+		defer o.displayMu.Unlock()
+	}
+
+	if o.destroyed || o.raw == nil || gen != o.standbyGen || o.standbyTimer == nil {
+		return
+	}
+
+	o.standbyTimer = nil
+
+	released := uint64(C.neru_wayland_overlay_release_standby(o.raw))
+	if released > 0 {
+		o.logger.Debug("Released idle Wayland overlay standby buffers",
+			zap.Uint64("bytes", released))
+	}
+}
+
 // unexported helpers
 
 func (o *wlrootsOverlay) setDisplayMu(mu *sync.Mutex) {
@@ -438,10 +696,19 @@ func (o *wlrootsOverlay) cancelAnimation() {
 	}
 }
 
+// keyboardPoller blocks on the Wayland fd (plus the overlay's wakeup
+// eventfd) instead of polling on a timer, so key delivery latency is bounded
+// by the compositor. displayMu is held only to prepare the read and to
+// dispatch; the blocking wait runs without it so rendering is never stalled.
 func (o *wlrootsOverlay) keyboardPoller() {
 	defer close(o.doneCh)
 
-	const pollInterval = 5 * time.Millisecond
+	var (
+		events            [keyEventBatch]C.NeruKeyEvent
+		reportedOverflows uint64
+	)
+
+	names := newWaylandKeyNames()
 
 	for {
 		select {
@@ -450,42 +717,52 @@ func (o *wlrootsOverlay) keyboardPoller() {
 		default:
 		}
 
-		var keys []string
-
 		if o.displayMu != nil {
 			o.displayMu.Lock()
 		}
 
-		if C.neru_wayland_overlay_poll(o.raw) < 0 { //nolint:nlreturn
-			if o.displayMu != nil {
-				o.displayMu.Unlock()
-			}
+		ready := C.neru_wayland_overlay_prepare_wait(o.raw) //nolint:nlreturn
+
+		if o.displayMu != nil {
+			o.displayMu.Unlock()
+		}
 
+		if ready < 0 {
 			return
 		}
 
-		for {
-			key := C.neru_wayland_overlay_get_key(o.raw) //nolint:nlreturn
-			if key == nil {
-				break
-			}
+		if ready == 0 && C.neru_wayland_overlay_wait(o.raw, -1) < 0 {
+			return
+		}
 
-			keys = append(keys, C.GoString(key))
+		if o.displayMu != nil {
+			o.displayMu.Lock()
 		}
 
+		C.neru_wayland_overlay_dispatch_pending(o.raw)
+		count := int(C.neru_wayland_overlay_read_keys(o.raw, &events[0], C.int(len(events))))
+		overflows := uint64(C.neru_wayland_overlay_key_overflows(o.raw))
+
 		if o.displayMu != nil {
 			o.displayMu.Unlock()
 		}
 
-		if len(keys) > 0 {
-			for _, k := range keys {
-				select {
-				case wlrootsKeyboardCh <- k:
-				default:
-				}
+		if overflows != reportedOverflows {
+			o.logger.Warn("Wayland overlay key ring overflowed; keys were dropped",
+				zap.Uint64("dropped_total", overflows))
+			reportedOverflows = overflows
+		}
+
+		for i := range count {
+			key := names.name(&events[i])
+			if key == "" {
+				continue
+			}
+
+			select {
+			case wlrootsKeyboardCh <- key:
+			default:
 			}
-		} else {
-			time.Sleep(pollInterval)
 		}
 	}
 }
@@ -552,9 +829,11 @@ func (o *wlrootsOverlay) startGridAnimation(
 	stopCh chan struct{},
 	doneCh chan struct{},
 ) {
-	C.neru_wayland_overlay_sync(o.raw)
+	var stats C.NeruPresentationStats
+	C.neru_wayland_overlay_presentation_stats(o.raw, &stats, 1)
 
 	startTime := time.Now()
+	frames := 0
 
 	renderFrame := func(rawProgress float64) bool {
 		if rawProgress >= 1.0 {
@@ -574,20 +853,13 @@ func (o *wlrootsOverlay) startGridAnimation(
 			)
 		}
 
-		C.neru_wayland_overlay_dispatch_pending(o.raw)
-		bufIdx := C.neru_wayland_overlay_available_buffer(o.raw) //nolint:nlreturn
-		if bufIdx < 0 {
-			C.neru_wayland_overlay_sync(o.raw)
-			bufIdx = C.neru_wayland_overlay_available_buffer(o.raw) //nolint:nlreturn
-		}
-		if bufIdx < 0 {
+		if !o.selectAvailableBuffer() {
 			return false
 		}
-		C.neru_wayland_overlay_select_buffer(o.raw, bufIdx)
 
 		o.currentAnimRects = interpCells
 
-		C.neru_wayland_overlay_clear(o.raw)
+		o.draw.clear()
 		o.drawFrame(
 			interpCells, keyRunes, nextKeyRunes,
 			nextGridCols, nextGridRows, style, virtualPointer,
@@ -610,35 +882,26 @@ func (o *wlrootsOverlay) startGridAnimation(
 		}()
 
 		for {
-			select {
-			case <-stopCh:
+			// Pace on the compositor: render the next step only once the
+			// previous frame's callback fired, and sample progress at that
+			// moment. waitFrame returns with displayMu held.
+			if !o.waitFrame(stopCh) {
 				return
-			default:
 			}
 
-			elapsed := time.Since(startTime)
-			rawProgress := float64(elapsed) / float64(duration)
+			rawProgress := float64(time.Since(startTime)) / float64(duration)
 			if rawProgress >= 1.0 {
 				rawProgress = 1.0
 			}
 
-			renderStart := time.Now()
+			if renderFrame(rawProgress) {
+				frames++
+			}
 
-			if o.displayMu != nil {
-				o.displayMu.Lock()
-				// Parent may have closed stopCh while we were waiting
-				// for the lock. Check here to avoid deadlock:
-				//   parent holds displayMu, waits for animDone
-				//   we   hold displayMu, parent waits for displayMu
-				select {
-				case <-stopCh:
-					o.displayMu.Unlock()
-
-					return
-				default:
-				}
+			if rawProgress >= 1.0 {
+				o.logAnimationStats(frames, time.Since(startTime))
 			}
-			_ = renderFrame(rawProgress)
+
 			if o.displayMu != nil {
 				o.displayMu.Unlock()
 			}
@@ -646,18 +909,90 @@ func (o *wlrootsOverlay) startGridAnimation(
 			if rawProgress >= 1.0 {
 				return
 			}
+		}
+	}()
+}
 
-			renderDur := time.Since(renderStart)
-			sleepFor := animationFrameDur - renderDur
-			if sleepFor > 0 {
-				select {
-				case <-stopCh:
-					return
-				case <-time.After(sleepFor):
-				}
+// waitFrame blocks until every output's previous frame callback fired or
+// frameCallbackTimeoutMs passed, which keeps an animation moving if an output
+// stops repainting (e.g. DPMS off). The blocking wait runs without displayMu,
+// as in keyboardPoller, so key delivery is not held up for a frame. It
+// returns true with displayMu held, and false without it once stopCh closed
+// or the connection failed.
+func (o *wlrootsOverlay) waitFrame(stopCh <-chan struct{}) bool {
+	deadline := time.Now().Add(frameCallbackTimeoutMs * time.Millisecond)
+
+	for {
+		select {
+		case <-stopCh:
+			return false
+		default:
+		}
+
+		if o.displayMu != nil {
+			o.displayMu.Lock()
+			// Parent may have closed stopCh while we were waiting
+			// for the lock. Check here to avoid deadlock:
+			//   parent holds displayMu, waits for animDone
+			//   we   hold displayMu, parent waits for displayMu
+			select {
+			case <-stopCh:
+				o.displayMu.Unlock()
+
+				return false
+			default:
 			}
 		}
-	}()
+
+		remaining := time.Until(deadline)
+		if remaining <= 0 {
+			return true
+		}
+
+		ready := C.neru_wayland_overlay_prepare_frame_wait(o.raw) //nolint:nlreturn
+		if ready > 0 {
+			return true
+		}
+
+		if o.displayMu != nil {
+			o.displayMu.Unlock()
+		}
+
+		if ready < 0 {
+			return false
+		}
+
+		timeoutMs := C.int((remaining + time.Millisecond - 1) / time.Millisecond)
+		if C.neru_wayland_overlay_wait_display(o.raw, timeoutMs) < 0 {
+			return false
+		}
+	}
+}
+
+// logAnimationStats reports how many frames an animation rendered and the
+// commit-to-present latency the compositor measured for them. Callers hold
+// displayMu.
+func (o *wlrootsOverlay) logAnimationStats(frames int, elapsed time.Duration) {
+	if !o.logger.Core().Enabled(zap.DebugLevel) {
+		return
+	}
+
+	var stats C.NeruPresentationStats
+	C.neru_wayland_overlay_presentation_stats(o.raw, &stats, 1)
+
+	var meanLatency time.Duration
+	if stats.presented > 0 {
+		meanLatency = time.Duration(uint64(stats.total_latency_ns) / uint64(stats.presented))
+	}
+
+	o.logger.Debug("Wayland overlay animation finished",
+		zap.Int("frames", frames),
+		zap.Duration("duration", elapsed),
+		zap.Uint64("presented", uint64(stats.presented)),
+		zap.Uint64("discarded", uint64(stats.discarded)),
+		zap.Duration("mean_present_latency", meanLatency),
+		zap.Duration("max_present_latency", time.Duration(stats.max_latency_ns)),
+		zap.Duration("refresh", time.Duration(stats.refresh_ns)))
 }
 
 func (o *wlrootsOverlay) clearAndDraw(
@@ -679,7 +1014,7 @@ func (o *wlrootsOverlay) clearAndDraw(
 	if !o.selectAvailableBuffer() {
 		return
 	}
-	C.neru_wayland_overlay_clear(o.raw)
+	o.draw.clear()
 	o.drawFrame(cellRects, keyRunes, nextKeyRunes,
 		nextGridCols, nextGridRows, style, virtualPointer)
 }
@@ -734,7 +1069,7 @@ func (o *wlrootsOverlay) drawFrame(
 		o.drawVirtualPointer(virtualPointer)
 	}
 
-	C.neru_wayland_overlay_flush(o.raw)
+	o.flushFrame()
 }
 
 //nolint:mnd,varnamelen
@@ -762,11 +1097,11 @@ func (o *wlrootsOverlay) redrawGrid() {
 		return
 	}
 
-	C.neru_wayland_overlay_setup_buffers(o.raw)
+	o.ensureBuffers()
 	if !o.selectAvailableBuffer() {
 		return
 	}
-	C.neru_wayland_overlay_clear(o.raw)
+	o.draw.clear()
 	style := o.cachedStyle
 	prefix := o.currentPrefix
 
@@ -793,7 +1128,7 @@ func (o *wlrootsOverlay) redrawGrid() {
 	if o.currentSubgrid != nil {
 		o.drawSubgrid(o.currentSubgrid.Bounds(), style)
 	}
-	C.neru_wayland_overlay_flush(o.raw)
+	o.flushFrame()
 }
 
 func (o *wlrootsOverlay) drawSubgrid(bounds image.Rectangle, style gridcomponent.Style) {
@@ -850,12 +1185,7 @@ func (o *wlrootsOverlay) drawRect(
 	bounds image.Rectangle,
 	fill uint32, border uint32, lineWidth float64,
 ) {
-	C.neru_wayland_overlay_rect(
-		o.raw,
-		C.double(bounds.Min.X), C.double(bounds.Min.Y),
-		C.double(bounds.Dx()), C.double(bounds.Dy()),
-		C.uint(fill), C.uint(border), C.double(lineWidth),
-	)
+	o.draw.rect(bounds, fill, border, lineWidth)
 }
 
 func (o *wlrootsOverlay) drawRoundedRect(
@@ -863,31 +1193,14 @@ func (o *wlrootsOverlay) drawRoundedRect(
 	radius float64,
 	fill uint32, border uint32, lineWidth float64,
 ) {
-	C.neru_wayland_overlay_rounded_rect(
-		o.raw,
-		C.double(bounds.Min.X), C.double(bounds.Min.Y),
-		C.double(bounds.Dx()), C.double(bounds.Dy()),
-		C.double(radius),
-		C.uint(fill), C.uint(border), C.double(lineWidth),
-	)
+	o.draw.roundedRect(bounds, radius, fill, border, lineWidth)
 }
 
 func (o *wlrootsOverlay) drawTextCentered(
 	text string, bounds image.Rectangle,
 	fontFamily string, fontSize float64, color uint32,
 ) {
-	cText := C.CString(text)
-	cFontFamily := C.CString(fontFamily)
-
-	defer C.free(unsafe.Pointer(cText))       //nolint:nlreturn
-	defer C.free(unsafe.Pointer(cFontFamily)) //nolint:nlreturn
-
-	C.neru_wayland_overlay_text(
-		o.raw, cText, cFontFamily,
-		C.double(bounds.Min.X+bounds.Dx()/2),
-		C.double(bounds.Min.Y+bounds.Dy()/2),
-		C.double(fontSize), C.uint(color),
-	)
+	o.draw.textCentered(text, bounds, fontFamily, fontSize, color)
 }
 
 func (o *wlrootsOverlay) drawLabelBackground(
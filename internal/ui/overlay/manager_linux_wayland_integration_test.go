@@ -0,0 +1,68 @@
+//go:build integration && linux && cgo
+
+package overlay_test
+
+import (
+	"os"
+	"testing"
+	"time"
+
+	"go.uber.org/zap"
+
+	"github.com/y3owk1n/neru/internal/core/infra/platform/linux"
+	"github.com/y3owk1n/neru/internal/ui/overlay"
+)
+
+const keyDeliveryTimeout = 2 * time.Second
+
+// BenchmarkWaylandKeyToChannel measures the latency from injecting a key via
+// the virtual keyboard to it arriving on the overlay keyboard channel. It needs
+// a running wlroots compositor with the overlay holding keyboard focus.
+func BenchmarkWaylandKeyToChannel(b *testing.B) {
+	if testing.Short() {
+		b.Skip("skipping Wayland key latency benchmark in short mode")
+	}
+
+	if os.Getenv("WAYLAND_DISPLAY") == "" {
+		b.Skip("WAYLAND_DISPLAY not set")
+	}
+
+	manager := overlay.NewOverlayManager(zap.NewNop())
+	if manager == nil || manager.WaylandKeyboardChannel() == nil {
+		b.Skip("wlroots overlay backend not available")
+	}
+	defer manager.Destroy()
+
+	manager.Show()
+	defer manager.Hide()
+
+	keys := manager.WaylandKeyboardChannel()
+
+	var total, worst time.Duration
+
+	b.ResetTimer()
+
+	for range b.N {
+		start := time.Now()
+
+		feedErr := linux.FeedKey("a")
+		if feedErr != nil {
+			b.Fatalf("FeedKey failed: %v", feedErr)
+		}
+
+		select {
+		case <-keys:
+		case <-time.After(keyDeliveryTimeout):
+			b.Fatal("timed out waiting for key on overlay channel")
+		}
+
+		elapsed := time.Since(start)
+		total += elapsed
+		worst = max(worst, elapsed)
+	}
+
+	b.StopTimer()
+
+	b.ReportMetric(float64(total.Microseconds())/float64(b.N), "us/key")
+	b.ReportMetric(float64(worst.Microseconds()), "max-us/key")
+}
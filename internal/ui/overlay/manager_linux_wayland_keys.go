@@ -0,0 +1,148 @@
+//go:build linux && cgo
+
+package overlay
+
+/*
+#cgo linux pkg-config: xkbcommon
+#include <xkbcommon/xkbcommon.h>
+#include "../../core/infra/platform/linux/overlay_wayland.h"
+*/
+import "C"
+
+import (
+	"strings"
+	"unsafe"
+)
+
+const (
+	// keyEventBatch bounds how many key events one poller wakeup drains.
+	keyEventBatch = 64
+	// keysymNameBufSize fits every xkb keysym name.
+	keysymNameBufSize = 64
+
+	firstPrintableASCII = '!'
+	lastPrintableASCII  = '~'
+)
+
+// Modifier bits of NeruKeyEvent.mods.
+const (
+	waylandKeyModShift uint16 = C.NERU_KEY_MOD_SHIFT
+	waylandKeyModCtrl  uint16 = C.NERU_KEY_MOD_CTRL
+	waylandKeyModAlt   uint16 = C.NERU_KEY_MOD_ALT
+	waylandKeyModLogo  uint16 = C.NERU_KEY_MOD_LOGO
+)
+
+// waylandKeyID is the part of a key event that determines its name.
+type waylandKeyID struct {
+	keysym  uint32
+	mods    uint16
+	pressed bool
+}
+
+// waylandKeyNames turns the packed key events of the overlay ring into the
+// key strings the mode handlers expect ("a", "Ctrl+a", "__keyup_a",
+// "__modifier_shift_down"). Each distinct name is built once and then
+// reused, so typing and held-key repeats do not allocate. Only the keyboard
+// poller goroutine uses it.
+type waylandKeyNames struct {
+	names map[waylandKeyID]string
+}
+
+func newWaylandKeyNames() *waylandKeyNames {
+	return &waylandKeyNames{names: make(map[waylandKeyID]string)}
+}
+
+// name returns the key string for ev, or "" when the keysym has no name.
+func (n *waylandKeyNames) name(ev *C.NeruKeyEvent) string {
+	return n.lookup(uint32(ev.keysym), uint16(ev.mods), ev.pressed != 0)
+}
+
+func (n *waylandKeyNames) lookup(keysym uint32, mods uint16, pressed bool) string {
+	id := waylandKeyID{keysym: keysym, pressed: pressed}
+	modifier := waylandModifierName(id.keysym)
+
+	// Modifiers only prefix presses of ordinary keys.
+	if modifier == "" && id.pressed {
+		id.mods = mods
+	}
+
+	if name, ok := n.names[id]; ok {
+		return name
+	}
+
+	name := buildWaylandKeyName(id, modifier)
+	n.names[id] = name
+
+	return name
+}
+
+func buildWaylandKeyName(id waylandKeyID, modifier string) string {
+	if modifier != "" {
+		if id.pressed {
+			return "__modifier_" + modifier + "_down"
+		}
+
+		return "__modifier_" + modifier + "_up"
+	}
+
+	base := waylandBaseKey(id.keysym)
+	if base == "" {
+		return ""
+	}
+
+	if !id.pressed {
+		return "__keyup_" + base
+	}
+
+	var prefix strings.Builder
+	if id.mods&waylandKeyModShift != 0 {
+		prefix.WriteString("Shift+")
+	}
+
+	if id.mods&waylandKeyModCtrl != 0 {
+		prefix.WriteString("Ctrl+")
+	}
+
+	if id.mods&waylandKeyModAlt != 0 {
+		prefix.WriteString("Alt+")
+	}
+
+	if id.mods&waylandKeyModLogo != 0 {
+		prefix.WriteString("Cmd+")
+	}
+
+	return prefix.String() + base
+}
+
+// waylandBaseKey normalizes a keysym to a lowercase key name: the character
+// itself for printable ASCII, the xkb keysym name otherwise ("return", "f1").
+func waylandBaseKey(keysym uint32) string {
+	r := rune(C.xkb_keysym_to_utf32(C.xkb_keysym_t(keysym)))
+	if r >= firstPrintableASCII && r <= lastPrintableASCII {
+		return strings.ToLower(string(r))
+	}
+
+	var buf [keysymNameBufSize]C.char
+
+	length := C.xkb_keysym_get_name(C.xkb_keysym_t(keysym), &buf[0], C.size_t(len(buf)))
+	if length <= 0 {
+		return ""
+	}
+
+	return strings.ToLower(C.GoString((*C.char)(unsafe.Pointer(&buf[0]))))
+}
+
+func waylandModifierName(keysym uint32) string {
+	switch keysym {
+	case C.XKB_KEY_Shift_L, C.XKB_KEY_Shift_R:
+		return "shift"
+	case C.XKB_KEY_Control_L, C.XKB_KEY_Control_R:
+		return "ctrl"
+	case C.XKB_KEY_Alt_L, C.XKB_KEY_Alt_R:
+		return "alt"
+	case C.XKB_KEY_Super_L, C.XKB_KEY_Super_R, C.XKB_KEY_Meta_L, C.XKB_KEY_Meta_R:
+		return "cmd"
+	default:
+		return ""
+	}
+}
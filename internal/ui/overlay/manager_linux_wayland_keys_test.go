@@ -0,0 +1,83 @@
+//go:build linux && cgo
+
+package overlay //nolint:testpackage // tests exercise the unexported Wayland key naming directly
+
+import "testing"
+
+// xkb keysyms used below; values from xkbcommon-keysyms.h.
+const (
+	testKeysymA        = 0x0061
+	testKeysymShiftA   = 0x0041
+	testKeysymSlash    = 0x002f
+	testKeysymSpace    = 0x0020
+	testKeysymReturn   = 0xff0d
+	testKeysymEscape   = 0xff1b
+	testKeysymF1       = 0xffbe
+	testKeysymKPEnter  = 0xff8d
+	testKeysymKP1      = 0xffb1
+	testKeysymKPAdd    = 0xffab
+	testKeysymShiftL   = 0xffe1
+	testKeysymControlR = 0xffe4
+	testKeysymAltL     = 0xffe9
+	testKeysymSuperL   = 0xffeb
+	testKeysymInvalid  = 0x20000000 // above XKB_KEYSYM_MAX, so it has no name
+)
+
+func TestWaylandKeyNames(t *testing.T) {
+	t.Parallel()
+
+	allMods := waylandKeyModShift | waylandKeyModCtrl | waylandKeyModAlt | waylandKeyModLogo
+
+	tests := []struct {
+		name    string
+		keysym  uint32
+		mods    uint16
+		pressed bool
+		want    string
+	}{
+		{"letter", testKeysymA, 0, true, "a"},
+		{"shifted letter is lowercased", testKeysymShiftA, waylandKeyModShift, true, "Shift+a"},
+		{"punctuation", testKeysymSlash, 0, true, "/"},
+		{"letter release", testKeysymA, 0, false, "__keyup_a"},
+		{"release ignores modifiers", testKeysymA, allMods, false, "__keyup_a"},
+		{"ctrl", testKeysymA, waylandKeyModCtrl, true, "Ctrl+a"},
+		{"all modifiers in order", testKeysymA, allMods, true, "Shift+Ctrl+Alt+Cmd+a"},
+		{"space uses its name", testKeysymSpace, 0, true, "space"},
+		{"return", testKeysymReturn, 0, true, "return"},
+		{"escape release", testKeysymEscape, 0, false, "__keyup_escape"},
+		{"function key", testKeysymF1, waylandKeyModAlt, true, "Alt+f1"},
+		{"keypad enter", testKeysymKPEnter, 0, true, "kp_enter"},
+		{"keypad digit", testKeysymKP1, 0, true, "1"},
+		{"keypad operator", testKeysymKPAdd, waylandKeyModShift, true, "Shift++"},
+		{"shift down", testKeysymShiftL, 0, true, "__modifier_shift_down"},
+		{"modifier ignores mods", testKeysymControlR, waylandKeyModCtrl, true, "__modifier_ctrl_down"},
+		{"alt up", testKeysymAltL, waylandKeyModAlt, false, "__modifier_alt_up"},
+		{"super is cmd", testKeysymSuperL, 0, true, "__modifier_cmd_down"},
+		{"no name", testKeysymInvalid, 0, true, ""},
+		{"no name release", testKeysymInvalid, 0, false, ""},
+	}
+
+	names := newWaylandKeyNames()
+
+	for _, tt := range tests {
+		// Twice: the second lookup comes from the cache.
+		for range 2 {
+			if got := names.lookup(tt.keysym, tt.mods, tt.pressed); got != tt.want {
+				t.Errorf("%s: lookup(%#x, %#x, %v) = %q, want %q",
+					tt.name, tt.keysym, tt.mods, tt.pressed, got, tt.want)
+			}
+		}
+	}
+}
+
+func TestWaylandKeyNamesCachedLookupDoesNotAllocate(t *testing.T) {
+	names := newWaylandKeyNames()
+	names.lookup(testKeysymA, waylandKeyModCtrl, true)
+
+	allocs := testing.AllocsPerRun(1000, func() {
+		names.lookup(testKeysymA, waylandKeyModCtrl, true)
+	})
+	if allocs != 0 {
+		t.Fatalf("cached lookup allocated %.1f times per call, want 0", allocs)
+	}
+}
@@ -39,6 +39,14 @@ type x11Overlay struct {
 
 	renderMu *sync.Mutex
 
+	// draw holds the primitives of the frame being built; it is replayed in
+	// one neru_x11_overlay_submit call before each flush.
+	draw *drawList
+
+	// frameTimes accumulates submit-to-present times while debug logging is
+	// enabled.
+	frameTimes *frameTimeHistogram
+
 	cancelMu         sync.Mutex
 	animStop         chan struct{}
 	animDone         chan struct{}
@@ -57,7 +65,12 @@ func newX11Overlay(logger *zap.Logger) *x11Overlay {
 		return nil
 	}
 
-	return &x11Overlay{raw: raw, logger: logger}
+	return &x11Overlay{
+		raw:        raw,
+		logger:     logger,
+		draw:       newDrawList(),
+		frameTimes: newFrameTimeHistogram(),
+	}
 }
 
 func (o *x11Overlay) Healthy() bool {
@@ -74,6 +87,7 @@ func (o *x11Overlay) WindowPtr() unsafe.Pointer {
 
 func (o *x11Overlay) Show() {
 	if o != nil && o.raw != nil {
+		o.submitDrawList()
 		C.neru_x11_overlay_show(o.raw)
 	}
 }
@@ -81,6 +95,7 @@ func (o *x11Overlay) Show() {
 func (o *x11Overlay) Hide() {
 	if o != nil && o.raw != nil {
 		o.cancelAnimation()
+		o.draw.reset()
 		C.neru_x11_overlay_hide(o.raw)
 	}
 }
@@ -89,19 +104,14 @@ func (o *x11Overlay) Clear() {
 	if o != nil && o.raw != nil {
 		o.cancelAnimation()
 		o.hasLast = false
+		o.draw.reset()
 		C.neru_x11_overlay_clear(o.raw)
 	}
 }
 
 func (o *x11Overlay) ClearRect(rect image.Rectangle) {
 	if o != nil && o.raw != nil && !rect.Empty() {
-		C.neru_x11_overlay_clear_rect(
-			o.raw,
-			C.int(rect.Min.X),
-			C.int(rect.Min.Y),
-			C.int(rect.Dx()),
-			C.int(rect.Dy()),
-		)
+		o.draw.clearRect(rect)
 	}
 }
 
@@ -132,7 +142,7 @@ func (o *x11Overlay) ShowSubgrid(cell *domainGrid.Cell, _ gridcomponent.Style) {
 	o.currentSubgrid = cell
 	o.Clear()
 	o.drawSubgrid(cell.Bounds(), o.cachedStyle)
-	C.neru_x11_overlay_flush(o.raw)
+	o.flushFrame()
 }
 
 func (o *x11Overlay) SetHideUnmatched(hide bool) {
@@ -259,7 +269,7 @@ func (o *x11Overlay) Flush() {
 	if o == nil || o.raw == nil {
 		return
 	}
-	C.neru_x11_overlay_flush(o.raw)
+	o.flushFrame()
 }
 
 func (o *x11Overlay) DrawHints(hintsSlice []*hintscomponent.Hint, style hintscomponent.StyleMode) {
@@ -269,7 +279,7 @@ func (o *x11Overlay) DrawHints(hintsSlice []*hintscomponent.Hint, style hintscom
 
 	o.cancelAnimation()
 	o.hasLast = false
-	C.neru_x11_overlay_clear(o.raw)
+	o.draw.clear()
 	fontSize := float64(max(style.FontSize(), 1))
 	for _, hint := range hintsSlice {
 		if style.BoundaryHighlightEnabled() {
@@ -341,7 +351,67 @@ func (o *x11Overlay) DrawHints(hintsSlice []*hintscomponent.Hint, style hintscom
 		)
 	}
 
+	o.flushFrame()
+}
+
+// submitDrawList replays the pending frame primitives on the C side in a
+// single cgo call and resets the list.
+func (o *x11Overlay) submitDrawList() {
+	if o.draw.empty() {
+		return
+	}
+
+	debugPerf := o.logger.Core().Enabled(zap.DebugLevel)
+
+	var start time.Time
+	if debugPerf {
+		start = time.Now()
+	}
+
+	cmds, count, strs, strsLen := o.draw.raw()
+	if C.neru_x11_overlay_submit(o.raw, C.NERU_DRAW_CMD_VERSION, cmds, count, strs, strsLen) < 0 {
+		o.logger.Warn("X11 overlay rejected draw command list")
+	}
+
+	if debugPerf {
+		var labels C.NeruLabelCacheStats
+		C.neru_x11_overlay_label_cache_stats(o.raw, &labels)
+
+		o.logger.Debug("X11 overlay frame submitted",
+			zap.Int("commands", int(count)),
+			zap.Uint64("label_cache_hits", uint64(labels.hits)),
+			zap.Uint64("label_cache_misses", uint64(labels.misses)),
+			zap.Uint64("label_cache_evictions", uint64(labels.evictions)),
+			zap.Duration("duration", time.Since(start)))
+	}
+
+	o.draw.reset()
+}
+
+// invalidateLabelCache drops every pre-rasterized label so the next frame
+// picks up changed fonts or theme colors.
+func (o *x11Overlay) invalidateLabelCache() {
+	C.neru_x11_overlay_invalidate_label_cache(o.raw)
+}
+
+// flushFrame submits the pending primitives and uploads the damaged parts of
+// each output's off-screen buffer to the server.
+func (o *x11Overlay) flushFrame() {
+	debugPerf := o.logger.Core().Enabled(zap.DebugLevel)
+
+	var start time.Time
+	if debugPerf {
+		start = time.Now()
+	}
+
+	o.submitDrawList()
 	C.neru_x11_overlay_flush(o.raw)
+
+	if debugPerf && o.frameTimes.observe(time.Since(start)) {
+		o.logger.Debug("X11 overlay frame times",
+			append(o.frameTimes.fields(),
+				zap.Int("mapped_outputs", int(C.neru_x11_overlay_mapped_outputs(o.raw))))...)
+	}
 }
 
 // unexported helpers
@@ -454,7 +524,7 @@ func (o *x11Overlay) startGridAnimation(
 
 		o.currentAnimRects = interpCells
 
-		C.neru_x11_overlay_clear_buffered(o.raw)
+		o.draw.clear()
 		o.drawFrame(
 			interpCells,
 			keyRunes,
@@ -543,7 +613,7 @@ func (o *x11Overlay) clearAndDraw(
 	keyRunes := []rune(strings.ToUpper(keys))
 	nextKeyRunes := []rune(strings.ToUpper(nextKeys))
 
-	C.neru_x11_overlay_clear(o.raw)
+	o.draw.clear()
 	o.drawFrame(
 		cellRects,
 		keyRunes,
@@ -605,7 +675,7 @@ func (o *x11Overlay) drawFrame(
 		o.drawVirtualPointer(virtualPointer)
 	}
 
-	C.neru_x11_overlay_flush(o.raw)
+	o.flushFrame()
 }
 
 //nolint:mnd,varnamelen
@@ -633,7 +703,7 @@ func (o *x11Overlay) redrawGrid() {
 		return
 	}
 
-	C.neru_x11_overlay_clear(o.raw)
+	o.draw.clear()
 	style := o.cachedStyle
 	prefix := o.currentPrefix
 
@@ -660,7 +730,7 @@ func (o *x11Overlay) redrawGrid() {
 	if o.currentSubgrid != nil {
 		o.drawSubgrid(o.currentSubgrid.Bounds(), style)
 	}
-	C.neru_x11_overlay_flush(o.raw)
+	o.flushFrame()
 }
 
 func (o *x11Overlay) drawSubgrid(bounds image.Rectangle, style gridcomponent.Style) {
@@ -717,12 +787,7 @@ func (o *x11Overlay) drawRect(
 	bounds image.Rectangle,
 	fill uint32, border uint32, lineWidth float64,
 ) {
-	C.neru_x11_overlay_rect(
-		o.raw,
-		C.double(bounds.Min.X), C.double(bounds.Min.Y),
-		C.double(bounds.Dx()), C.double(bounds.Dy()),
-		C.uint(fill), C.uint(border), C.double(lineWidth),
-	)
+	o.draw.rect(bounds, fill, border, lineWidth)
 }
 
 func (o *x11Overlay) drawRoundedRect(
@@ -730,31 +795,14 @@ func (o *x11Overlay) drawRoundedRect(
 	radius float64,
 	fill uint32, border uint32, lineWidth float64,
 ) {
-	C.neru_x11_overlay_rounded_rect(
-		o.raw,
-		C.double(bounds.Min.X), C.double(bounds.Min.Y),
-		C.double(bounds.Dx()), C.double(bounds.Dy()),
-		C.double(radius),
-		C.uint(fill), C.uint(border), C.double(lineWidth),
-	)
+	o.draw.roundedRect(bounds, radius, fill, border, lineWidth)
 }
 
 func (o *x11Overlay) drawTextCentered(
 	text string, bounds image.Rectangle,
 	fontFamily string, fontSize float64, color uint32,
 ) {
-	cText := C.CString(text)
-	cFontFamily := C.CString(fontFamily)
-
-	defer C.free(unsafe.Pointer(cText))       //nolint:nlreturn
-	defer C.free(unsafe.Pointer(cFontFamily)) //nolint:nlreturn
-
-	C.neru_x11_overlay_text(
-		o.raw, cText, cFontFamily,
-		C.double(bounds.Min.X+bounds.Dx()/2),
-		C.double(bounds.Min.Y+bounds.Dy()/2),
-		C.double(fontSize), C.uint(color),
-	)
+	o.draw.textCentered(text, bounds, fontFamily, fontSize, color)
 }
 
 func (o *x11Overlay) drawLabelBackground(
@@ -77,3 +77,4 @@ func (o *x11Overlay) DrawBadge(int, int, string, overlayColors, overlayBadgeStyl
 
 func (o *x11Overlay) cancelAnimation()          {}
 func (o *x11Overlay) setRenderMu(_ *sync.Mutex) {}
+func (o *x11Overlay) invalidateLabelCache()     {}